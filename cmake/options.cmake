@@ -9,6 +9,7 @@ option(BUILD_SCRIPTDEV                      "Build ScriptDev. (OFF Speedup build
 option(BUILD_AHBOT                          "Build Auction House Bot mod"               OFF)
 option(BUILD_METRICS                        "Build Metrics, generate data for Grafana"  OFF)
 option(BUILD_RECASTDEMOMOD                  "Build map/vmap/mmap viewer"                OFF)
+option(BUILD_TERRAIN_BENCH                  "Build terrain query benchmarks"            OFF)
 option(BUILD_GIT_ID                         "Build git_id"                              OFF)
 option(BUILD_DOCS                           "Build documentation with doxygen"          OFF)
 option(CMAKE_INTERPROCEDURAL_OPTIMIZATION   "Enable link-time optimizations"            OFF)
@@ -36,6 +37,7 @@ message(STATUS
     BUILD_AHBOT             Build Auction House Bot mod
     BUILD_METRICS           Build Metrics, generate data for Grafana
     BUILD_RECASTDEMOMOD     Build map/vmap/mmap viewer
+    BUILD_TERRAIN_BENCH     Build terrain query benchmarks (terrain_bench needs BUILD_GAME_SERVER)
     BUILD_GIT_ID            Build git_id
     BUILD_DOCS              Build documentation with doxygen
     CMAKE_INTERPROCEDURAL_OPTIMIZATION Enable link-time optimizations
@@ -79,6 +79,12 @@ else()
   message(STATUS "Build RecastDemoMod   : No  (default)")
 endif()
 
+if(BUILD_TERRAIN_BENCH)
+  message(STATUS "Build terrain bench   : Yes")
+else()
+  message(STATUS "Build terrain bench   : No  (default)")
+endif()
+
 if(BUILD_GIT_ID)
   message(STATUS "Build git_id          : Yes")
 else()
@@ -0,0 +1,308 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Runs the grid of BIHWrap cells the dynamic tree of a map uses (DynamicTree.cpp) over a synthetic,
+ * Wintergrasp sized set of gameobject models, once rebuilding cells on every change and once with
+ * incremental refit (vmap.dynamicTreeRefit). Both runs must answer every query the same, queries that stay
+ * within one cell are also checked against a brute force test of all models.
+ */
+
+#include "Common.h"
+#include "Vmap/BIHWrap.h"
+#include "Vmap/RegularGrid.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <random>
+
+// a gameobject model reduced to its bounds, a ray hits it where it enters the box
+struct BenchModel
+{
+    G3D::AABox bounds;
+
+    bool intersectRay(G3D::Ray const& ray, float& maxDist) const
+    {
+        float tMin = 0.f, tMax = maxDist;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float invDir = ray.invDirection()[axis];
+            float t1 = (bounds.low()[axis] - ray.origin()[axis]) * invDir;
+            float t2 = (bounds.high()[axis] - ray.origin()[axis]) * invDir;
+            if (t1 > t2)
+                std::swap(t1, t2);
+            tMin = std::max(tMin, t1);
+            tMax = std::min(tMax, t2);
+            if (tMin > tMax)
+                return false;
+        }
+
+        maxDist = tMin;
+        return true;
+    }
+};
+
+template<> struct BoundsTrait<BenchModel>
+{
+    static void getBounds(BenchModel const& m, G3D::AABox& out) { out = m.bounds; }
+    static void getBounds2(BenchModel const* m, G3D::AABox& out) { out = m->bounds; }
+};
+
+template<> struct PositionTrait<BenchModel>
+{
+    static void getPosition(BenchModel const& m, G3D::Vector3& p) { p = m.bounds.center(); }
+};
+
+static bool s_refit = false;
+
+typedef BIHWrap<BenchModel> BenchNode;
+
+struct BenchNodeCreator
+{
+    static BenchNode* makeNode(int /*x*/, int /*y*/) { return new BenchNode(s_refit); }
+};
+
+typedef RegularGrid2D<BenchModel, BenchNode, BenchNodeCreator> BenchTree;
+
+struct RayCallback
+{
+    bool hit = false;
+    bool operator()(G3D::Ray const& ray, BenchModel const& model, float& maxDist, bool /*ignoreM2Model*/)
+    {
+        if (model.intersectRay(ray, maxDist))
+            hit = true;
+        return hit;
+    }
+};
+
+struct PointCallback
+{
+    G3D::Vector3 const& point;
+    uint32 count = 0;
+    explicit PointCallback(G3D::Vector3 const& p) : point(p) {}
+    void operator()(G3D::Vector3 const& /*p*/, BenchModel const& model)
+    {
+        if (model.bounds.contains(point))
+            ++count;
+    }
+};
+
+struct BenchConfig
+{
+    uint32 models = 700;                    // static models: walls, towers, workshops, keep
+    uint32 movers = 40;                     // models moved every tick: siege engines, transports, doors
+    uint32 swaps = 2;                       // destructible models replaced by their damaged/destroyed model per tick
+    uint32 ticks = 3000;                    // dynamic tree rebalance periods (200 ms in DynamicTree.cpp)
+    uint32 queries = 200;                   // line of sight and point queries per tick
+    uint32 seed = 1;
+};
+
+struct BenchResult
+{
+    uint64 rebuilds = 0;
+    uint64 refits = 0;
+    uint64 balanceTime = 0;                 // nanoseconds
+    uint64 queryTime = 0;                   // nanoseconds
+    uint32 rayHits = 0;
+    uint32 mismatches = 0;                  // against brute force, queries within one cell
+    std::vector<uint32> answers;            // per query: ray hit | models containing the origin << 1
+};
+
+// Wintergrasp: roughly 1600 x 1600 yards around the fortress
+static float const AREA_X = 5100.f, AREA_Y = 2800.f, AREA_SIZE = 1600.f, GROUND_Z = 400.f;
+
+static G3D::AABox RandomBox(std::mt19937& rng, G3D::Vector3 const& center)
+{
+    std::uniform_real_distribution<float> size(4.f, 60.f), height(5.f, 40.f);
+    G3D::Vector3 half(size(rng) / 2, size(rng) / 2, height(rng) / 2);
+    G3D::Vector3 c(center.x, center.y, GROUND_Z + half.z - 2.f);
+    return G3D::AABox(c - half, c + half);
+}
+
+static G3D::Vector3 RandomPoint(std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> coord(-AREA_SIZE / 2, AREA_SIZE / 2);
+    return G3D::Vector3(AREA_X + coord(rng), AREA_Y + coord(rng), GROUND_Z);
+}
+
+static BenchResult Run(BenchConfig const& config, bool refit)
+{
+    s_refit = refit;
+    std::mt19937 rng(config.seed);
+    BenchResult result;
+
+    std::vector<std::unique_ptr<BenchModel>> models;
+    BenchTree tree;
+    for (uint32 i = 0; i < config.models + config.movers; ++i)
+    {
+        models.emplace_back(new BenchModel());
+        models.back()->bounds = RandomBox(rng, RandomPoint(rng));
+        tree.insert(*models.back());
+    }
+    tree.balance();
+
+    BIHWrapStats& stats = GetBIHWrapStats();
+    uint64 rebuilds = stats.rebuilds, refits = stats.refits;
+
+    std::uniform_real_distribution<float> step(-5.f, 5.f), unit(-1.f, 1.f), rayLength(5.f, 100.f), eyeHeight(0.f, 30.f);
+    std::uniform_int_distribution<uint32> staticModel(0, config.models - 1);
+    result.answers.reserve(config.ticks * config.queries);
+    for (uint32 tick = 0; tick < config.ticks; ++tick)
+    {
+        // GameObject::UpdateModelPosition: the same model goes out and back in at its new place
+        for (uint32 i = config.models; i < config.models + config.movers; ++i)
+        {
+            BenchModel& model = *models[i];
+            tree.remove(model);
+            G3D::Vector3 delta(step(rng), step(rng), 0.f);
+            model.bounds = G3D::AABox(model.bounds.low() + delta, model.bounds.high() + delta);
+            tree.insert(model);
+        }
+
+        // GameObject::UpdateModel on damage or destruction creates a new model
+        for (uint32 i = 0; i < config.swaps; ++i)
+        {
+            std::unique_ptr<BenchModel>& slot = models[staticModel(rng)];
+            tree.remove(*slot);
+            std::unique_ptr<BenchModel> replacement(new BenchModel());
+            replacement->bounds = RandomBox(rng, slot->bounds.center());
+            slot.swap(replacement);
+            tree.insert(*slot);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        tree.balance();
+        result.balanceTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        for (uint32 q = 0; q < config.queries; ++q)
+        {
+            G3D::Vector3 origin = RandomPoint(rng);
+            origin.z += eyeHeight(rng);
+            G3D::Vector3 dir(unit(rng), unit(rng), unit(rng) * 0.2f);
+            if (dir.squaredLength() < 0.01f)
+                dir = G3D::Vector3(1.f, 0.f, 0.f);
+            dir = dir.direction();
+            float length = rayLength(rng);
+            G3D::Ray ray = G3D::Ray::fromOriginAndDirection(origin, dir);
+
+            RayCallback rayCallback;
+            float maxDist = length;
+            PointCallback pointCallback(origin);
+
+            start = std::chrono::steady_clock::now();
+            tree.intersectRay(ray, rayCallback, maxDist, origin + dir * length, false);
+            tree.intersectPoint(origin, pointCallback);
+            result.queryTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+            if (rayCallback.hit)
+                ++result.rayHits;
+            result.answers.push_back(uint32(rayCallback.hit) | (pointCallback.count << 1));
+
+            // RegularGrid2D steps rays from cell to cell with borders that do not line up with its cells,
+            // rays crossing cells can miss models a brute force test finds, in both modes alike
+            G3D::Vector3 end = origin + dir * length;
+            if (!(BenchTree::Cell::ComputeCell(origin.x, origin.y) == BenchTree::Cell::ComputeCell(end.x, end.y)))
+                continue;
+
+            bool bruteHit = false;
+            uint32 bruteCount = 0;
+            for (auto const& model : models)
+            {
+                float dist = length;
+                if (model->intersectRay(ray, dist))
+                    bruteHit = true;
+                if (model->bounds.contains(origin))
+                    ++bruteCount;
+            }
+
+            if (rayCallback.hit != bruteHit || pointCallback.count != bruteCount)
+                ++result.mismatches;
+        }
+    }
+
+    result.rebuilds = stats.rebuilds - rebuilds;
+    result.refits = stats.refits - refits;
+
+    for (auto const& model : models)
+        tree.remove(*model);
+    return result;
+}
+
+static void PrintUsage(char const* name)
+{
+    printf("usage: %s [-n <models>] [-m <movers>] [-s <swaps>] [-t <ticks>] [-q <queries>] [-r <seed>]\n", name);
+    printf("  -n  static models (default 700)\n");
+    printf("  -m  models moved every tick (default 40)\n");
+    printf("  -s  models replaced by a new model every tick (default 2)\n");
+    printf("  -t  ticks, one tree balance each (default 3000)\n");
+    printf("  -q  line of sight and point queries per tick (default 200)\n");
+    printf("  -r  random seed (default 1)\n");
+}
+
+static void PrintResult(char const* mode, BenchConfig const& config, BenchResult const& result)
+{
+    uint64 queries = uint64(config.ticks) * config.queries;
+    printf("%-8s %10llu %10llu %16.2f %10.3f %10u %12u\n", mode, (unsigned long long)result.rebuilds, (unsigned long long)result.refits,
+           double(result.balanceTime) / config.ticks / 1000.0, double(result.queryTime) / queries / 1000.0, result.rayHits, result.mismatches);
+}
+
+int main(int argc, char* argv[])
+{
+    BenchConfig config;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg.size() != 2 || arg[0] != '-' || i + 1 >= argc)
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+
+        uint32 value = uint32(std::max(0, atoi(argv[++i])));
+        switch (arg[1])
+        {
+            case 'n': config.models = std::max(1u, value); break;
+            case 'm': config.movers = value; break;
+            case 's': config.swaps = value; break;
+            case 't': config.ticks = value; break;
+            case 'q': config.queries = value; break;
+            case 'r': config.seed = value; break;
+            default:
+                PrintUsage(argv[0]);
+                return 1;
+        }
+    }
+
+    printf("%u static models, %u moved and %u replaced per tick, %u ticks, %u queries per tick, seed %u\n\n",
+           config.models, config.movers, config.swaps, config.ticks, config.queries, config.seed);
+    printf("%-8s %10s %10s %16s %10s %10s %12s\n", "mode", "rebuilds", "refits", "balance us/tick", "query us", "ray hits", "brute diffs");
+
+    BenchResult rebuild = Run(config, false);
+    PrintResult("rebuild", config, rebuild);
+    BenchResult refit = Run(config, true);
+    PrintResult("refit", config, refit);
+
+    uint32 differences = 0;
+    for (size_t i = 0; i < rebuild.answers.size(); ++i)
+        if (rebuild.answers[i] != refit.answers[i])
+            ++differences;
+    printf("\n%u of %u queries answered differently with refit\n", differences, uint32(rebuild.answers.size()));
+
+    return differences || rebuild.mismatches || refit.mismatches ? 2 : 0;
+}
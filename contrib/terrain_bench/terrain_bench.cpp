@@ -0,0 +1,291 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Replays terrain query traces recorded by mangosd (TerrainQueryTrace.File) against extracted
+ * maps, vmaps and mmaps and reports throughput and latency percentiles per query type.
+ * Needs no database, only the data directory.
+ */
+
+#include "Common.h"
+#include "Config/Config.h"
+#include "Log/Log.h"
+#include "Database/DatabaseEnv.h"
+#include "World/World.h"
+#include "Maps/GridDefines.h"
+#include "Maps/GridMap.h"
+#include "Maps/TerrainQueryTrace.h"
+#include "MotionGenerators/MoveMap.h"
+#include "MotionGenerators/MoveMapSharedDefines.h"
+#include "MotionGenerators/PathFinder.h"
+#include "Vmap/VMapFactory.h"
+
+#include <Detour/Include/DetourNavMeshQuery.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <set>
+
+// the game library expects these from the executable
+DatabaseType WorldDatabase;
+DatabaseType CharacterDatabase;
+DatabaseType LoginDatabase;
+DatabaseType LogsDatabase;
+uint32 realmID = 0;
+
+struct QueryTypeStats
+{
+    std::vector<uint32> latencies;          // nanoseconds
+    uint64 totalTime = 0;                   // nanoseconds
+    uint32 positive = 0;                    // height found, los clear, area found, in liquid, path found
+};
+
+static void PrintUsage(char const* name)
+{
+    printf("usage: %s [-c <mangosd.conf>] [-d <data dir>] [-r <repeat>] <trace file>\n", name);
+    printf("  -c  read vmap/mmap settings from a config file (default: built-in defaults)\n");
+    printf("  -d  directory containing maps, vmaps and mmaps (overrides DataDir)\n");
+    printf("  -r  number of timed passes over the trace after the warm-up pass (default: 1)\n");
+}
+
+// config values can be overridden by environment variables, see Config::SetSource
+static void SetConfigOverride(char const* name, char const* value)
+{
+#if PLATFORM == PLATFORM_WINDOWS
+    _putenv_s(name, value);
+#else
+    setenv(name, value, 1);
+#endif
+}
+
+static bool ComputeGrid(float x, float y, uint32& gx, uint32& gy)
+{
+    // same as TerrainInfo::GetGrid
+    int x_val = int(32 - x / SIZE_OF_GRIDS);
+    int y_val = int(32 - y / SIZE_OF_GRIDS);
+    if (x_val < 0 || y_val < 0 || x_val >= MAX_NUMBER_OF_GRIDS || y_val >= MAX_NUMBER_OF_GRIDS)
+        return false;
+
+    gx = x_val;
+    gy = y_val;
+    return true;
+}
+
+// navmesh part of PathFinder::calculate - the path finder itself needs a unit on a live map
+static bool ReplayPath(TerrainQuery const& query, MMAP::MMapManager* mmap, dtQueryFilter const& filter)
+{
+    dtNavMeshQuery const* navQuery = mmap->GetNavMeshQuery(query.mapId, 0);
+    if (!navQuery)
+        return false;
+
+    float startPos[VERTEX_SIZE] = { query.y, query.z, query.x };
+    float endPos[VERTEX_SIZE] = { query.destY, query.destZ, query.destX };
+    float startPoint[VERTEX_SIZE], endPoint[VERTEX_SIZE];
+    dtPolyRef startRef = INVALID_POLYREF, endRef = INVALID_POLYREF;
+
+    if (dtStatusFailed(navQuery->findNearestPoly(startPos, NearPolySearchBound, &filter, &startRef, startPoint)) || startRef == INVALID_POLYREF)
+        return false;
+    if (dtStatusFailed(navQuery->findNearestPoly(endPos, NearPolySearchBound, &filter, &endRef, endPoint)) || endRef == INVALID_POLYREF)
+        return false;
+
+    dtPolyRef polys[MAX_PATH_LENGTH];
+    int polyCount = 0;
+
+    if (query.flags)
+    {
+        float hitDist, hitNormal[VERTEX_SIZE];
+        return dtStatusSucceed(navQuery->raycast(startRef, startPoint, endPoint, &filter, &hitDist, hitNormal, polys, &polyCount, MAX_PATH_LENGTH));
+    }
+
+    if (dtStatusFailed(navQuery->findPath(startRef, endRef, startPoint, endPoint, &filter, polys, &polyCount, MAX_PATH_LENGTH)) || !polyCount)
+        return false;
+
+    float points[MAX_POINT_PATH_LENGTH * VERTEX_SIZE];
+    int pointCount = 0;
+    return dtStatusSucceed(navQuery->findStraightPath(startPoint, endPoint, polys, polyCount, points, nullptr, nullptr, &pointCount, MAX_POINT_PATH_LENGTH));
+}
+
+static bool Replay(TerrainQuery const& query, TerrainInfo const* terrain, VMAP::IVMapManager* vmgr, MMAP::MMapManager* mmap, dtQueryFilter const& filter)
+{
+    switch (query.type)
+    {
+        case TERRAIN_QUERY_HEIGHT:
+            return terrain->GetHeightStatic(query.x, query.y, query.z, query.flags != 0, query.param) > INVALID_HEIGHT;
+        case TERRAIN_QUERY_LOS:
+            // static geometry only, gameobjects of the dynamic tree are not spawned offline
+            return vmgr->isInLineOfSight(query.mapId, query.x, query.y, query.z, query.destX, query.destY, query.destZ, query.flags != 0);
+        case TERRAIN_QUERY_AREA:
+            return terrain->GetAreaFlag(query.x, query.y, query.z) != 0;
+        case TERRAIN_QUERY_LIQUID:
+            return terrain->getLiquidStatus(query.x, query.y, query.z, uint8(query.flags), nullptr, query.param) != LIQUID_MAP_NO_WATER;
+        case TERRAIN_QUERY_PATH:
+            return ReplayPath(query, mmap, filter);
+        default:
+            return false;
+    }
+}
+
+static uint32 Percentile(std::vector<uint32> const& sorted, double percentile)
+{
+    if (sorted.empty())
+        return 0;
+    size_t index = std::min(sorted.size() - 1, size_t(percentile / 100.0 * sorted.size()));
+    return sorted[index];
+}
+
+int main(int argc, char* argv[])
+{
+    std::string configFile;
+    std::string dataDir;
+    std::string traceFile;
+    uint32 repeat = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "-c" && i + 1 < argc)
+            configFile = argv[++i];
+        else if (arg == "-d" && i + 1 < argc)
+            dataDir = argv[++i];
+        else if (arg == "-r" && i + 1 < argc)
+            repeat = std::max(1, atoi(argv[++i]));
+        else if (arg[0] != '-' && traceFile.empty())
+            traceFile = arg;
+        else
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (traceFile.empty())
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    // DataDir is only read through the config, environment overrides file values
+    if (!dataDir.empty())
+        SetConfigOverride("Mangosd_DataDir", dataDir.c_str());
+    // a server config may record traces - never start that here, it could truncate the trace we replay
+    SetConfigOverride("Mangosd_TerrainQueryTrace_File", "");
+
+    if (!sConfig.SetSource(configFile, "Mangosd_") && !configFile.empty())
+    {
+        sLog.outError("Could not find configuration file %s.", configFile.c_str());
+        return 1;
+    }
+
+    sWorld.LoadConfigSettings();
+
+    // the benchmark is about these, whatever the config says
+    VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+    vmgr->setEnableLineOfSightCalc(true);
+    vmgr->setEnableHeightCalc(true);
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+
+    std::vector<TerrainQuery> queries;
+    if (!TerrainQueryTrace::Read(traceFile, queries))
+    {
+        sLog.outError("Could not read trace file %s.", traceFile.c_str());
+        return 1;
+    }
+
+    printf("Replaying %u queries from %s, data from %s\n", uint32(queries.size()), traceFile.c_str(), sWorld.GetDataPath().c_str());
+
+    // load map, vmap and navmesh tiles of the start and end grids of all queries up front, grid loading is not what we measure
+    std::map<uint32, TerrainInfo*> terrains;
+    std::set<std::pair<uint32, uint32>> grids;
+    std::set<std::pair<uint32, uint32>> navTiles;
+    for (TerrainQuery const& query : queries)
+    {
+        TerrainInfo*& terrain = terrains[query.mapId];
+        if (!terrain)
+            terrain = sTerrainMgr.LoadTerrain(query.mapId);
+
+        bool hasDest = query.type == TERRAIN_QUERY_LOS || query.type == TERRAIN_QUERY_PATH;
+        for (int i = 0; i < (hasDest ? 2 : 1); ++i)
+        {
+            float x = i ? query.destX : query.x;
+            float y = i ? query.destY : query.y;
+            uint32 gx, gy;
+            if (!ComputeGrid(x, y, gx, gy))
+                continue;
+
+            // any terrain query loads the map file and vmap tile of its grid, line of sight goes to the
+            // vmap manager directly and without the tile would see through everything
+            if (grids.insert(std::make_pair(query.mapId, (gx << 8) | gy)).second)
+                terrain->GetTerrainType(x, y);
+
+            if (query.type == TERRAIN_QUERY_PATH && navTiles.insert(std::make_pair(query.mapId, (gx << 8) | gy)).second)
+                mmap->loadMap(query.mapId, 0, gx, gy, 0);
+        }
+    }
+
+    dtQueryFilter filter;
+    filter.setIncludeFlags(NAV_GROUND | NAV_WATER);
+    filter.setExcludeFlags(0);
+
+    // warm-up pass, the first queries of a grid also fill its caches
+    for (TerrainQuery const& query : queries)
+        Replay(query, terrains[query.mapId], vmgr, mmap, filter);
+
+    QueryTypeStats stats[MAX_TERRAIN_QUERY_TYPE];
+    for (QueryTypeStats& typeStats : stats)
+        typeStats.latencies.reserve(queries.size() * repeat);
+
+    for (uint32 pass = 0; pass < repeat; ++pass)
+    {
+        for (TerrainQuery const& query : queries)
+        {
+            TerrainInfo const* terrain = terrains[query.mapId];
+            auto start = std::chrono::steady_clock::now();
+            bool positive = Replay(query, terrain, vmgr, mmap, filter);
+            uint64 time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+            QueryTypeStats& typeStats = stats[query.type];
+            typeStats.latencies.push_back(uint32(std::min<uint64>(time, std::numeric_limits<uint32>::max())));
+            typeStats.totalTime += time;
+            if (positive)
+                ++typeStats.positive;
+        }
+    }
+
+    printf("\n%-8s %10s %10s %12s %9s %9s %9s %9s %9s\n", "type", "queries", "positive", "queries/s", "p50 us", "p90 us", "p99 us", "p99.9 us", "max us");
+    for (uint32 type = 0; type < MAX_TERRAIN_QUERY_TYPE; ++type)
+    {
+        QueryTypeStats& typeStats = stats[type];
+        if (typeStats.latencies.empty())
+            continue;
+
+        std::sort(typeStats.latencies.begin(), typeStats.latencies.end());
+        double throughput = typeStats.totalTime ? typeStats.latencies.size() * 1e9 / typeStats.totalTime : 0.0;
+        printf("%-8s %10u %10u %12.0f %9.2f %9.2f %9.2f %9.2f %9.2f\n", TerrainQueryTrace::GetTypeName(TerrainQueryType(type)),
+               uint32(typeStats.latencies.size()), typeStats.positive, throughput,
+               Percentile(typeStats.latencies, 50.0) / 1000.0, Percentile(typeStats.latencies, 90.0) / 1000.0,
+               Percentile(typeStats.latencies, 99.0) / 1000.0, Percentile(typeStats.latencies, 99.9) / 1000.0,
+               typeStats.latencies.back() / 1000.0);
+    }
+
+    for (auto& terrain : terrains)
+        sTerrainMgr.UnloadTerrain(terrain.first);
+
+    return 0;
+}
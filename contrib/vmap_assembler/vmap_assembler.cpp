@@ -18,24 +18,94 @@
 
 #include <string>
 #include <iostream>
+#include <chrono>
 
 #include "TileAssembler.h"
+#include "WorldModel.h"
+#include "Platform/Filesystem.h"
+
+static uint64 loadModel(VMAP::WorldModel& model, std::string const& filename, bool& ok)
+{
+    auto start = std::chrono::steady_clock::now();
+    ok = model.readFile(filename);
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// rewrites all models of an assembled vmaps dir in the blob format and compares load times
+static int convertToBlobs(std::string const& vmapDir)
+{
+    uint32 converted = 0, skipped = 0;
+    uint64 chunkedTime = 0, blobTime = 0;
+
+    for (MaNGOS::Filesystem::directory_iterator itr(vmapDir), end; itr != end; ++itr)
+    {
+        if (itr->path().extension() != ".vmo")
+            continue;
+
+        std::string filename = itr->path().string();
+        bool ok = false;
+        uint64 time;
+        {
+            VMAP::WorldModel model;
+            time = loadModel(model, filename, ok);
+            if (!ok)
+            {
+                std::cout << "error reading " << filename << std::endl;
+                return 1;
+            }
+
+            // already converted
+            if (model.isBlob())
+            {
+                ++skipped;
+                continue;
+            }
+
+            chunkedTime += time;
+            if (!model.writeBlobFile(filename))
+            {
+                std::cout << "error writing " << filename << std::endl;
+                return 1;
+            }
+        }
+
+        VMAP::WorldModel blobModel;
+        blobTime += loadModel(blobModel, filename, ok);
+        if (!ok)
+        {
+            std::cout << "error reading converted " << filename << std::endl;
+            return 1;
+        }
+        ++converted;
+    }
+
+    std::cout << "converted " << converted << " models (" << skipped << " already in blob format)" << std::endl;
+    if (converted)
+        std::cout << "load time: chunked " << chunkedTime / 1000 << " ms, blob " << blobTime / 1000 << " ms" << std::endl;
+    return 0;
+}
 
 //=======================================================
 int main(int argc, char* argv[])
 {
-    if (argc != 3)
+    if (argc == 3 && std::string(argv[1]) == "--convert")
+        return convertToBlobs(argv[2]);
+
+    bool blobModels = argc == 4 && std::string(argv[1]) == "--blob";
+    if (argc != 3 && !blobModels)
     {
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        std::cout << "usage: " << argv[0] << " [--blob] <raw data dir> <vmap dest dir>" << std::endl;
+        std::cout << "       " << argv[0] << " --convert <vmap dir>" << std::endl;
         return 1;
     }
 
-    std::string src = argv[1];
-    std::string dest = argv[2];
+    std::string src = argv[argc - 2];
+    std::string dest = argv[argc - 1];
 
     std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
 
     VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest);
+    ta->setBlobModels(blobModels);
 
     if (!ta->convertWorld2())
     {
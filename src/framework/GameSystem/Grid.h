@@ -36,18 +36,23 @@
 #include "TypeContainerVisitor.h"
 
 // forward declaration
-template<class A, class T, class O> class GridLoader;
+template<class A, class T, class O, class I> class GridLoader;
 
+/*
+  CELL_INDEX is a side index of the objects in the grid, it is notified
+  of every object added to or removed from the grid containers.
+*/
 template
 <
     class ACTIVE_OBJECT,
     class WORLD_OBJECT_TYPES,
-    class GRID_OBJECT_TYPES
+    class GRID_OBJECT_TYPES,
+    class CELL_INDEX
     >
 class Grid
 {
         // allows the GridLoader to access its internals
-        template<class A, class T, class O> friend class GridLoader;
+        template<class A, class T, class O, class I> friend class GridLoader;
 
     public:
 
@@ -61,7 +66,11 @@ class Grid
         template<class SPECIFIC_OBJECT>
         bool AddWorldObject(SPECIFIC_OBJECT* obj)
         {
-            return i_objects.template insert<SPECIFIC_OBJECT>(obj);
+            if (!i_objects.template insert<SPECIFIC_OBJECT>(obj))
+                return false;
+
+            i_index.InsertWorldObject(obj);
+            return true;
         }
 
         /** an object of interested exits the grid
@@ -69,6 +78,7 @@ class Grid
         template<class SPECIFIC_OBJECT>
         bool RemoveWorldObject(SPECIFIC_OBJECT* obj)
         {
+            i_index.Remove(obj);
             return i_objects.template remove<SPECIFIC_OBJECT>(obj);
         }
 
@@ -103,7 +113,11 @@ class Grid
             if (obj->isActiveObject())
                 m_activeGridObjects.insert(obj);
 
-            return i_container.template insert<SPECIFIC_OBJECT>(obj);
+            if (!i_container.template insert<SPECIFIC_OBJECT>(obj))
+                return false;
+
+            i_index.InsertGridObject(obj);
+            return true;
         }
 
         /** Removes a containter type object from the grid
@@ -114,15 +128,21 @@ class Grid
             if (obj->isActiveObject())
                 m_activeGridObjects.erase(obj);
 
+            i_index.Remove(obj);
             return i_container.template remove<SPECIFIC_OBJECT>(obj);
         }
 
+        /** Side index of the objects within the grid.
+         */
+        const CELL_INDEX& GetIndex() const { return i_index; }
+
     private:
 
         TypeMapContainer<GRID_OBJECT_TYPES> i_container;
         TypeMapContainer<WORLD_OBJECT_TYPES> i_objects;
         typedef std::set<void*> ActiveGridObjects;
         ActiveGridObjects m_activeGridObjects;
+        CELL_INDEX i_index;
 };
 
 #endif
@@ -38,7 +38,8 @@ template
 <
     class ACTIVE_OBJECT,
     class WORLD_OBJECT_TYPES,
-    class GRID_OBJECT_TYPES
+    class GRID_OBJECT_TYPES,
+    class CELL_INDEX
     >
 class GridLoader
 {
@@ -47,7 +48,7 @@ class GridLoader
         /** Loads the grid
          */
         template<class LOADER>
-        void Load(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES>& grid, LOADER& loader)
+        void Load(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES, CELL_INDEX>& grid, LOADER& loader)
         {
             loader.Load(grid);
         }
@@ -55,7 +56,7 @@ class GridLoader
         /** Stop the grid
          */
         template<class STOPER>
-        void Stop(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES>& grid, STOPER& stoper)
+        void Stop(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES, CELL_INDEX>& grid, STOPER& stoper)
         {
             stoper.Stop(grid);
         }
@@ -63,7 +64,7 @@ class GridLoader
         /** Unloads the grid
          */
         template<class UNLOADER>
-        void Unload(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES>& grid, UNLOADER& unloader)
+        void Unload(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES, CELL_INDEX>& grid, UNLOADER& unloader)
         {
             unloader.Unload(grid);
         }
@@ -18,10 +18,75 @@
 
 #include "EventProcessor.h"
 
+#include <algorithm>
+#include <new>
+
+// Freed event blocks per size class, owned by the thread that freed them.
+// Plain arrays so the cache stays usable during static destruction, blocks left at thread exit are not reclaimed.
+namespace
+{
+    const size_t EVENT_BLOCK_GRANULARITY = 16;
+    const size_t EVENT_BLOCK_MAX_SIZE = 256;                // larger events use the allocator directly
+    const size_t EVENT_BLOCK_CLASSES = EVENT_BLOCK_MAX_SIZE / EVENT_BLOCK_GRANULARITY;
+    const uint32 EVENT_BLOCK_MAX_FREE = 1024;               // per class and thread
+
+    struct EventBlockCache
+    {
+        void* freeBlocks[EVENT_BLOCK_CLASSES];              // next block is stored in the first bytes of a free one
+        uint32 freeCount[EVENT_BLOCK_CLASSES];
+    };
+
+    thread_local EventBlockCache eventBlockCache;
+
+    size_t GetEventBlockClass(size_t size) { return (size - 1) / EVENT_BLOCK_GRANULARITY; }
+}
+
+void* BasicEvent::operator new(size_t size)
+{
+    if (!size || size > EVENT_BLOCK_MAX_SIZE)
+        return ::operator new(size);
+
+    size_t blockClass = GetEventBlockClass(size);
+    EventBlockCache& cache = eventBlockCache;
+    if (void* block = cache.freeBlocks[blockClass])
+    {
+        cache.freeBlocks[blockClass] = *static_cast<void**>(block);
+        --cache.freeCount[blockClass];
+        return block;
+    }
+
+    return ::operator new((blockClass + 1) * EVENT_BLOCK_GRANULARITY);
+}
+
+void BasicEvent::operator delete(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    if (!size || size > EVENT_BLOCK_MAX_SIZE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    size_t blockClass = GetEventBlockClass(size);
+    EventBlockCache& cache = eventBlockCache;
+    if (cache.freeCount[blockClass] >= EVENT_BLOCK_MAX_FREE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    *static_cast<void**>(ptr) = cache.freeBlocks[blockClass];
+    cache.freeBlocks[blockClass] = ptr;
+    ++cache.freeCount[blockClass];
+}
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
     m_aborting = false;
+    m_sequence = 0;
 }
 
 EventProcessor::~EventProcessor()
@@ -35,12 +100,11 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (!m_events.empty() && m_events.front()->m_execTime <= m_time)
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        BasicEvent* Event = m_events.front();
+        RemoveAt(0);
 
         if (!Event->to_Abort)
         {
@@ -63,39 +127,45 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
-    // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
-    {
-        EventList::iterator i_old = i;
-        ++i;
+    // abort callbacks may add or kill events, work on a detached copy in execution order
+    EventList events;
+    events.swap(m_events);
+    std::sort(events.begin(), events.end(), &EventProcessor::IsEarlier);
+    for (BasicEvent* event : events)
+        event->m_queueIndex = BasicEvent::NOT_QUEUED;
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
-        {
-            delete i_old->second;
-
-            if (!force)                                     // need per-element cleanup
-                m_events.erase(i_old);
-        }
+    EventList kept;
+    for (BasicEvent* event : events)
+    {
+        event->to_Abort = true;
+        event->Abort(m_time);
+        if (force || event->IsDeletable())
+            delete event;
+        else
+            kept.push_back(event);
     }
 
-    // fast clear event list (in force case)
+    // events added by the abort callbacks go the same way
     if (force)
-        m_events.clear();
+    {
+        if (!m_events.empty())
+            KillAllEvents(true);
+        return;
+    }
+
+    // undeletable events stay queued, keeping their order
+    for (BasicEvent* event : kept)
+        Push(event);
 }
 
 void EventProcessor::KillEvent(BasicEvent* event)
 {
-    for (EventList::iterator iter = m_events.begin(); iter != m_events.end();)
-    {
-        if (iter->second == event)
-        {
-            delete iter->second;
-            iter = m_events.erase(iter);
-        }
-        else ++iter;
-    }
+    size_t index = event->m_queueIndex;
+    if (index >= m_events.size() || m_events[index] != event)
+        return;
+
+    RemoveAt(index);
+    delete event;
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -104,24 +174,96 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Event->m_sequence = ++m_sequence;
+    Push(Event);
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* Event, uint64 msTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
-    {
-        if (itr->second != Event)
-            continue;
+    size_t index = Event->m_queueIndex;
+    if (index >= m_events.size() || m_events[index] != Event)
+        return;
 
-        Event->m_execTime = msTime;
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(msTime, Event));
-        break;
-    }
+    // goes behind events already due at the new time
+    RemoveAt(index);
+    Event->m_execTime = msTime;
+    Event->m_sequence = ++m_sequence;
+    Push(Event);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
 {
     return m_time + t_offset;
 }
+
+bool EventProcessor::IsEarlier(BasicEvent const* lhs, BasicEvent const* rhs)
+{
+    if (lhs->m_execTime != rhs->m_execTime)
+        return lhs->m_execTime < rhs->m_execTime;
+    return lhs->m_sequence < rhs->m_sequence;
+}
+
+void EventProcessor::Push(BasicEvent* event)
+{
+    m_events.push_back(event);
+    event->m_queueIndex = m_events.size() - 1;
+    SiftUp(m_events.size() - 1);
+}
+
+void EventProcessor::RemoveAt(size_t index)
+{
+    m_events[index]->m_queueIndex = BasicEvent::NOT_QUEUED;
+
+    BasicEvent* last = m_events.back();
+    m_events.pop_back();
+    if (index == m_events.size())
+        return;
+
+    Place(last, index);
+    if (index > 0 && IsEarlier(last, m_events[(index - 1) / 2]))
+        SiftUp(index);
+    else
+        SiftDown(index);
+}
+
+void EventProcessor::SiftUp(size_t index)
+{
+    BasicEvent* event = m_events[index];
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (!IsEarlier(event, m_events[parent]))
+            break;
+
+        Place(m_events[parent], index);
+        index = parent;
+    }
+    Place(event, index);
+}
+
+void EventProcessor::SiftDown(size_t index)
+{
+    BasicEvent* event = m_events[index];
+    size_t size = m_events.size();
+    while (true)
+    {
+        size_t child = index * 2 + 1;
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && IsEarlier(m_events[child + 1], m_events[child]))
+            ++child;
+        if (!IsEarlier(m_events[child], event))
+            break;
+
+        Place(m_events[child], index);
+        index = child;
+    }
+    Place(event, index);
+}
+
+void EventProcessor::Place(BasicEvent* event, size_t index)
+{
+    m_events[index] = event;
+    event->m_queueIndex = index;
+}
@@ -21,16 +21,19 @@
 
 #include "Platform/Define.h"
 
-#include <map>
+#include <cstddef>
+#include <vector>
 
 // Note. All times are in milliseconds here.
 
 class BasicEvent
 {
+        friend class EventProcessor;
+
     public:
 
         BasicEvent()
-            : to_Abort(false)
+            : to_Abort(false), m_sequence(0), m_queueIndex(NOT_QUEUED)
         {
         }
 
@@ -53,9 +56,20 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
+
+        // events are created and deleted all the time, their memory is recycled per thread by size
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
+    private:
+        static const size_t NOT_QUEUED = size_t(-1);
+
+        uint64 m_sequence;                                  // events due at the same time execute in the order they were added
+        size_t m_queueIndex;                                // position in the queue of the EventProcessor, NOT_QUEUED if none
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+// queued events, heap ordered by execution time - not sorted
+typedef std::vector<BasicEvent*> EventList;
 
 class EventProcessor
 {
@@ -70,13 +84,24 @@ class EventProcessor
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         void ModifyEventTime(BasicEvent* event, uint64 msTime);
         uint64 CalculateTime(uint64 t_offset) const;
-        EventList& GetEvents() { return m_events; }
+        EventList const& GetEvents() const { return m_events; }
 
     protected:
 
         uint64 m_time;
         EventList m_events;
         bool m_aborting;
+
+    private:
+        static bool IsEarlier(BasicEvent const* lhs, BasicEvent const* rhs);
+
+        void Push(BasicEvent* event);
+        void RemoveAt(size_t index);
+        void SiftUp(size_t index);
+        void SiftDown(size_t index);
+        void Place(BasicEvent* event, size_t index);
+
+        uint64 m_sequence;
 };
 
 #endif
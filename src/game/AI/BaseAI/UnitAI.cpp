@@ -603,6 +603,7 @@ class AiDelayEventAround : public BasicEvent
             {
                 if (Creature* pReceiver = m_owner.GetMap()->GetAnyTypeCreature(*itr))
                 {
+                    pReceiver->PromoteUpdateLOD();
                     pReceiver->AI()->ReceiveAIEvent(m_eventType, &m_owner, pInvoker, m_miscValue);
                     // Special case for type 0 (call-assistance)
                     if (m_eventType == AI_EVENT_CALL_ASSISTANCE)
@@ -656,6 +657,7 @@ void UnitAI::SendAIEventAround(AIEventType eventType, Unit* invoker, uint32 dela
             {
                 for (Creature* receiver : receiverList)
                 {
+                    receiver->PromoteUpdateLOD();
                     receiver->AI()->ReceiveAIEvent(eventType, m_unit, invoker, miscValue);
                     // Special case for type 0 (call-assistance)
                     if (eventType == AI_EVENT_CALL_ASSISTANCE)
@@ -669,6 +671,8 @@ void UnitAI::SendAIEventAround(AIEventType eventType, Unit* invoker, uint32 dela
 void UnitAI::SendAIEvent(AIEventType eventType, Unit* invoker, Unit* receiver, uint32 miscValue /*=0*/) const
 {
     MANGOS_ASSERT(receiver);
+    if (receiver->GetTypeId() == TYPEID_UNIT)
+        static_cast<Creature*>(receiver)->PromoteUpdateLOD();
     receiver->AI()->ReceiveAIEvent(eventType, m_unit, invoker, miscValue);
 }
 
@@ -32,6 +32,8 @@
 #include "Spells/Spell.h"
 #include "MotionGenerators/MovementGenerator.h"
 
+#include <chrono>
+
 bool CreatureEventAIHolder::UpdateRepeatTimer(Creature* creature, uint32 repeatMin, uint32 repeatMax)
 {
     if (repeatMin == repeatMax)
@@ -103,7 +105,7 @@ CreatureEventAI::CreatureEventAI(Creature* creature) : CreatureAI(creature),
     m_LastSpellMaxRange(0),
     m_despawnAggregationMask(0)
 {
-
+    memset(m_eventTypeStart, 0, sizeof(m_eventTypeStart));
 }
 
 void CreatureEventAI::InitAI()
@@ -198,6 +200,48 @@ void CreatureEventAI::InitAI()
         const CreatureEventAI_Event_Vec& creatureEvent = creatureEventsGuidItr->second;
         processMap(creatureEvent);
     }
+
+    BuildEventIndex();
+}
+
+void CreatureEventAI::BuildEventIndex()
+{
+    m_eventsByType.clear();
+    m_timedEvents.clear();
+    memset(m_eventTypeStart, 0, sizeof(m_eventTypeStart));
+
+    if (m_CreatureEventAIList.size() > 0xFFFF)
+    {
+        sLog.outErrorEventAI("Creature %u has %u events, only the first 65535 are used.", m_creature->GetEntry(), uint32(m_CreatureEventAIList.size()));
+        m_CreatureEventAIList.erase(m_CreatureEventAIList.begin() + 0xFFFF, m_CreatureEventAIList.end());
+    }
+
+    // counting sort by type keeps list order within a type
+    for (CreatureEventAIHolder const& holder : m_CreatureEventAIList)
+        ++m_eventTypeStart[holder.event.event_type + 1];
+    for (uint32 type = 1; type <= EVENT_T_END; ++type)
+        m_eventTypeStart[type] += m_eventTypeStart[type - 1];
+
+    uint16 next[EVENT_T_END];
+    memcpy(next, m_eventTypeStart, sizeof(next));
+    m_eventsByType.resize(m_CreatureEventAIList.size());
+    for (uint32 i = 0; i < m_CreatureEventAIList.size(); ++i)
+    {
+        CreatureEventAI_Event const& event = m_CreatureEventAIList[i].event;
+        m_eventsByType[next[event.event_type]++] = uint16(i);
+
+        // only timer based events ever get a timer, UpdateEventTimers has nothing to do for the rest
+        bool checkAlways = event.event_type == EVENT_T_TARGET_NOT_REACHABLE;
+        if (!checkAlways && !IsTimerBasedEvent(event.event_type))
+            continue;
+
+        CreatureEventAITimedEvent timed;
+        timed.holderIndex = uint16(i);
+        timed.timerExecuted = IsTimerExecutedEvent(event.event_type);
+        timed.checkAlways = checkAlways;
+        timed.inversePhaseMask = event.event_inverse_phase_mask;
+        m_timedEvents.push_back(timed);
+    }
 }
 
 bool CreatureEventAI::IsTimerExecutedEvent(EventAI_Type type) const
@@ -1493,11 +1537,10 @@ void CreatureEventAI::Reset()
 void CreatureEventAI::JustReachedHome()
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
+    DoForEventsOfType(EVENT_T_REACHED_HOME, [&](CreatureEventAIHolder& i)
     {
-        if (i.event.event_type == EVENT_T_REACHED_HOME)
-            CheckAndReadyEventForExecution(i);
-    }
+        CheckAndReadyEventForExecution(i);
+    });
     ProcessEvents();
 
     Reset();
@@ -1509,11 +1552,10 @@ void CreatureEventAI::EnterEvadeMode()
 
     // Handle Evade events
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
+    DoForEventsOfType(EVENT_T_EVADE, [&](CreatureEventAIHolder& i)
     {
-        if (i.event.event_type == EVENT_T_EVADE)
-            CheckAndReadyEventForExecution(i);
-    }
+        CheckAndReadyEventForExecution(i);
+    });
     ProcessEvents();
 
     if ((m_despawnAggregationMask & AGGREGATION_EVADE) != 0)
@@ -1530,11 +1572,10 @@ void CreatureEventAI::JustDied(Unit* killer)
 
     // Handle On Death events
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
+    DoForEventsOfType(EVENT_T_DEATH, [&](CreatureEventAIHolder& i)
     {
-        if (i.event.event_type == EVENT_T_DEATH)
-            CheckAndReadyEventForExecution(i, killer);
-    }
+        CheckAndReadyEventForExecution(i, killer);
+    });
     ProcessEvents(killer);
 
     // reset phase after any death state events
@@ -1547,22 +1588,20 @@ void CreatureEventAI::JustDied(Unit* killer)
 void CreatureEventAI::KilledUnit(Unit* victim)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
+    DoForEventsOfType(EVENT_T_KILL, [&](CreatureEventAIHolder& i)
     {
-        if (i.event.event_type == EVENT_T_KILL)
-            CheckAndReadyEventForExecution(i, victim);
-    }
+        CheckAndReadyEventForExecution(i, victim);
+    });
     ProcessEvents(victim);
 }
 
 void CreatureEventAI::JustSummoned(Creature* summoned)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
+    DoForEventsOfType(EVENT_T_SUMMONED_UNIT, [&](CreatureEventAIHolder& i)
     {
-        if (i.event.event_type == EVENT_T_SUMMONED_UNIT)
-            CheckAndReadyEventForExecution(i, summoned);
-    }
+        CheckAndReadyEventForExecution(i, summoned);
+    });
     ProcessEvents(summoned);
     if ((m_despawnAggregationMask & AGGREGATION_ENABLED) != 0)
         if (m_entriesForDespawn.empty() || m_entriesForDespawn.find(summoned->GetEntry()) != m_entriesForDespawn.end())
@@ -1572,22 +1611,20 @@ void CreatureEventAI::JustSummoned(Creature* summoned)
 void CreatureEventAI::SummonedCreatureJustDied(Creature* summoned)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
+    DoForEventsOfType(EVENT_T_SUMMONED_JUST_DIED, [&](CreatureEventAIHolder& i)
     {
-        if (i.event.event_type == EVENT_T_SUMMONED_JUST_DIED)
-            CheckAndReadyEventForExecution(i, summoned);
-    }
+        CheckAndReadyEventForExecution(i, summoned);
+    });
     ProcessEvents(summoned);
 }
 
 void CreatureEventAI::SummonedCreatureDespawn(Creature* summoned)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
+    DoForEventsOfType(EVENT_T_SUMMONED_JUST_DESPAWN, [&](CreatureEventAIHolder& i)
     {
-        if (i.event.event_type == EVENT_T_SUMMONED_JUST_DESPAWN)
-            CheckAndReadyEventForExecution(i, summoned);
-    }
+        CheckAndReadyEventForExecution(i, summoned);
+    });
     ProcessEvents(summoned);
 }
 
@@ -1596,12 +1633,11 @@ void CreatureEventAI::ReceiveAIEvent(AIEventType eventType, Unit* sender, Unit*
     MANGOS_ASSERT(sender);
 
     IncreaseDepthIfNecessary();
-    for (auto& itr : m_CreatureEventAIList)
+    DoForEventsOfType(EVENT_T_RECEIVE_AI_EVENT, [&](CreatureEventAIHolder& itr)
     {
-        if (itr.event.event_type == EVENT_T_RECEIVE_AI_EVENT &&
-                itr.event.receiveAIEvent.eventType == uint32(eventType) && (!itr.event.receiveAIEvent.senderEntry || itr.event.receiveAIEvent.senderEntry == sender->GetEntry()))
+        if (itr.event.receiveAIEvent.eventType == uint32(eventType) && (!itr.event.receiveAIEvent.senderEntry || itr.event.receiveAIEvent.senderEntry == sender->GetEntry()))
             CheckAndReadyEventForExecution(itr, invoker, sender);
-    }
+    });
     ProcessEvents(invoker, sender);
 }
 
@@ -1616,11 +1652,12 @@ void CreatureEventAI::CorpseRemoved(uint32& respawnDelay)
 void CreatureEventAI::OnSpellCast(SpellEntry const* spellInfo, Unit* target)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_SPELL_CAST)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (spellInfo->Id == i.event.spellCast.spellId)
-                CheckAndReadyEventForExecution(i, target);
+    DoForEventsOfType(EVENT_T_SPELL_CAST, [&](CreatureEventAIHolder& i)
+    {
+        // If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (spellInfo->Id == i.event.spellCast.spellId)
+            CheckAndReadyEventForExecution(i, target);
+    });
 
     ProcessEvents(target);
 }
@@ -1628,52 +1665,57 @@ void CreatureEventAI::OnSpellCast(SpellEntry const* spellInfo, Unit* target)
 void CreatureEventAI::OnVehicleRide(Unit* vehicle, bool boarded, uint8 seat)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_BOARD_VEHICLE)
-            if (bool(i.event.boardVehicle.board) == boarded || i.event.boardVehicle.board == 2)
-                if (i.event.boardVehicle.seat == seat || i.event.boardVehicle.seat == -1)
-                    CheckAndReadyEventForExecution(i, vehicle);
+    DoForEventsOfType(EVENT_T_BOARD_VEHICLE, [&](CreatureEventAIHolder& i)
+    {
+        if (bool(i.event.boardVehicle.board) == boarded || i.event.boardVehicle.board == 2)
+            if (i.event.boardVehicle.seat == seat || i.event.boardVehicle.seat == -1)
+                CheckAndReadyEventForExecution(i, vehicle);
+    });
     ProcessEvents(vehicle);
 }
 
 void CreatureEventAI::OnPassengerRide(Unit* passenger, bool boarded, uint8 seat)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_PASSENGER_BOARDED)
-            if (bool(i.event.passengerBoard.board) == boarded || i.event.passengerBoard.board == 2)
-                if (i.event.passengerBoard.seat == seat || i.event.passengerBoard.seat == -1)
-                    CheckAndReadyEventForExecution(i, passenger);
+    DoForEventsOfType(EVENT_T_PASSENGER_BOARDED, [&](CreatureEventAIHolder& i)
+    {
+        if (bool(i.event.passengerBoard.board) == boarded || i.event.passengerBoard.board == 2)
+            if (i.event.passengerBoard.seat == seat || i.event.passengerBoard.seat == -1)
+                CheckAndReadyEventForExecution(i, passenger);
+    });
     ProcessEvents(passenger);
 }
 
 void CreatureEventAI::OnVehicleReturn(uint8 seat)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_VEHICLE_RETURN)
-            if (i.event.vehicleReturn.seat == seat || i.event.vehicleReturn.seat == -1)
-                CheckAndReadyEventForExecution(i);
+    DoForEventsOfType(EVENT_T_VEHICLE_RETURN, [&](CreatureEventAIHolder& i)
+    {
+        if (i.event.vehicleReturn.seat == seat || i.event.vehicleReturn.seat == -1)
+            CheckAndReadyEventForExecution(i);
+    });
     ProcessEvents();
 }
 
 void CreatureEventAI::OnPassengerSpawn(uint8 seat)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_VEHICLE_RETURN)
-            if (i.event.passengerSpawn.seat == seat || i.event.passengerSpawn.seat == -1)
-                CheckAndReadyEventForExecution(i);
+    DoForEventsOfType(EVENT_T_VEHICLE_RETURN, [&](CreatureEventAIHolder& i)
+    {
+        if (i.event.passengerSpawn.seat == seat || i.event.passengerSpawn.seat == -1)
+            CheckAndReadyEventForExecution(i);
+    });
     ProcessEvents();
 }
 
 void CreatureEventAI::OnPassengerControlEnd(uint8 seat)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_VEHICLE_RETURN)
-            if (i.event.passengerControlEnd.seat == seat || i.event.passengerControlEnd.seat == -1)
-                CheckAndReadyEventForExecution(i);
+    DoForEventsOfType(EVENT_T_VEHICLE_RETURN, [&](CreatureEventAIHolder& i)
+    {
+        if (i.event.passengerControlEnd.seat == seat || i.event.passengerControlEnd.seat == -1)
+            CheckAndReadyEventForExecution(i);
+    });
     ProcessEvents();
 }
 
@@ -1720,27 +1762,24 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
     IncreaseDepthIfNecessary();
     if (m_HasOOCLoSEvent && !m_creature->GetVictim())
     {
-        for (auto& itr : m_CreatureEventAIList)
+        DoForEventsOfType(EVENT_T_OOC_LOS, [&](CreatureEventAIHolder& itr)
         {
-            if (itr.event.event_type == EVENT_T_OOC_LOS)
-            {
-                // can trigger if closer than fMaxAllowedRange
-                float fMaxAllowedRange = (float)itr.event.ooc_los.maxRange;
+            // can trigger if closer than fMaxAllowedRange
+            float fMaxAllowedRange = (float)itr.event.ooc_los.maxRange;
 
-                // who must be player type if this option is turned on
-                if (!itr.event.ooc_los.playerOnly || who->GetTypeId() == TYPEID_PLAYER)
+            // who must be player type if this option is turned on
+            if (!itr.event.ooc_los.playerOnly || who->GetTypeId() == TYPEID_PLAYER)
+            {
+                // if friendly event && who is not hostile OR hostile event && who is hostile
+                if ((itr.event.ooc_los.noHostile && !m_creature->IsEnemy(who)) ||
+                        ((!itr.event.ooc_los.noHostile) && m_creature->IsEnemy(who)))
                 {
-                    // if friendly event && who is not hostile OR hostile event && who is hostile
-                    if ((itr.event.ooc_los.noHostile && !m_creature->IsEnemy(who)) ||
-                            ((!itr.event.ooc_los.noHostile) && m_creature->IsEnemy(who)))
-                    {
-                        // if range is ok and we are actually in LOS
-                        if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
-                            CheckAndReadyEventForExecution(itr, who);
-                    }
+                    // if range is ok and we are actually in LOS
+                    if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
+                        CheckAndReadyEventForExecution(itr, who);
                 }
             }
-        }
+        });
         ProcessEvents(who);
     }
 
@@ -1750,12 +1789,13 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
 void CreatureEventAI::SpellHit(Unit* unit, const SpellEntry* spellInfo)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_SPELLHIT)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!i.event.spell_hit.spellId || spellInfo->Id == i.event.spell_hit.spellId)
-                if (spellInfo->SchoolMask & i.event.spell_hit.schoolMask)
-                    CheckAndReadyEventForExecution(i, unit);
+    DoForEventsOfType(EVENT_T_SPELLHIT, [&](CreatureEventAIHolder& i)
+    {
+        // If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!i.event.spell_hit.spellId || spellInfo->Id == i.event.spell_hit.spellId)
+            if (spellInfo->SchoolMask & i.event.spell_hit.schoolMask)
+                CheckAndReadyEventForExecution(i, unit);
+    });
 
     ProcessEvents(unit);
 }
@@ -1763,12 +1803,13 @@ void CreatureEventAI::SpellHit(Unit* unit, const SpellEntry* spellInfo)
 void CreatureEventAI::SpellHitTarget(Unit* target, const SpellEntry* spellInfo)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_SPELLHIT_TARGET)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!i.event.spell_hit_target.spellId || spellInfo->Id == i.event.spell_hit_target.spellId)
-                if (spellInfo->SchoolMask & i.event.spell_hit_target.schoolMask)
-                    CheckAndReadyEventForExecution(i, target);
+    DoForEventsOfType(EVENT_T_SPELLHIT_TARGET, [&](CreatureEventAIHolder& i)
+    {
+        // If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!i.event.spell_hit_target.spellId || spellInfo->Id == i.event.spell_hit_target.spellId)
+            if (spellInfo->SchoolMask & i.event.spell_hit_target.schoolMask)
+                CheckAndReadyEventForExecution(i, target);
+    });
 
     ProcessEvents(target);
 }
@@ -1911,16 +1952,13 @@ inline Unit* CreatureEventAI::GetTargetByType(uint32 target, Unit* actionInvoker
 void CreatureEventAI::ReceiveEmote(Player* player, uint32 textEmote)
 {
     IncreaseDepthIfNecessary();
-    for (auto& itr : m_CreatureEventAIList)
+    DoForEventsOfType(EVENT_T_RECEIVE_EMOTE, [&](CreatureEventAIHolder& itr)
     {
-        if (itr.event.event_type == EVENT_T_RECEIVE_EMOTE)
-        {
-            if (itr.event.receive_emote.emoteId != textEmote)
-                continue;
+        if (itr.event.receive_emote.emoteId != textEmote)
+            return;
 
-            CheckAndReadyEventForExecution(itr, player);
-        }
-    }
+        CheckAndReadyEventForExecution(itr, player);
+    });
     ProcessEvents(player);
 }
 
@@ -1961,10 +1999,10 @@ void CreatureEventAI::DamageTaken(Unit* dealer, uint32& damage, DamageEffectType
 void CreatureEventAI::JustPreventedDeath(Unit* attacker)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_DEATH_PREVENTED)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            CheckAndReadyEventForExecution(i, attacker);
+    DoForEventsOfType(EVENT_T_DEATH_PREVENTED, [&](CreatureEventAIHolder& i)
+    {
+        CheckAndReadyEventForExecution(i, attacker);
+    });
 
     ProcessEvents(attacker);
 }
@@ -2016,38 +2054,47 @@ void CreatureEventAI::UpdateEventTimers(const uint32 diff)
     {
         m_EventDiff += diff;
 
+        auto startTime = std::chrono::steady_clock::now();
+
         // Check for time based events
         IncreaseDepthIfNecessary();
-        for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        uint32 phaseMask = 1 << m_Phase;
+        for (CreatureEventAITimedEvent const& timed : m_timedEvents)
         {
-            if (i->event.event_type == EVENT_T_TARGET_NOT_REACHABLE)
+            CreatureEventAIHolder& holder = m_CreatureEventAIList[timed.holderIndex];
+            if (timed.checkAlways)
             {
-                CheckAndReadyEventForExecution(*i);
+                CheckAndReadyEventForExecution(holder);
                 continue;
             }
 
             // Decrement Timers
-            if (i->timer)
+            if (holder.timer)
             {
                 // Do not decrement timers if event cannot trigger in this phase
-                if (!(i->event.event_inverse_phase_mask & (1 << m_Phase)))
+                if (!(timed.inversePhaseMask & phaseMask))
                 {
-                    if (i->timer > m_EventDiff)
-                        i->timer -= m_EventDiff;
+                    if (holder.timer > m_EventDiff)
+                        holder.timer -= m_EventDiff;
                     else
-                        i->timer = 0;
+                        holder.timer = 0;
                 }
             }
 
             // Skip processing of events that have time remaining or are disabled
-            if (!(i->enabled) || i->timer)
+            if (!holder.enabled || holder.timer)
                 continue;
 
-            if (IsTimerExecutedEvent(i->event.event_type))
-                CheckAndReadyEventForExecution(*i);
+            if (timed.timerExecuted)
+                CheckAndReadyEventForExecution(holder);
         }
         ProcessEvents();
 
+        EventAIUpdateStats& stats = m_creature->GetMap()->GetEventAIUpdateStats();
+        stats.updateTime += uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count());
+        stats.events += m_timedEvents.size();
+        ++stats.updates;
+
         m_EventDiff = 0;
         m_EventUpdateTime = EVENT_UPDATE_TIME;
     }
@@ -884,6 +884,15 @@ struct CreatureEventAIHolder
     bool UpdateRepeatTimer(Creature* creature, uint32 repeatMin, uint32 repeatMax);
 };
 
+// Event of m_CreatureEventAIList that UpdateEventTimers has to look at, compiled by CreatureEventAI::BuildEventIndex
+struct CreatureEventAITimedEvent
+{
+    uint16 holderIndex;                                     // position in m_CreatureEventAIList
+    bool timerExecuted;                                     // IsTimerExecutedEvent, checked once its timer expired
+    bool checkAlways;                                       // EVENT_T_TARGET_NOT_REACHABLE, checked on every update
+    uint32 inversePhaseMask;                                // event_inverse_phase_mask, timer is paused in these phases
+};
+
 class CreatureEventAI : public CreatureAI
 {
     public:
@@ -932,6 +941,13 @@ class CreatureEventAI : public CreatureAI
         void ResetEvent(CreatureEventAIHolder& holder);
         void CheckAndReadyEventForExecution(CreatureEventAIHolder& holder, Unit* actionInvoker = nullptr, Unit* AIEventSender = nullptr);
         void IncreaseDepthIfNecessary() { if (m_depth >= m_creatureEventAITempList.size()) m_creatureEventAITempList.resize(m_depth + 1); }
+        // calls func for the events of type, in m_CreatureEventAIList order
+        template<typename Func>
+        void DoForEventsOfType(EventAI_Type type, Func const& func)
+        {
+            for (uint32 i = m_eventTypeStart[type]; i < m_eventTypeStart[type + 1]; ++i)
+                func(m_CreatureEventAIList[m_eventsByType[i]]);
+        }
         virtual bool ProcessEvent(CreatureEventAIHolder& holder, Unit* actionInvoker = nullptr, Unit* AIEventSender = nullptr);
         virtual bool ProcessAction(CreatureEventAI_Action const& action, uint32 rnd, uint32 eventId, Unit* actionInvoker, Unit* AIEventSender, Unit* eventTarget);
         inline uint32 GetRandActionParam(uint32 rnd, uint32 param1, uint32 param2, uint32 param3) const;
@@ -948,6 +964,8 @@ class CreatureEventAI : public CreatureAI
         bool IsTimerExecutedEvent(EventAI_Type type) const;
         bool IsRepeatableEvent(EventAI_Type type) const;
         bool IsTimerBasedEvent(EventAI_Type type) const;
+        // groups m_CreatureEventAIList by event type and collects the timer driven events
+        void BuildEventIndex();
 
         uint32 m_EventUpdateTime;                           // Time between event updates
         uint32 m_EventDiff;                                 // Time between the last event call
@@ -959,6 +977,11 @@ class CreatureEventAI : public CreatureAI
         std::vector<std::vector<std::reference_wrapper<CreatureEventAIHolder>>> m_creatureEventAITempList; // Holder for events that are ready to go off
         uint32 m_depth;
 
+        // m_CreatureEventAIList positions sorted by event type, those of type t are at m_eventTypeStart[t] up to m_eventTypeStart[t + 1]
+        std::vector<uint16> m_eventsByType;
+        uint16 m_eventTypeStart[EVENT_T_END + 1];
+        std::vector<CreatureEventAITimedEvent> m_timedEvents; // in m_CreatureEventAIList order
+
         uint8  m_Phase;                                     // Current phase, max 32 phases
         bool   m_HasOOCLoSEvent;                            // Cache if a OOC-LoS Event exists
         uint32 m_InvinceabilityHpLevel;                     // Minimal health level allowed at damage apply
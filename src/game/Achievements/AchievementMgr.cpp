@@ -469,6 +469,7 @@ void AchievementMgr::Reset()
 
     m_completedAchievements.clear();
     m_criteriaProgress.clear();
+    m_completedCriteria.clear();
     DeleteFromDB(m_player->GetObjectGuid());
 
     // re-fill data
@@ -679,6 +680,8 @@ void AchievementMgr::LoadFromDB(std::unique_ptr<QueryResult> achievementResult,
             AchievementEntry const* achievement = sAchievementStore.LookupEntry(criteria->referredAchievement);
             // Checked in LoadAchievementCriteriaList
 
+            UpdateCompletedCriteria(criteria, achievement, &progress);
+
             // A failed achievement will be removed on next tick - TODO: Possible that timer 2 is reseted
             if (criteria->timeLimit)
             {
@@ -848,6 +851,7 @@ void AchievementMgr::StartTimedAchievementCriteria(AchievementCriteriaTypes type
 
         progress->changed = true;
         progress->counter = 0;
+        UpdateCompletedCriteria(achievementCriteria, achievement, progress);
 
         // Start with given startTime or now
         progress->date = startTime ? startTime : time(nullptr);
@@ -898,6 +902,7 @@ void AchievementMgr::DoFailedTimedAchievementCriterias()
 
             // Remove failed progress
             m_criteriaProgress.erase(pro_iter);
+            UpdateCompletedCriteria(criteria, achievement, nullptr);
         }
 
         m_criteriaFailTimes.erase(iter++);
@@ -914,7 +919,8 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
     if (!sWorld.getConfig(CONFIG_BOOL_GM_ALLOW_ACHIEVEMENT_GAINS) && m_player->GetSession()->GetSecurity() > SEC_PLAYER)
         return;
 
-    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr.GetAchievementCriteriaByType(type);
+    // criteria that cannot match miscvalue1 are skipped by the index, the switch below would reject them anyway
+    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr.GetAchievementCriteriaByType(type, miscvalue1);
     for (auto achievementCriteria : achievementCriteriaList)
     {
         AchievementEntry const* achievement = sAchievementStore.LookupEntry(achievementCriteria->referredAchievement);
@@ -2106,15 +2112,15 @@ bool AchievementMgr::IsCompletedCriteria(AchievementCriteriaEntry const* achieve
             return false;
     }
 
-    CriteriaProgressMap::const_iterator itr = m_criteriaProgress.find(achievementCriteria->ID);
-    if (itr == m_criteriaProgress.end())
-        return false;
-
-    CriteriaProgress const* progress = &itr->second;
-
-    uint32 maxcounter = GetCriteriaProgressMaxCounter(achievementCriteria, achievement);
+    return m_completedCriteria.find(achievementCriteria->ID) != m_completedCriteria.end();
+}
 
-    return progress->counter >= maxcounter || (achievement->flags & ACHIEVEMENT_FLAG_REQ_COUNT && progress->counter);
+void AchievementMgr::UpdateCompletedCriteria(AchievementCriteriaEntry const* criteria, AchievementEntry const* achievement, CriteriaProgress const* progress)
+{
+    if (progress && (progress->counter >= GetCriteriaProgressMaxCounter(criteria, achievement) || (achievement->flags & ACHIEVEMENT_FLAG_REQ_COUNT && progress->counter)))
+        m_completedCriteria.insert(criteria->ID);
+    else
+        m_completedCriteria.erase(criteria->ID);
 }
 
 void AchievementMgr::CompletedCriteriaFor(AchievementEntry const* achievement)
@@ -2255,6 +2261,7 @@ void AchievementMgr::SetCriteriaProgress(AchievementCriteriaEntry const* criteri
 
     progress->counter = newValue;
     progress->changed = true;
+    UpdateCompletedCriteria(criteria, achievement, progress);
 
     // update client side value
     SendCriteriaUpdate(criteria->ID, progress);
@@ -2457,6 +2464,89 @@ AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteria
     return m_AchievementCriteriasByType[type];
 }
 
+AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteriaByType(AchievementCriteriaTypes type, uint32 miscValue) const
+{
+    // 0 is used by login and full rechecks, those look at every criteria of the type
+    if (!miscValue || !IsCriteriaTypeIndexedByMiscValue(type))
+        return m_AchievementCriteriasByType[type];
+
+    static const AchievementCriteriaEntryList emptyList;
+    AchievementCriteriaListByMiscValue::const_iterator itr = m_AchievementCriteriasByTypeAndMisc[type].find(miscValue);
+    return itr != m_AchievementCriteriasByTypeAndMisc[type].end() ? itr->second : emptyList;
+}
+
+// Types for which AchievementMgr::UpdateAchievementCriteria skips every criteria whose id field differs from a nonzero miscvalue1
+bool AchievementGlobalMgr::IsCriteriaTypeIndexedByMiscValue(AchievementCriteriaTypes type)
+{
+    switch (type)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_TEAM_RATING:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_PERSONAL_RATING:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// the id field of criteria compared against miscvalue1, see IsCriteriaTypeIndexedByMiscValue
+static uint32 GetCriteriaIndexedMiscValue(AchievementCriteriaEntry const* criteria)
+{
+    switch (criteria->requiredType)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:           return criteria->kill_creature.creatureID;
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:       return criteria->reach_skill_level.skillID;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:       return criteria->learn_skill_level.skillID;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE: return criteria->complete_quests_in_zone.zoneID;
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:      return criteria->killed_by_creature.creatureEntry;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:          return criteria->complete_quest.questID;
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:        return criteria->be_spell_target.spellID;
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:             return criteria->cast_spell.spellID;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:             return criteria->learn_spell.spellID;
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:               return criteria->loot_type.lootType;
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:               return criteria->own_item.itemID;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:                return criteria->use_item.itemID;
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:         return criteria->gain_reputation.factionID;
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:                return criteria->do_emote.emoteID;
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:              return criteria->equip_item.itemID;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:          return criteria->use_gameobject.goEntry;
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:      return criteria->fish_in_gameobject.goEntry;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:  return criteria->learn_skillline_spell.skillLine;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:        return criteria->learn_skill_line.skillLine;
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:                return criteria->hk_class.classID;
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:                 return criteria->hk_race.raceID;
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_TEAM_RATING:     return criteria->highest_team_rating.teamtype;
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_PERSONAL_RATING: return criteria->highest_personal_rating.teamtype;
+        default:                                                return 0;
+    }
+}
+
 AchievementCriteriaEntryList const* AchievementGlobalMgr::GetAchievementCriteriaByAchievement(uint32 id)
 {
     AchievementCriteriaListByAchievement::const_iterator itr = m_AchievementCriteriaListByAchievement.find(id);
@@ -2539,6 +2629,8 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
         }
 
         m_AchievementCriteriasByType[criteria->requiredType].push_back(criteria);
+        if (IsCriteriaTypeIndexedByMiscValue(AchievementCriteriaTypes(criteria->requiredType)))
+            m_AchievementCriteriasByTypeAndMisc[criteria->requiredType][GetCriteriaIndexedMiscValue(criteria)].push_back(criteria);
         m_AchievementCriteriaListByAchievement[criteria->referredAchievement].push_back(criteria);
         ++count;
     }
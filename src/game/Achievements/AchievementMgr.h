@@ -26,6 +26,7 @@
 
 #include <map>
 #include <memory>
+#include <unordered_set>
 
 struct AchievementEntry;
 struct AchievementCriteriaEntry;
@@ -34,6 +35,7 @@ typedef std::list<AchievementCriteriaEntry const*> AchievementCriteriaEntryList;
 typedef std::list<AchievementEntry const*>         AchievementEntryList;
 
 typedef std::map<uint32, AchievementCriteriaEntryList> AchievementCriteriaListByAchievement;
+typedef std::unordered_map<uint32, AchievementCriteriaEntryList> AchievementCriteriaListByMiscValue;
 typedef std::map<uint32, AchievementEntryList>         AchievementListByReferencedId;
 typedef std::map<uint32, time_t>                       AchievementCriteriaFailTimeMap;
 
@@ -318,10 +320,13 @@ class AchievementMgr
         void CompletedAchievement(AchievementEntry const* achievement);
         void IncompletedAchievement(AchievementEntry const* achievement);
         bool IsCompletedAchievement(AchievementEntry const* entry);
+        // keeps m_completedCriteria in line with progress, nullptr when the progress got removed
+        void UpdateCompletedCriteria(AchievementCriteriaEntry const* criteria, AchievementEntry const* achievement, CriteriaProgress const* progress);
         void BuildAllDataPacket(WorldPacket& data);
 
         Player* m_player;
         CriteriaProgressMap m_criteriaProgress;
+        std::unordered_set<uint32> m_completedCriteria;    // criteria with progress reaching their max counter
         CompletedAchievementMap m_completedAchievements;
         AchievementCriteriaFailTimeMap m_criteriaFailTimes;
 };
@@ -330,6 +335,9 @@ class AchievementGlobalMgr
 {
     public:
         AchievementCriteriaEntryList const& GetAchievementCriteriaByType(AchievementCriteriaTypes type) const;
+        // criteria of type that can match an update with miscValue, all of the type for 0 or types not indexed by it
+        AchievementCriteriaEntryList const& GetAchievementCriteriaByType(AchievementCriteriaTypes type, uint32 miscValue) const;
+        static bool IsCriteriaTypeIndexedByMiscValue(AchievementCriteriaTypes type);
         AchievementCriteriaEntryList const* GetAchievementCriteriaByAchievement(uint32 id);
         AchievementEntryList const* GetAchievementByReferencedId(uint32 id) const;
         AchievementReward const* GetAchievementReward(AchievementEntry const* achievement, uint8 gender) const;
@@ -351,6 +359,8 @@ class AchievementGlobalMgr
 
         // store achievement criterias by type to speed up lookup
         AchievementCriteriaEntryList m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        // same, for types whose updates only match criteria with the id given as miscvalue1 (creature, item, spell...)
+        AchievementCriteriaListByMiscValue m_AchievementCriteriasByTypeAndMisc[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
         // store achievement criterias by achievement to speed up lookup
         AchievementCriteriaListByAchievement m_AchievementCriteriaListByAchievement;
         // store achievements by referenced achievement id to speed up lookup
@@ -246,6 +246,22 @@ ChatCommand* ChatHandler::getCommandTable()
     {
         { "tempspawn",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleShowTemporarySpawnList,          "", nullptr },
         { "gridsloaded",    SEC_ADMINISTRATOR,  false, &ChatHandler::HandleGridsLoadedCount,                "", nullptr },
+        { "gridsearch",     SEC_ADMINISTRATOR,  false, &ChatHandler::HandleGridSearchBenchmark,             "", nullptr },
+        { "visibility",     SEC_ADMINISTRATOR,  false, &ChatHandler::HandleVisibilityBenchmark,             "", nullptr },
+        { "relocation",     SEC_ADMINISTRATOR,  false, &ChatHandler::HandleRelocationNotifyStats,           "", nullptr },
+        { "pools",          SEC_ADMINISTRATOR,  false, &ChatHandler::HandleObjectPoolStats,                 "", nullptr },
+        { "lod",            SEC_ADMINISTRATOR,  false, &ChatHandler::HandleUpdateLODStats,                  "", nullptr },
+        { "gridstate",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleGridStateStats,                  "", nullptr },
+        { "findplayer",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleFindPlayerBenchmark,             "", nullptr },
+        { "procs",          SEC_ADMINISTRATOR,  false, &ChatHandler::HandleProcDispatchBenchmark,           "", nullptr },
+        { "auras",          SEC_ADMINISTRATOR,  false, &ChatHandler::HandleAuraModifierBenchmark,           "", nullptr },
+        { "events",         SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleEventProcessorBenchmark,         "", nullptr },
+        { "spellmeta",      SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleSpellMetadataBenchmark,          "", nullptr },
+        { "castcheck",      SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleCastCheckBenchmark,              "", nullptr },
+        { "aoe",            SEC_ADMINISTRATOR,  false, &ChatHandler::HandleAreaTargetsBenchmark,            "", nullptr },
+        { "eventai",        SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleEventAIUpdateStats,              "", nullptr },
+        { "criteria",       SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleAchievementCriteriaBenchmark,    "", nullptr },
+        { "questgiver",     SEC_ADMINISTRATOR,  false, &ChatHandler::HandleQuestGiverStatusBenchmark,       "", nullptr },
         { nullptr,          0,                  false, nullptr,                                             "", nullptr }
     };
 
@@ -302,6 +302,22 @@ class ChatHandler
 
         bool HandleShowTemporarySpawnList(char* args);
         bool HandleGridsLoadedCount(char* args);
+        bool HandleGridSearchBenchmark(char* args);
+        bool HandleVisibilityBenchmark(char* args);
+        bool HandleRelocationNotifyStats(char* args);
+        bool HandleObjectPoolStats(char* args);
+        bool HandleUpdateLODStats(char* args);
+        bool HandleGridStateStats(char* args);
+        bool HandleFindPlayerBenchmark(char* args);
+        bool HandleProcDispatchBenchmark(char* args);
+        bool HandleAuraModifierBenchmark(char* args);
+        bool HandleEventProcessorBenchmark(char* args);
+        bool HandleSpellMetadataBenchmark(char* args);
+        bool HandleCastCheckBenchmark(char* args);
+        bool HandleAreaTargetsBenchmark(char* args);
+        bool HandleEventAIUpdateStats(char* args);
+        bool HandleAchievementCriteriaBenchmark(char* args);
+        bool HandleQuestGiverStatusBenchmark(char* args);
 
         bool HandleDebugPlayCinematicCommand(char* args);
         bool HandleDebugPlayMovieCommand(char* args);
@@ -52,6 +52,7 @@
 #include "Movement/MoveSplineInit.h"
 #include "Anticheat/Anticheat.hpp"
 #include "Entities/Transports.h"
+#include "Maps/TerrainStreamer.h"
 
 #include <fstream>
 #include <map>
@@ -5434,6 +5435,27 @@ bool ChatHandler::HandleMmapStatsCommand(char* /*args*/)
     MMAP::MMapManager* manager = MMAP::MMapFactory::createOrGetMMapManager();
     PSendSysMessage(" %u maps loaded with %u tiles overall", manager->getLoadedMapsCount(), manager->getLoadedTilesCount());
 
+    MMAP::PathCacheStats const& cacheStats = MMAP::PathCache::GetStats();
+    uint64 cacheHits = cacheStats.hits;
+    uint64 cacheLookups = cacheHits + cacheStats.misses;
+    PSendSysMessage(" path cache: " UI64FMTD " hits / " UI64FMTD " lookups (%.1f%%), " UI64FMTD " point path hits, " UI64FMTD " invalidated, " UI64FMTD " ms saved",
+                    cacheHits, cacheLookups, cacheLookups ? float(cacheHits) * 100.0f / cacheLookups : 0.0f,
+                    uint64(cacheStats.pointHits), uint64(cacheStats.invalidations), uint64(cacheStats.timeSaved) / 1000);
+    if (MMAP::PathCache const* pathCache = manager->GetPathCache(m_session->GetPlayer()->GetMapId(), m_session->GetPlayer()->GetInstanceId()))
+        PSendSysMessage(" path cache on current map: %u / %u entries", pathCache->GetSize(), pathCache->GetMaxSize());
+
+    if (sTerrainStreamer.IsEnabled())
+    {
+        TerrainStreamerStats const& streamerStats = TerrainStreamer::GetStats();
+        uint64 prefetchedLoads = streamerStats.prefetchedLoads;
+        uint64 lateLoads = streamerStats.lateLoads;
+        PSendSysMessage(" terrain streaming: " UI64FMTD " grids requested, " UI64FMTD " prepared, " UI64FMTD " navmesh tiles published ahead, " UI64FMTD " expired",
+                        uint64(streamerStats.requested), uint64(streamerStats.prepared), uint64(streamerStats.published), uint64(streamerStats.expired));
+        PSendSysMessage(" grid loads: " UI64FMTD " prefetched (avg " UI64FMTD " us), " UI64FMTD " late (avg " UI64FMTD " us)",
+                        prefetchedLoads, prefetchedLoads ? uint64(streamerStats.prefetchedLoadTime) / prefetchedLoads : 0,
+                        lateLoads, lateLoads ? uint64(streamerStats.lateLoadTime) / lateLoads : 0);
+    }
+
     const dtNavMesh* navmesh = manager->GetNavMesh(m_session->GetPlayer()->GetMapId(), m_session->GetPlayer()->GetInstanceId());
     if (!navmesh)
     {
@@ -5434,6 +5434,7 @@ bool ChatHandler::HandleQuestRemoveCommand(char* args)
 
     // reset rewarded for restart repeatable quest
     player->getQuestStatusMap()[entry].m_rewarded = false;
+    player->InvalidateQuestGiverStatus();
 
     SendSysMessage(LANG_COMMAND_QUEST_REMOVED);
     return true;
@@ -36,6 +36,15 @@
 #include "Models/M2Stores.h"
 #include "Entities/Transports.h"
 #include "World/World.h"
+#include "Grids/GridNotifiers.h"
+#include "Grids/GridNotifiersImpl.h"
+#include "Grids/CellImpl.h"
+#include "Entities/ObjectPool.h"
+
+#include "Globals/ObjectAccessor.h"
+#include "Achievements/AchievementMgr.h"
+#include <chrono>
+#include <thread>
 
 bool ChatHandler::HandleDebugSendSpellFailCommand(char* args)
 {
@@ -1469,6 +1478,801 @@ bool ChatHandler::HandleGridsLoadedCount(char* /*args*/)
     return true;
 }
 
+// .debug perf gridsearch [radius] [iterations] [crowd count] - compares unit searches around the player with and without the cell object index
+bool ChatHandler::HandleGridSearchBenchmark(char* args)
+{
+    Player* player = m_session->GetPlayer();
+
+    float radius;
+    uint32 iterations;
+    uint32 crowdCount;
+    if (!ExtractOptFloat(&args, radius, 30.0f) || !ExtractOptUInt32(&args, iterations, 1000) || !ExtractOptUInt32(&args, crowdCount, 0))
+        return false;
+
+    if (!iterations)
+        return false;
+
+    // fill the area up to crowded city densities with temporary copies of the selected creature
+    if (crowdCount)
+    {
+        Creature* target = getSelectedCreature();
+        if (!target)
+        {
+            SendSysMessage(LANG_SELECT_CREATURE);
+            SetSentErrorMessage(true);
+            return false;
+        }
+
+        for (uint32 i = 0; i < crowdCount; ++i)
+        {
+            float x, y, z;
+            player->GetRandomPoint(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ(), radius * 2, x, y, z);
+            player->SummonCreature(target->GetEntry(), x, y, z, 0.0f, TEMPSPAWN_TIMED_DESPAWN, 2 * MINUTE * IN_MILLISECONDS);
+        }
+    }
+
+    auto runSearches = [&](CellSearchMode mode, UnitList& result) -> uint64
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            result.clear();
+            MaNGOS::AnyUnitInObjectRangeCheck check(player, radius);
+            MaNGOS::UnitListSearcher<MaNGOS::AnyUnitInObjectRangeCheck> searcher(result, check);
+            Cell::VisitAllObjects(player, searcher, radius, true, mode);
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    UnitList listResult;
+    UnitList indexResult;
+    uint64 listTime = runSearches(CELL_SEARCH_CONTAINERS, listResult);
+    uint64 indexTime = runSearches(CELL_SEARCH_INDEX, indexResult);
+
+    std::set<Unit*> listUnits(listResult.begin(), listResult.end());
+    std::set<Unit*> indexUnits(indexResult.begin(), indexResult.end());
+
+    PSendSysMessage("Unit search in %.1f yards, %u iterations: %u units found", radius, iterations, uint32(listUnits.size()));
+    PSendSysMessage("Cell lists: %.2f us per search", float(listTime) / iterations);
+    PSendSysMessage("Cell index: %.2f us per search", float(indexTime) / iterations);
+    PSendSysMessage("Results %s", listUnits == indexUnits ? "match" : "differ");
+    return true;
+}
+
+// .debug perf visibility [iterations] - times full and incremental visibility passes of the player and lookups in its visible object set
+bool ChatHandler::HandleVisibilityBenchmark(char* args)
+{
+    Player* player = m_session->GetPlayer();
+
+    uint32 iterations;
+    if (!ExtractOptUInt32(&args, iterations, 100) || !iterations)
+        return false;
+
+    auto passStart = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+        player->GetCamera().UpdateVisibilityForOwner();
+    uint64 passTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - passStart).count();
+
+    // standing still, only objects near the edge of the visibility distance are rechecked
+    auto movedStart = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+        player->GetCamera().UpdateVisibilityForOwnerMoved();
+    uint64 movedTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - movedStart).count();
+
+    // same lookup pattern as broadcasts, every visible object once per iteration
+    GuidVector visible(player->GetClientGuids().begin(), player->GetClientGuids().end());
+    uint32 found = 0;
+    auto lookupStart = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+        for (ObjectGuid const& guid : visible)
+            found += player->HasAtClient(guid) ? 1 : 0;
+    uint64 lookupTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - lookupStart).count();
+
+    PSendSysMessage("%u objects at client, %u iterations", uint32(visible.size()), iterations);
+    PSendSysMessage("Visibility pass: %.2f us full, %.2f us after move", float(passTime) / iterations, float(movedTime) / iterations);
+    CameraVisibilityStats const& stats = Camera::GetVisibilityStats();
+    PSendSysMessage("Server passes: " UI64FMTD " full, " UI64FMTD " incremental, " UI64FMTD " verify mismatches",
+                    uint64(stats.fullPasses), uint64(stats.incrementalPasses), uint64(stats.verifyMismatches));
+    PSendSysMessage("HasAtClient: %.3f us per visible set (%u hits)", float(lookupTime) / iterations, found);
+    return true;
+}
+
+// .debug perf relocation - batched relocation notification counters of all maps
+bool ChatHandler::HandleRelocationNotifyStats(char* /*args*/)
+{
+    RelocationNotifyStats const& stats = Map::GetRelocationNotifyStats();
+    uint64 requested = stats.requested;
+    uint64 merged = stats.merged;
+    uint64 batches = stats.batches;
+
+    PSendSysMessage("Relocation notifies are %sbatched", sWorld.getConfig(CONFIG_BOOL_BATCH_RELOCATION_NOTIFIES) ? "" : "not ");
+    PSendSysMessage(UI64FMTD " queued, " UI64FMTD " merged (%.1f%%), " UI64FMTD " processed in " UI64FMTD " batches",
+                    requested, merged, requested ? float(merged) * 100.0f / requested : 0.0f, uint64(stats.processed), batches);
+    return true;
+}
+
+// .debug perf pools - recycled object memory per kind
+bool ChatHandler::HandleObjectPoolStats(char* /*args*/)
+{
+    for (uint32 i = 0; i < MAX_OBJECT_POOL_TYPE; ++i)
+    {
+        ObjectPool const& pool = ObjectPool::GetPool(ObjectPoolType(i));
+        ObjectPoolStats const& stats = pool.GetStats();
+        PSendSysMessage("%s (%u bytes): %u in use (high-water %u), %u free of %u max (high-water %u)", pool.GetName(), uint32(pool.GetBlockSize()),
+                        uint32(stats.inUse), uint32(stats.inUseHighWater), uint32(stats.free), pool.GetMaxFree(), uint32(stats.freeHighWater));
+        PSendSysMessage("    " UI64FMTD " allocated, " UI64FMTD " reused, " UI64FMTD " returned, " UI64FMTD " not pooled",
+                        uint64(stats.allocated), uint64(stats.reused), uint64(stats.returned), uint64(stats.bypassed));
+    }
+    return true;
+}
+
+// .debug perf lod - creature updates skipped for distance to players
+bool ChatHandler::HandleUpdateLODStats(char* /*args*/)
+{
+    UpdateLODStats const& stats = Map::GetUpdateLODStats();
+    uint64 updated = stats.updated;
+    uint64 skipped = stats.skipped;
+    uint64 ticks = stats.ticks;
+
+    PSendSysMessage("Update LOD is %s", sWorld.getConfig(CONFIG_BOOL_UPDATE_LOD) ? "enabled" : "disabled");
+    PSendSysMessage(UI64FMTD " creature updates, " UI64FMTD " skipped (%.1f%%), %.1f skipped per map update, " UI64FMTD " promoted",
+                    updated, skipped, updated + skipped ? float(skipped) * 100.0f / (updated + skipped) : 0.0f, ticks ? float(skipped) / ticks : 0.0f, uint64(stats.promoted));
+    return true;
+}
+
+// .debug perf gridstate - grid state transitions, load and unload times
+bool ChatHandler::HandleGridStateStats(char* /*args*/)
+{
+    GridStateStats const& stats = MapManager::GetGridStateStats();
+    uint64 loaded = stats.loaded;
+    uint64 unloaded = stats.unloaded;
+    uint64 teardowns = stats.teardowns;
+
+    PSendSysMessage(UI64FMTD " grids loaded with " UI64FMTD " objects, %.2f ms average, %.2f ms slowest",
+                    loaded, uint64(stats.loadedObjects), loaded ? float(stats.loadTime) / loaded / 1000.0f : 0.0f, float(stats.maxLoadTime) / 1000.0f);
+
+    PSendSysMessage(UI64FMTD " grids went idle, " UI64FMTD " unloaded, " UI64FMTD " unloads refused for active objects nearby, " UI64FMTD " deferred to a later update",
+                    uint64(stats.idled), unloaded, uint64(stats.unloadsRefused), uint64(stats.unloadsDeferred));
+    PSendSysMessage("Unload: %.2f ms average, %.2f ms slowest", unloaded ? float(stats.unloadTime) / unloaded / 1000.0f : 0.0f, float(stats.maxUnloadTime) / 1000.0f);
+    PSendSysMessage(UI64FMTD " terrain tiles released, " UI64FMTD " grids and tiles freed in the background, %.2f ms average",
+                    uint64(stats.tilesReleased), teardowns, teardowns ? float(stats.teardownTime) / teardowns / 1000.0f : 0.0f);
+    return true;
+}
+
+// .debug perf findplayer [threads] [lookups per thread] - concurrent player lookups, lock free table against the locked map
+bool ChatHandler::HandleFindPlayerBenchmark(char* args)
+{
+    uint32 threadCount;
+    uint32 lookups;
+    if (!ExtractOptUInt32(&args, threadCount, 8) || !ExtractOptUInt32(&args, lookups, 1000000))
+        return false;
+
+    if (!threadCount || threadCount > 64 || !lookups)
+        return false;
+
+    // online players and as many offline guids, lookups of players not in game are common too
+    std::vector<ObjectGuid> guids;
+    {
+        HashMapHolder<Player>::ReadGuard guard(HashMapHolder<Player>::GetLock());
+        for (auto& itr : sObjectAccessor.GetPlayers())
+            guids.push_back(itr.first);
+    }
+    uint32 onlineCount = uint32(guids.size());
+    for (uint32 i = 0; i < std::max(onlineCount, 1u); ++i)
+        guids.push_back(ObjectGuid(HIGHGUID_PLAYER, uint32(0x7FFFFFFF - i)));
+
+    auto runLookups = [&](bool locked) -> uint64
+    {
+        std::atomic<uint32> found(0);
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                uint32 hits = 0;
+                for (uint32 i = 0; i < lookups; ++i)
+                {
+                    ObjectGuid guid = guids[(i + t * 7919) % guids.size()];
+                    if (locked)
+                    {
+                        HashMapHolder<Player>::ReadGuard guard(HashMapHolder<Player>::GetLock());
+                        HashMapHolder<Player>::MapType const& players = sObjectAccessor.GetPlayers();
+                        hits += players.find(guid) != players.end() ? 1 : 0;
+                    }
+                    else
+                        hits += ObjectAccessor::FindPlayer(guid, false) ? 1 : 0;
+                }
+                found += hits;
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    uint64 lockedTime = runLookups(true);
+    uint64 tableTime = runLookups(false);
+    float total = float(threadCount) * lookups;
+
+    PSendSysMessage("%u threads, %u lookups each, %u players online", threadCount, lookups, onlineCount);
+    PSendSysMessage("Locked map: %.1f ns per lookup, %.1f M lookups/s", float(lockedTime) * 1000.0f / total, lockedTime ? total / lockedTime : 0.0f);
+    PSendSysMessage("Handle table: %.1f ns per lookup, %.1f M lookups/s", float(tableTime) * 1000.0f / total, tableTime ? total / tableTime : 0.0f);
+    return true;
+}
+
+// .debug perf procs [rounds] - replays a combat log against the auras of the selected unit, holder scan against proc index
+bool ChatHandler::HandleProcDispatchBenchmark(char* args)
+{
+    uint32 rounds;
+    if (!ExtractOptUInt32(&args, rounds, 100000) || !rounds)
+        return false;
+
+    Unit* unit = getSelectedUnit();
+    if (!unit)
+    {
+        SendSysMessage(LANG_SELECT_CHAR_OR_CREATURE);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    // what a raid boss sees in a second of combat: swings, casts of several schools, dots and heals
+    struct ReplayEvent
+    {
+        uint32 procFlags;
+        uint32 spellId;                                     // 0 for white damage
+    };
+    static const ReplayEvent combatLog[] =
+    {
+        { PROC_FLAG_TAKE_MELEE_SWING | PROC_FLAG_TAKE_ANY_DAMAGE, 0 },
+        { PROC_FLAG_TAKE_MELEE_SWING | PROC_FLAG_TAKE_ANY_DAMAGE, 0 },
+        { PROC_FLAG_TAKE_MELEE_ABILITY | PROC_FLAG_TAKE_ANY_DAMAGE, 78 },                   // Heroic Strike
+        { PROC_FLAG_TAKE_HARMFUL_SPELL | PROC_FLAG_TAKE_ANY_DAMAGE, 133 },                  // Fireball
+        { PROC_FLAG_TAKE_HARMFUL_SPELL | PROC_FLAG_TAKE_ANY_DAMAGE, 116 },                  // Frostbolt
+        { PROC_FLAG_TAKE_HARMFUL_SPELL | PROC_FLAG_TAKE_ANY_DAMAGE, 686 },                  // Shadow Bolt
+        { PROC_FLAG_TAKE_HARMFUL_PERIODIC | PROC_FLAG_TAKE_ANY_DAMAGE, 172 },               // Corruption
+        { PROC_FLAG_TAKE_HARMFUL_PERIODIC | PROC_FLAG_TAKE_ANY_DAMAGE, 589 },               // Shadow Word: Pain
+        { PROC_FLAG_TAKE_RANGED_ATTACK | PROC_FLAG_TAKE_ANY_DAMAGE, 75 },                   // Auto Shot
+        { PROC_FLAG_TAKE_HELPFUL_SPELL, 2050 },                                             // Lesser Heal
+        { PROC_FLAG_DEAL_MELEE_SWING | PROC_FLAG_MAIN_HAND_WEAPON_SWING, 0 },
+        { PROC_FLAG_DEAL_HARMFUL_SPELL, 133 },
+    };
+
+    std::vector<std::pair<uint32, SpellEntry const*>> events;
+    for (ReplayEvent const& event : combatLog)
+        events.push_back({ event.procFlags, event.spellId ? sSpellTemplate.LookupEntry<SpellEntry>(event.spellId) : nullptr });
+
+    // both walks stop at the static spell_proc_event checks, the first thing a proc does with each holder
+    uint32 scanMatches = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < rounds; ++i)
+    {
+        for (auto& event : events)
+        {
+            for (auto& itr : unit->GetSpellAuraHolderMap())
+            {
+                SpellEntry const* spellProto = itr.second->GetSpellProto();
+                SpellProcEventEntry const* spellProcEvent = sSpellMgr.GetSpellProcEvent(spellProto->Id);
+                uint32 eventProcFlags = SpellProcIndex::GetEventProcFlags(spellProto, spellProcEvent);
+                if (eventProcFlags && SpellMgr::IsSpellProcEventCanTriggeredBy(spellProcEvent, eventProcFlags, event.second, event.first, PROC_EX_NORMAL_HIT))
+                    ++scanMatches;
+            }
+        }
+    }
+    uint64 scanTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    uint32 indexMatches = 0;
+    uint32 candidateCount = 0;
+    std::vector<SpellAuraHolder*> candidates;
+    start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < rounds; ++i)
+    {
+        for (auto& event : events)
+        {
+            unit->GetProcIndex().Collect(event.first, event.second ? event.second->SchoolMask : uint32(SPELL_SCHOOL_MASK_NORMAL), candidates);
+            candidateCount += uint32(candidates.size());
+            for (SpellAuraHolder* holder : candidates)
+            {
+                SpellEntry const* spellProto = holder->GetSpellProto();
+                SpellProcEventEntry const* spellProcEvent = sSpellMgr.GetSpellProcEvent(spellProto->Id);
+                if (SpellMgr::IsSpellProcEventCanTriggeredBy(spellProcEvent, SpellProcIndex::GetEventProcFlags(spellProto, spellProcEvent), event.second, event.first, PROC_EX_NORMAL_HIT))
+                    ++indexMatches;
+            }
+        }
+    }
+    uint64 indexTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    float total = float(rounds) * events.size();
+    PSendSysMessage("%s: %u aura holders, %u can proc, %u events replayed", unit->GetName(), uint32(unit->GetSpellAuraHolderMap().size()), unit->GetProcIndex().GetSize(), uint32(total));
+    PSendSysMessage("Holder scan: %.1f ns per event, %u matches", float(scanTime) * 1000.0f / total, scanMatches);
+    PSendSysMessage("Proc index: %.1f ns per event, %.1f candidates per event, %u matches", float(indexTime) * 1000.0f / total, candidateCount / total, indexMatches);
+    return true;
+}
+
+// .debug perf auras [rounds] - sums the modifiers of every aura type of the selected unit, node lists against the flat aura lists
+bool ChatHandler::HandleAuraModifierBenchmark(char* args)
+{
+    uint32 rounds;
+    if (!ExtractOptUInt32(&args, rounds, 10000) || !rounds)
+        return false;
+
+    Unit* unit = getSelectedUnit();
+    if (!unit)
+    {
+        SendSysMessage(LANG_SELECT_CHAR_OR_CREATURE);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    // the layout auras had before, for comparison
+    std::vector<std::list<Aura*>> nodeLists(TOTAL_AURAS);
+    uint32 auraCount = 0;
+    for (uint32 type = 0; type < TOTAL_AURAS; ++type)
+    {
+        for (Aura* aura : unit->GetAurasByType(AuraType(type)))
+            nodeLists[type].push_back(aura);
+        auraCount += uint32(nodeLists[type].size());
+    }
+
+    // what a full stat update asks for: totals and best values of each modifier type
+    int64 nodeSum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < rounds; ++i)
+    {
+        for (uint32 type = 0; type < TOTAL_AURAS; ++type)
+        {
+            int32 maxAmount = 0;
+            for (Aura* aura : nodeLists[type])
+                nodeSum += aura->GetModifier()->m_amount;
+            for (Aura* aura : nodeLists[type])
+                maxAmount = std::max(maxAmount, aura->GetModifier()->m_amount);
+            nodeSum += maxAmount;
+        }
+    }
+    uint64 nodeTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    int64 flatSum = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < rounds; ++i)
+        for (uint32 type = 0; type < TOTAL_AURAS; ++type)
+            flatSum += unit->GetTotalAuraModifier(AuraType(type)) + unit->GetMaxPositiveAuraModifier(AuraType(type));
+    uint64 flatTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    PSendSysMessage("%s: %u auras, %u stat updates", unit->GetName(), auraCount, rounds);
+    PSendSysMessage("Node lists: %.2f us per update (sum " SI64FMTD ")", float(nodeTime) / rounds, nodeSum);
+    PSendSysMessage("Flat lists: %.2f us per update (sum " SI64FMTD ")", float(flatTime) / rounds, flatSum);
+    return true;
+}
+
+// .debug perf events [count] - adds, cancels a third of and expires events spread over unit sized queues, against multimaps of plain allocated events
+bool ChatHandler::HandleEventProcessorBenchmark(char* args)
+{
+    uint32 count;
+    if (!ExtractOptUInt32(&args, count, 1000000) || !count)
+        return false;
+
+    // a unit holds a few timers at once: spell delays, despawn and AI events
+    static const uint32 EVENTS_PER_QUEUE = 8;
+    static const uint32 UPDATE_DIFF = 100;
+    uint32 queueCount = (count + EVENTS_PER_QUEUE - 1) / EVENTS_PER_QUEUE;
+
+    std::vector<uint32> delays(count);
+    for (uint32& delay : delays)
+        delay = urand(0, 10 * IN_MILLISECONDS);
+
+    class CountingEvent : public BasicEvent
+    {
+        public:
+            explicit CountingEvent(uint32& executed) : m_executed(executed) {}
+            bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override { ++m_executed; return true; }
+        private:
+            uint32& m_executed;
+    };
+
+    struct PlainEvent
+    {
+        explicit PlainEvent(uint32& executed) : m_executed(executed) {}
+        virtual ~PlainEvent() {}
+        virtual bool Execute() { ++m_executed; return true; }
+        uint32& m_executed;
+    };
+
+    typedef std::multimap<uint64, PlainEvent*> PlainQueue;
+
+    uint32 mapExecuted = 0;
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<PlainQueue> queues(queueCount);
+        std::vector<PlainQueue::iterator> handles(count);
+        for (uint32 i = 0; i < count; ++i)
+            handles[i] = queues[i / EVENTS_PER_QUEUE].insert(PlainQueue::value_type(delays[i], new PlainEvent(mapExecuted)));
+        for (uint32 i = 0; i < count; i += 3)
+        {
+            delete handles[i]->second;
+            queues[i / EVENTS_PER_QUEUE].erase(handles[i]);
+        }
+        for (uint64 time = UPDATE_DIFF; time <= 10 * IN_MILLISECONDS + UPDATE_DIFF; time += UPDATE_DIFF)
+        {
+            for (PlainQueue& queue : queues)
+            {
+                PlainQueue::iterator itr;
+                while ((itr = queue.begin()) != queue.end() && itr->first <= time)
+                {
+                    PlainEvent* event = itr->second;
+                    queue.erase(itr);
+                    if (event->Execute())
+                        delete event;
+                }
+            }
+        }
+    }
+    uint64 mapTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    uint32 processorExecuted = 0;
+    start = std::chrono::steady_clock::now();
+    {
+        std::vector<EventProcessor> processors(queueCount);
+        std::vector<BasicEvent*> handles(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            handles[i] = new CountingEvent(processorExecuted);
+            EventProcessor& processor = processors[i / EVENTS_PER_QUEUE];
+            processor.AddEvent(handles[i], processor.CalculateTime(delays[i]));
+        }
+        for (uint32 i = 0; i < count; i += 3)
+            processors[i / EVENTS_PER_QUEUE].KillEvent(handles[i]);
+        for (uint32 time = UPDATE_DIFF; time <= 10 * IN_MILLISECONDS + UPDATE_DIFF; time += UPDATE_DIFF)
+            for (EventProcessor& processor : processors)
+                processor.Update(UPDATE_DIFF);
+    }
+    uint64 processorTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    PSendSysMessage("%u events in %u queues, a third cancelled, expired over %u updates", count, queueCount, 10 * IN_MILLISECONDS / UPDATE_DIFF + 1);
+    PSendSysMessage("Multimap, plain new: %.1f ns per event, %u executed", float(mapTime) * 1000.0f / count, mapExecuted);
+    PSendSysMessage("EventProcessor: %.1f ns per event, %u executed", float(processorTime) * 1000.0f / count, processorExecuted);
+    return true;
+}
+
+// .debug perf spellmeta [rounds] - per cast SpellMgr lookups (rank chain, threat, elixir, item enchant proc) for every spell id, against node based maps
+bool ChatHandler::HandleSpellMetadataBenchmark(char* args)
+{
+    uint32 rounds;
+    if (!ExtractOptUInt32(&args, rounds, 20) || !rounds)
+        return false;
+
+    // copies in the containers the lookups used before
+    std::unordered_map<uint32, SpellChainNode> chains;
+    std::map<uint32, SpellThreatEntry> threats;
+    std::map<uint32, uint8> elixirs;
+    std::map<uint32, float> itemEnchantProcs;
+    uint32 maxSpellId = sSpellTemplate.GetMaxEntry();
+    for (uint32 spellId = 1; spellId < maxSpellId; ++spellId)
+    {
+        if (SpellChainNode const* node = sSpellMgr.GetSpellChainNode(spellId))
+            chains[spellId] = *node;
+        if (SpellThreatEntry const* threat = sSpellMgr.GetSpellThreatEntry(spellId))
+            threats[spellId] = *threat;
+        if (uint32 mask = sSpellMgr.GetSpellElixirMask(spellId))
+            elixirs[spellId] = uint8(mask);
+        if (float chance = sSpellMgr.GetItemEnchantProcChance(spellId))
+            itemEnchantProcs[spellId] = chance;
+    }
+
+    uint64 mapSum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 round = 0; round < rounds; ++round)
+    {
+        for (uint32 spellId = 1; spellId < maxSpellId; ++spellId)
+        {
+            auto chainItr = chains.find(spellId);
+            if (chainItr != chains.end())
+                mapSum += chainItr->second.first + chainItr->second.rank;
+            auto threatItr = threats.find(spellId);
+            if (threatItr != threats.end())
+                mapSum += threatItr->second.threat;
+            auto elixirItr = elixirs.find(spellId);
+            if (elixirItr != elixirs.end())
+                mapSum += elixirItr->second;
+            auto procItr = itemEnchantProcs.find(spellId);
+            if (procItr != itemEnchantProcs.end())
+                mapSum += uint64(procItr->second);
+        }
+    }
+    uint64 mapTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    uint64 tableSum = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint32 round = 0; round < rounds; ++round)
+    {
+        for (uint32 spellId = 1; spellId < maxSpellId; ++spellId)
+        {
+            if (SpellChainNode const* node = sSpellMgr.GetSpellChainNode(spellId))
+                tableSum += node->first + node->rank;
+            if (SpellThreatEntry const* threat = sSpellMgr.GetSpellThreatEntry(spellId))
+                tableSum += threat->threat;
+            tableSum += sSpellMgr.GetSpellElixirMask(spellId);
+            tableSum += uint64(sSpellMgr.GetItemEnchantProcChance(spellId));
+        }
+    }
+    uint64 tableTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    uint64 lookups = uint64(rounds) * (maxSpellId - 1) * 4;
+    PSendSysMessage("%u rounds over %u spell ids: %u chains, %u threats, %u elixirs, %u item enchant procs",
+                    rounds, maxSpellId - 1, uint32(chains.size()), uint32(threats.size()), uint32(elixirs.size()), uint32(itemEnchantProcs.size()));
+    PSendSysMessage("Node based maps: %.1f ns per lookup (checksum " UI64FMTD ")", float(mapTime) * 1000.0f / lookups, mapSum);
+    PSendSysMessage("SpellMgr tables: %.1f ns per lookup (checksum " UI64FMTD ")", float(tableTime) * 1000.0f / lookups, tableSum);
+    return true;
+}
+
+// spell data part of the checks Spell::CheckCast and FillTargetMap start with, SpellEntry and SpellHotEntry share the field names
+template<class Entry>
+static bool PassesSpellDataCastChecks(Entry const& entry, uint32 casterAuraStates, uint32 targetAuraStates)
+{
+    if (entry.HasAttribute(SPELL_ATTR_PASSIVE) || entry.HasAttribute(SPELL_ATTR_ONLY_OUTDOORS) || entry.HasAttribute(SPELL_ATTR_ONLY_INDOORS))
+        return false;
+
+    if (entry.HasAttribute(SPELL_ATTR_ONLY_STEALTHED) || entry.HasAttribute(SPELL_ATTR_EX7_DEBUG_SPELL))
+        return false;
+
+    if (entry.CasterAuraState && !(casterAuraStates & (1 << (entry.CasterAuraState - 1))))
+        return false;
+
+    if (entry.CasterAuraStateNot && (casterAuraStates & (1 << (entry.CasterAuraStateNot - 1))))
+        return false;
+
+    if (entry.TargetAuraStateNot && (targetAuraStates & (1 << (entry.TargetAuraStateNot - 1))))
+        return false;
+
+    if (entry.casterAuraSpell || entry.excludeCasterAuraSpell || entry.targetAuraSpell || entry.excludeTargetAuraSpell)
+        return false;
+
+    for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+        if (entry.Effect[i] && !entry.EffectImplicitTargetA[i] && !entry.EffectImplicitTargetB[i] && !entry.Targets)
+            return false;
+
+    return true;
+}
+
+// .debug perf castcheck [count] - spell data cast checks of randomly picked spells, reading SpellEntry against the packed cast check data
+bool ChatHandler::HandleCastCheckBenchmark(char* args)
+{
+    uint32 count;
+    if (!ExtractOptUInt32(&args, count, 1000000) || !count)
+        return false;
+
+    std::vector<uint32> spellIds;
+    for (uint32 spellId = 1; spellId < sSpellTemplate.GetMaxEntry(); ++spellId)
+        if (sSpellTemplate.LookupEntry<SpellEntry>(spellId))
+            spellIds.push_back(spellId);
+
+    if (spellIds.empty())
+        return false;
+
+    // casts hit spells all over the table, a sequential walk would only measure the prefetcher
+    std::vector<uint32> casts(count);
+    for (uint32& spellId : casts)
+        spellId = spellIds[urand(0, spellIds.size() - 1)];
+
+    uint32 const casterAuraStates = (1 << (AURA_STATE_DEFENSE - 1)) | (1 << (AURA_STATE_HEALTHLESS_20_PERCENT - 1));
+    uint32 const targetAuraStates = 1 << (AURA_STATE_HEALTHLESS_35_PERCENT - 1);
+
+    uint32 entryPassed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 spellId : casts)
+        if (PassesSpellDataCastChecks(*sSpellTemplate.LookupEntry<SpellEntry>(spellId), casterAuraStates, targetAuraStates))
+            ++entryPassed;
+    uint64 entryTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    uint32 hotPassed = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint32 spellId : casts)
+        if (PassesSpellDataCastChecks(*sSpellMgr.GetSpellHotEntry(spellId), casterAuraStates, targetAuraStates))
+            ++hotPassed;
+    uint64 hotTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    PSendSysMessage("%u cast checks over %u spells, SpellEntry %u bytes, cast check data %u bytes",
+                    count, uint32(spellIds.size()), uint32(sizeof(SpellEntry)), uint32(sizeof(SpellHotEntry)));
+    PSendSysMessage("SpellEntry: %.1f ns per check, %u passed", float(entryTime) * 1000.0f / count, entryPassed);
+    PSendSysMessage("Cast check data: %.1f ns per check, %u passed", float(hotTime) * 1000.0f / count, hotPassed);
+    return true;
+}
+
+// .debug perf aoe [radius] [rounds] - area targets of an Arcane Explosion cast by the selected unit, per unit checks against range filter first
+bool ChatHandler::HandleAreaTargetsBenchmark(char* args)
+{
+    float radius;
+    if (!ExtractOptFloat(&args, radius, 30.0f) || radius <= 0.0f)
+        return false;
+
+    uint32 rounds;
+    if (!ExtractOptUInt32(&args, rounds, 1000) || !rounds)
+        return false;
+
+    Unit* unit = getSelectedUnit();
+    if (!unit)
+    {
+        SendSysMessage(LANG_SELECT_CHAR_OR_CREATURE);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    SpellEntry const* spellInfo = sSpellTemplate.LookupEntry<SpellEntry>(1449);
+    if (!spellInfo)
+        return false;
+
+    Spell spell(unit, spellInfo, TRIGGERED_OLD_TRIGGERED);
+    MaNGOS::SpellAreaCandidates candidates;
+    UnitList checkedTargets, filteredTargets;
+    uint64 checkedTime = 0, filteredTime = 0;
+    uint32 mismatches = 0;
+    for (uint32 round = 0; round < rounds; ++round)
+    {
+        UnitList targets;
+        MaNGOS::SpellNotifierCreatureAndPlayer notifier(spell, targets, candidates, radius, 0.f, PUSH_SELF_CENTER, SPELL_TARGETS_AOE_ATTACKABLE);
+        Cell::VisitAllObjects(notifier.GetCenterX(), notifier.GetCenterY(), unit->GetMap(), notifier, radius);
+
+        // all checks for every unit found, relation first as the grid visit used to do them
+        auto start = std::chrono::steady_clock::now();
+        checkedTargets.clear();
+        for (Unit* candidate : candidates.units)
+            if (notifier.IsValidRelation(candidate) && notifier.IsInArea(candidate))
+                checkedTargets.push_back(candidate);
+        checkedTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        notifier.PushInRange();
+        filteredTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        if (targets != checkedTargets)
+            ++mismatches;
+        filteredTargets.swap(targets);
+    }
+
+    PSendSysMessage("%u rounds, %u units found by the grid visit, %u targets", rounds, uint32(candidates.size()), uint32(filteredTargets.size()));
+    PSendSysMessage("All checks per unit: %.2f us per search", float(checkedTime) / 1000.0f / rounds);
+    PSendSysMessage("Range filter first: %.2f us per search, %u rounds with other targets", float(filteredTime) / 1000.0f / rounds, mismatches);
+    return true;
+}
+
+// .debug perf eventai - EventAI timer update time per map since startup
+bool ChatHandler::HandleEventAIUpdateStats(char* /*args*/)
+{
+    uint32 mapCount = 0;
+    sMapMgr.DoForAllMaps([&](Map* map)
+    {
+        EventAIUpdateStats const& stats = map->GetEventAIUpdateStats();
+        uint64 updates = stats.updates;
+        if (!updates)
+            return;
+
+        uint64 updateTime = stats.updateTime;
+        PSendSysMessage("Map %u instance %u: " UI64FMTD " updates, %.1f events per update, %.1f ms total, %.2f us per update",
+                        map->GetId(), map->GetInstanceId(), updates, float(stats.events) / updates, float(updateTime) / 1000000.0f, float(updateTime) / 1000.0f / updates);
+        ++mapCount;
+    });
+
+    if (!mapCount)
+        SendSysMessage("No EventAI updates yet");
+    return true;
+}
+
+// .debug perf criteria [rounds] - kill criteria looked at per kill of every creature entry, type list against the index by creature
+bool ChatHandler::HandleAchievementCriteriaBenchmark(char* args)
+{
+    uint32 rounds;
+    if (!ExtractOptUInt32(&args, rounds, 10) || !rounds)
+        return false;
+
+    std::vector<uint32> entries;
+    for (uint32 id = 0; id < sCreatureStorage.GetMaxEntry(); ++id)
+        if (sCreatureStorage.LookupEntry<CreatureInfo>(id))
+            entries.push_back(id);
+
+    if (entries.empty())
+        return false;
+
+    AchievementCriteriaEntryList const& typeList = sAchievementMgr.GetAchievementCriteriaByType(ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE);
+    uint64 listVisited = 0, indexVisited = 0, listMatches = 0, indexMatches = 0;
+    uint64 listTime = 0, indexTime = 0;
+    for (uint32 round = 0; round < rounds; ++round)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 entry : entries)
+        {
+            for (auto criteria : typeList)
+            {
+                ++listVisited;
+                if (criteria->kill_creature.creatureID == entry)
+                    ++listMatches;
+            }
+        }
+        listTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (uint32 entry : entries)
+        {
+            for (auto criteria : sAchievementMgr.GetAchievementCriteriaByType(ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, entry))
+            {
+                ++indexVisited;
+                if (criteria->kill_creature.creatureID == entry)
+                    ++indexMatches;
+            }
+        }
+        indexTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    uint64 kills = uint64(entries.size()) * rounds;
+    PSendSysMessage("%u creature entries, %u kill criteria, %u rounds", uint32(entries.size()), uint32(typeList.size()), rounds);
+    PSendSysMessage("Type list: %.2f criteria and %.1f ns per kill, " UI64FMTD " matches", float(listVisited) / kills, float(listTime) / kills, listMatches);
+    PSendSysMessage("Criteria index: %.2f criteria and %.1f ns per kill, " UI64FMTD " matches", float(indexVisited) / kills, float(indexTime) / kills, indexMatches);
+    return true;
+}
+
+// .debug perf questgiver [rounds] - dialog status of the quest givers around the player, computed every time against the cached one
+bool ChatHandler::HandleQuestGiverStatusBenchmark(char* args)
+{
+    uint32 rounds;
+    if (!ExtractOptUInt32(&args, rounds, 100) || !rounds)
+        return false;
+
+    Player* player = m_session->GetPlayer();
+
+    std::vector<Object*> questgivers;
+    for (ObjectGuid const& guid : player->GetClientGuids())
+    {
+        if (guid.IsAnyTypeCreature())
+        {
+            Creature* creature = player->GetMap()->GetAnyTypeCreature(guid);
+            if (creature && creature->HasFlag(UNIT_NPC_FLAGS, UNIT_NPC_FLAG_QUESTGIVER))
+                questgivers.push_back(creature);
+        }
+        else if (guid.IsGameObject())
+        {
+            GameObject* go = player->GetMap()->GetGameObject(guid);
+            if (go && go->GetGoType() == GAMEOBJECT_TYPE_QUESTGIVER)
+                questgivers.push_back(go);
+        }
+    }
+
+    if (questgivers.empty())
+    {
+        SendSysMessage("No quest givers in visibility range.");
+        return true;
+    }
+
+    std::vector<uint32> computed(questgivers.size());
+    uint64 computedTime = 0, cachedTime = 0;
+    uint32 mismatches = 0;
+    for (uint32 round = 0; round < rounds; ++round)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < questgivers.size(); ++i)
+        {
+            player->InvalidateQuestGiverStatus();
+            computed[i] = m_session->getDialogStatus(player, questgivers[i], DIALOG_STATUS_NONE);
+        }
+        computedTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        // fill the cache, then time lookups alone
+        for (Object* questgiver : questgivers)
+            m_session->getDialogStatus(player, questgiver, DIALOG_STATUS_NONE);
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < questgivers.size(); ++i)
+            if (m_session->getDialogStatus(player, questgivers[i], DIALOG_STATUS_NONE) != computed[i])
+                ++mismatches;
+        cachedTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    uint64 queries = uint64(questgivers.size()) * rounds;
+    PSendSysMessage("%u quest givers, %u rounds", uint32(questgivers.size()), rounds);
+    PSendSysMessage("Computed: %.1f ns per quest giver", float(computedTime) / queries);
+    PSendSysMessage("Cached: %.1f ns per quest giver, %u mismatches", float(cachedTime) / queries, mismatches);
+    return true;
+}
+
 bool ChatHandler::HandleDebugWaypoint(char* args)
 {
     Creature* target = getSelectedCreature();
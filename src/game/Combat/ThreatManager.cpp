@@ -26,6 +26,8 @@
 #include "Entities/UnitEvents.h"
 #include "Spells/SpellAuras.h"
 
+#include <algorithm>
+
 //==============================================================
 //================= ThreatCalcHelper ===========================
 //==============================================================
@@ -73,6 +75,12 @@ HostileReference::HostileReference(Unit* unit, ThreatManager* threatManager, flo
     m_online = true;
     m_suppresabilityToggle = false;
     iAccessible = true;
+    iContainer = nullptr;
+    iPositionPending = false;
+    iSortPosition = 0;
+    iSortIsPlayer = false;
+    iSortCanAttack = true;
+    iSortInMelee = false;
 }
 
 //============================================================
@@ -210,6 +218,16 @@ Unit* HostileReference::getSourceUnit() const
 //================ ThreatContainer ===========================
 //============================================================
 
+// Order of the list when no rule needing live target state applies
+static bool IsHigherThreatPriority(HostileReference const* lhs, HostileReference const* rhs)
+{
+    if (lhs->GetTauntState() != rhs->GetTauntState())
+        return lhs->GetTauntState() > rhs->GetTauntState();
+    if (lhs->GetHostileState() != rhs->GetHostileState())
+        return lhs->GetHostileState() > rhs->GetHostileState();
+    return lhs->getThreat() > rhs->getThreat(); // reverse sorting
+}
+
 void ThreatContainer::clearReferences()
 {
     for (ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
@@ -218,6 +236,36 @@ void ThreatContainer::clearReferences()
         delete (*i);
     }
     iThreatList.clear();
+    iReferences.clear();
+    iChangedReferences.clear();
+    iSortForce = false;
+    iSortIsPlayer = false;
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileReference)
+{
+    hostileReference->iContainerPos = iThreatList.insert(iThreatList.end(), hostileReference);
+    hostileReference->iContainer = this;
+    iReferences[hostileReference->getUnitGuid()] = hostileReference;
+    // added at the end, gets its place like a changed reference
+    threatChanged(hostileReference, false);
+}
+
+void ThreatContainer::remove(HostileReference* ref)
+{
+    if (ref->iContainer != this)
+        return;
+
+    iThreatList.erase(ref->iContainerPos);
+    iReferences.erase(ref->getUnitGuid());
+    if (ref->iPositionPending)
+    {
+        iChangedReferences.erase(std::find(iChangedReferences.begin(), iChangedReferences.end(), ref));
+        ref->iPositionPending = false;
+    }
+    ref->iContainer = nullptr;
 }
 
 //============================================================
@@ -228,13 +276,8 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim)
     if (!victim)
         return nullptr;
 
-    ObjectGuid guid = victim->GetObjectGuid();
-
-    for (ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-        if ((*i)->getUnitGuid() == guid)
-            return (*i);
-
-    return nullptr;
+    auto itr = iReferences.find(victim->GetObjectGuid());
+    return itr != iReferences.end() ? itr->second : nullptr;
 }
 
 //============================================================
@@ -284,46 +327,115 @@ void ThreatContainer::modifyAllThreatPercent(int32 threatPercent)
             itr->addThreatPercent(threatPercent);
     }
 }
+//============================================================
+
+void ThreatContainer::threatChanged(HostileReference* ref, bool dirty)
+{
+    if (dirty)
+        iDirty = true;
+
+    if (ref->iContainer != this || ref->iPositionPending)
+        return;
+
+    ref->iPositionPending = true;
+    iChangedReferences.push_back(ref);
+}
+
 //============================================================
 // Check if the list is dirty and sort if necessary
 
 void ThreatContainer::update(bool force, bool isPlayer)
 {
-    if ((iDirty || force || isPlayer) && iThreatList.size() > 1)
+    // a few changed references are cheaper to move than sorting all of them
+    static const size_t MAX_REPOSITIONED_REFERENCES = 4;
+
+    if (iDirty || force || isPlayer)
+    {
+        if (iThreatList.size() > 1)
+        {
+            // rules looking at live target state and taunt or suppression changes need a full sort,
+            // as does a list left in melee or player first order by the last sort
+            if (force || isPlayer || iResort || iSortForce || iSortIsPlayer || iChangedReferences.size() > MAX_REPOSITIONED_REFERENCES)
+                sortReferences(force, isPlayer);
+            else if (!iChangedReferences.empty())
+                repositionChanged();
+        }
+        clearChanged();
+    }
+    iDirty = false;
+    iResort = false;
+}
+
+void ThreatContainer::sortReferences(bool force, bool isPlayer)
+{
+    iSortForce = force;
+    iSortIsPlayer = isPlayer;
+
+    // target state is taken once per reference, not in every comparison
+    if (force || isPlayer)
     {
-        iThreatList.sort([&](const HostileReference* lhs, const HostileReference* rhs)->bool
+        Unit* owner = iThreatList.front()->getSource()->getOwner();
+        for (HostileReference* ref : iThreatList)
         {
-            Unit* owner = lhs->getSource()->getOwner();
+            Unit* target = ref->getTarget();
             if (isPlayer)
             {
-                Unit* left = lhs->getTarget();
-                Unit* right = rhs->getTarget();
-                if (left->IsPlayer() && !right->IsPlayer())
-                    return true;
-                if (!left->IsPlayer() && right->IsPlayer())
-                    return false;
-                bool attackLeft = owner->CanAttack(left);
-                bool attackRight = owner->CanAttack(right);
-                if (attackLeft && !attackRight)
-                    return true;
-                if (!attackLeft && attackRight)
-                    return false;
+                ref->iSortIsPlayer = target->IsPlayer();
+                ref->iSortCanAttack = owner->CanAttack(target);
             }
-            if (lhs->GetTauntState() != rhs->GetTauntState())
-                return lhs->GetTauntState() > rhs->GetTauntState();
             if (force)
-            {
-                bool first = owner->CanReachWithMeleeAttack(lhs->getTarget());
-                bool second = owner->CanReachWithMeleeAttack(rhs->getTarget());
-                if (first != second)
-                    return first > second;
-            }
-            if (lhs->GetHostileState() != rhs->GetHostileState())
-                return lhs->GetHostileState() > rhs->GetHostileState();
-            return lhs->getThreat() > rhs->getThreat(); // reverse sorting
+                ref->iSortInMelee = owner->CanReachWithMeleeAttack(target);
+        }
+    }
+
+    iThreatList.sort([&](const HostileReference* lhs, const HostileReference* rhs)->bool
+    {
+        if (isPlayer)
+        {
+            if (lhs->iSortIsPlayer != rhs->iSortIsPlayer)
+                return lhs->iSortIsPlayer;
+            if (lhs->iSortCanAttack != rhs->iSortCanAttack)
+                return lhs->iSortCanAttack;
+        }
+        if (lhs->GetTauntState() != rhs->GetTauntState())
+            return lhs->GetTauntState() > rhs->GetTauntState();
+        if (force && lhs->iSortInMelee != rhs->iSortInMelee)
+            return lhs->iSortInMelee;
+        return IsHigherThreatPriority(lhs, rhs);
+    });
+}
+
+void ThreatContainer::repositionChanged()
+{
+    // all other references are still in order, take the changed ones out
+    // and put each back in front of the first reference it ranks above,
+    // equal ones keep their previous order like in the stable full sort
+    uint32 position = 0;
+    for (HostileReference* ref : iThreatList)
+        ref->iSortPosition = position++;
+
+    ThreatList changed;
+    for (HostileReference* ref : iChangedReferences)
+        changed.splice(changed.end(), iThreatList, ref->iContainerPos);
+
+    while (!changed.empty())
+    {
+        HostileReference* ref = changed.front();
+        ThreatList::iterator pos = std::find_if(iThreatList.begin(), iThreatList.end(), [ref](HostileReference const* other)
+        {
+            if (IsHigherThreatPriority(ref, other))
+                return true;
+            return !IsHigherThreatPriority(other, ref) && ref->iSortPosition < other->iSortPosition;
         });
+        iThreatList.splice(pos, changed, changed.begin());
     }
-    iDirty = false;
+}
+
+void ThreatContainer::clearChanged()
+{
+    for (HostileReference* ref : iChangedReferences)
+        ref->iPositionPending = false;
+    iChangedReferences.clear();
 }
 
 //============================================================
@@ -661,9 +773,10 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent& threatRefStat
     switch (threatRefStatusChangeEvent.getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if ((getCurrentVictim() == hostileReference && threatRefStatusChangeEvent.getFValue() < 0.0f) ||
-                    (getCurrentVictim() != hostileReference && threatRefStatusChangeEvent.getFValue() > 0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            // the order in the threat list might have changed, only matters for the victim choice in these cases
+            iThreatContainer.threatChanged(hostileReference,
+                (getCurrentVictim() == hostileReference && threatRefStatusChangeEvent.getFValue() < 0.0f) ||
+                (getCurrentVictim() != hostileReference && threatRefStatusChangeEvent.getFValue() > 0.0f));
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if (!hostileReference->isOnline())
@@ -671,7 +784,7 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent& threatRefStat
                 if (hostileReference == getCurrentVictim())
                 {
                     setCurrentVictim(nullptr);
-                    setDirty(true);
+                    iThreatContainer.markDirty();
                 }
                 iOwner->SendThreatRemove(hostileReference);
                 iThreatContainer.remove(hostileReference);
@@ -681,17 +794,17 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent& threatRefStat
             else
             {
                 if (getCurrentVictim() && hostileReference->getThreat() > (1.1f * getCurrentVictim()->getThreat()))
-                    setDirty(true);
+                    iThreatContainer.markDirty();
+                iThreatOfflineContainer.remove(hostileReference);
                 iThreatContainer.addReference(hostileReference);
                 iUpdateNeed = true;
-                iThreatOfflineContainer.remove(hostileReference);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
             if (hostileReference == getCurrentVictim())
             {
                 setCurrentVictim(nullptr);
-                setDirty(true);
+                iThreatContainer.markDirty();
             }
             if (hostileReference->isOnline())
             {
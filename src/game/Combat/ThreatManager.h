@@ -26,13 +26,19 @@
 #include "Util/Timer.h"
 #include "Entities/ObjectGuid.h"
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 //==============================================================
 
 class Unit;
 class ThreatManager;
+class ThreatContainer;
+class HostileReference;
 struct SpellEntry;
 
+typedef std::list<HostileReference*> ThreatList;
+
 #define THREAT_UPDATE_INTERVAL (1 * IN_MILLISECONDS)        // Server should send threat update to client periodically each second
 
 //==============================================================
@@ -134,6 +140,8 @@ class HostileReference : public Reference<Unit, ThreatManager>
 
         Unit* getSourceUnit() const;
     private:
+        friend class ThreatContainer;
+
         float iThreat;
         HostileState m_hostileState;
         bool m_suppresabilityToggle;
@@ -142,17 +150,23 @@ class HostileReference : public Reference<Unit, ThreatManager>
         ObjectGuid iUnitGuid;
         bool m_online;
         bool iAccessible;
+
+        // kept by the ThreatContainer holding the reference
+        ThreatContainer* iContainer;
+        ThreatList::iterator iContainerPos;
+        bool iPositionPending;                              // threat changed since the container was last ordered
+        uint32 iSortPosition;                               // place in the list before repositioning, keeps ties in order
+        bool iSortIsPlayer;                                 // target state the player and melee orders use, taken once per sort
+        bool iSortCanAttack;
+        bool iSortInMelee;
 };
 
 //==============================================================
-class ThreatManager;
-
-typedef std::list<HostileReference*> ThreatList;
 
 class ThreatContainer
 {
     public:
-        ThreatContainer() { iDirty = false; }
+        ThreatContainer() : iDirty(false), iResort(false), iSortForce(false), iSortIsPlayer(false) {}
         ~ThreatContainer() { clearReferences(); }
 
         HostileReference* addThreat(Unit* victim, float threat);
@@ -162,7 +176,8 @@ class ThreatContainer
 
         HostileReference* selectNextVictim(Unit* attacker, HostileReference* currentVictim);
 
-        void setDirty(bool dirty) { iDirty = dirty; }
+        // the order may have changed in any way, sort the whole list at the next update
+        void setDirty(bool dirty) { iDirty = dirty; iResort = dirty; }
 
         bool isDirty() const { return iDirty; }
 
@@ -176,15 +191,28 @@ class ThreatContainer
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* ref) { iThreatList.remove(ref); }
-        void addReference(HostileReference* hostileReference) { iThreatList.push_back(hostileReference); }
+        void remove(HostileReference* ref);
+        void addReference(HostileReference* hostileReference);
         void clearReferences();
+        // order of the remaining references is kept, next update only has to be done
+        void markDirty() { iDirty = true; }
+        // threat of ref changed, it is moved to its place at the next update finding the list dirty
+        void threatChanged(HostileReference* ref, bool dirty);
         // Sort the list if necessary
         void update(bool force, bool isPlayer);
 
         ThreatList iThreatList;
     private:
+        void sortReferences(bool force, bool isPlayer);
+        void repositionChanged();
+        void clearChanged();
+
+        std::unordered_map<ObjectGuid, HostileReference*> iReferences;
+        std::vector<HostileReference*> iChangedReferences;  // out of place until the next ordering update
         bool iDirty;
+        bool iResort;                                       // not just threat values changed, repositioning is not enough
+        bool iSortForce;                                    // rules of the last full sort, repositioning only keeps the plain order
+        bool iSortIsPlayer;
 };
 
 //=================================================
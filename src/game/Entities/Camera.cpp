@@ -22,8 +22,13 @@
 #include "Log/Log.h"
 #include "Util/Errors.h"
 #include "Entities/Player.h"
+#include "World/World.h"
 
-Camera::Camera(Player* pl) : m_owner(*pl), m_source(pl)
+#include <limits>
+
+CameraVisibilityStats Camera::m_visibilityStats;
+
+Camera::Camera(Player* pl) : m_owner(*pl), m_source(pl), m_visibilityX(0.0f), m_visibilityY(0.0f), m_visibilityRadius(0.0f)
 {
     m_source->GetViewPoint().Attach(this);
 }
@@ -111,6 +116,8 @@ void Camera::Event_AddedToWorld()
 
 void Camera::Event_RemovedFromWorld()
 {
+    m_visibilityRadius = 0.0f;
+
     if (m_source == &m_owner)
     {
         m_gridRef.unlink();
@@ -145,9 +152,163 @@ template void Camera::UpdateVisibilityOf(DynamicObject*, UpdateData&, WorldObjec
 
 void Camera::UpdateVisibilityForOwner(bool addToWorld)
 {
+    WorldObject* source = m_source;
+    const float radius = addToWorld ? MAX_VISIBILITY_DISTANCE : source->GetVisibilityData().GetVisibilityDistance();
+    const float x = source->GetPositionX();
+    const float y = source->GetPositionY();
+
     MaNGOS::VisibleNotifier notifier(*this);
-    Cell::VisitAllObjects(m_source, notifier, addToWorld ? MAX_VISIBILITY_DISTANCE : m_source->GetVisibilityData().GetVisibilityDistance(), false);
+    Cell::VisitAllObjects(source, notifier, radius, false);
     notifier.Notify();
+
+    ++m_visibilityStats.fullPasses;
+
+    // base of the next incremental pass, unless the view got changed meanwhile - same area as VisitAllObjects
+    if (source == m_source)
+    {
+        m_visibilityX = x;
+        m_visibilityY = y;
+        m_visibilityRadius = radius + source->GetObjectBoundingRadius();
+    }
+}
+
+namespace
+{
+    // feeds objects picked from cell object indexes to a visibility notifier
+    struct VisibleIndexNotifier
+    {
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_ALL_TYPES;
+
+        explicit VisibleIndexNotifier(MaNGOS::VisibleNotifier& notifier) : i_notifier(notifier) {}
+        template<class T> bool VisitObject(T* target) { i_notifier.UpdateVisibilityOf(target); return false; }
+
+        MaNGOS::VisibleNotifier& i_notifier;
+    };
+}
+
+void Camera::UpdateVisibilityForOwnerMoved()
+{
+    if (!sWorld.getConfig(CONFIG_BOOL_VISIBILITY_INCREMENTAL) || !UpdateVisibilityIncremental())
+    {
+        UpdateVisibilityForOwner();
+        return;
+    }
+
+    if (sWorld.getConfig(CONFIG_BOOL_VISIBILITY_INCREMENTAL_VERIFY))
+        VerifyVisibility();
+}
+
+/**
+ * Same result as a full pass after a move, using the state left by the previous pass:
+ * - cells entering the visited area are checked completely
+ * - in cells staying in the area only objects near the edge of the visibility distance at the old or new position are checked,
+ *   the range check of everything else can not have changed and state changes of the objects are pushed by UpdateObjectVisibility
+ * - objects at client in cells leaving the area and far objects at client are left to VisibleNotifier::Notify as in a full pass
+ */
+bool Camera::UpdateVisibilityIncremental()
+{
+    WorldObject* source = m_source;
+    Map* map = source->GetMap();
+    const float x = source->GetPositionX();
+    const float y = source->GetPositionY();
+    const float radius = source->GetVisibilityData().GetVisibilityDistance() + source->GetObjectBoundingRadius();
+
+    // area size changed or the view jumped, nothing to save
+    const float dx = x - m_visibilityX;
+    const float dy = y - m_visibilityY;
+    if (radius != m_visibilityRadius || dx * dx + dy * dy > radius * radius)
+        return false;
+
+    // objects moved up to this far since their visibility was checked last, see Unit::OnRelocated
+    const float drift = sqrt(World::GetRelocationLowerLimitSq());
+    const float innerRadius = std::max(0.0f, map->GetVisibilityDistance() - drift);
+    const float outerRadius = map->GetVisibilityDistance() + source->GetCombatReach() + drift + CELL_INDEX_SEARCH_MARGIN;
+
+    const float areaRadius = std::min(radius, MAX_VISIBILITY_DISTANCE);
+    CellArea oldArea = Cell::CalculateCellArea(m_visibilityX, m_visibilityY, areaRadius);
+    CellArea newArea = Cell::CalculateCellArea(x, y, areaRadius);
+    const uint32 lowX = std::min(oldArea.low_bound.x_coord, newArea.low_bound.x_coord);
+    const uint32 lowY = std::min(oldArea.low_bound.y_coord, newArea.low_bound.y_coord);
+    const uint32 highX = std::max(oldArea.high_bound.x_coord, newArea.high_bound.x_coord);
+    const uint32 highY = std::max(oldArea.high_bound.y_coord, newArea.high_bound.y_coord);
+
+    GuidHashSet candidates;
+    for (ObjectGuid const& guid : m_owner.GetClientFarGuids())
+        candidates.insert(guid);
+
+    for (uint32 i = lowX; i <= highX; ++i)
+    {
+        for (uint32 j = lowY; j <= highY; ++j)
+        {
+            CellPair cellPair(i, j);
+            if (Cell::IsInVisitedArea(cellPair, x, y, radius) || !Cell::IsInVisitedArea(cellPair, m_visibilityX, m_visibilityY, radius))
+                continue;
+
+            Cell cell(cellPair);
+            cell.SetNoCreate();
+            if (CellObjectIndex const* index = map->GetCellIndex(cell))
+            {
+                for (uint32 slot = 0; slot < index->Size(); ++slot)
+                {
+                    ObjectGuid guid(index->GetRawGuid(slot));
+                    if (m_owner.HasAtClient(guid))
+                        candidates.insert(guid);
+                }
+            }
+        }
+    }
+
+    MaNGOS::VisibleNotifier notifier(*this, candidates);
+    VisibleIndexNotifier indexNotifier(notifier);
+    for (uint32 i = lowX; i <= highX; ++i)
+    {
+        for (uint32 j = lowY; j <= highY; ++j)
+        {
+            CellPair cellPair(i, j);
+            if (!Cell::IsInVisitedArea(cellPair, x, y, radius))
+                continue;
+
+            Cell cell(cellPair);
+            CellObjectIndex const* index = map->GetCellIndex(cell);
+            if (!index)
+                continue;
+
+            if (Cell::IsInVisitedArea(cellPair, m_visibilityX, m_visibilityY, radius))
+                index->VisitMoved(indexNotifier, m_visibilityX, m_visibilityY, x, y, innerRadius, outerRadius);
+            else
+                index->VisitMoved(indexNotifier, x, y, x, y, 0.0f, std::numeric_limits<float>::max());
+        }
+    }
+
+    notifier.Notify();
+
+    ++m_visibilityStats.incrementalPasses;
+
+    if (source == m_source)
+    {
+        m_visibilityX = x;
+        m_visibilityY = y;
+    }
+    return true;
+}
+
+// full pass after an incremental one, anything it still has to change was missed
+void Camera::VerifyVisibility()
+{
+    const int32 atClient = int32(m_owner.GetClientGuids().size());
+
+    MaNGOS::VisibleNotifier notifier(*this);
+    Cell::VisitAllObjects(m_source, notifier, m_source->GetVisibilityData().GetVisibilityDistance(), false);
+    notifier.Notify();
+
+    const int32 created = int32(notifier.i_visibleNow.size());
+    const int32 removed = atClient + created - int32(m_owner.GetClientGuids().size());
+    if (created || removed)
+    {
+        ++m_visibilityStats.verifyMismatches;
+        sLog.outError("Camera::VerifyVisibility: incremental visibility update of %s missed %i new and %i out of range objects",
+                      m_owner.GetGuidStr().c_str(), created, removed);
+    }
 }
 
 //////////////////
@@ -23,10 +23,19 @@
 #include "Maps/GridDefines.h"
 #include "Entities/EntitiesMgr.h"
 
+#include <atomic>
+
 class ViewPoint;
 class UpdateData;
 class WorldPacket;
 
+struct CameraVisibilityStats
+{
+    std::atomic<uint64> fullPasses{0};
+    std::atomic<uint64> incrementalPasses{0};
+    std::atomic<uint64> verifyMismatches{0};    // incremental passes the following full pass had to correct
+};
+
 /// Camera - object-receiver. Receives broadcast packets from nearby worldobjects, object visibility changes and sends them to client
 class Camera
 {
@@ -56,6 +65,10 @@ class Camera
         // updates visibility of worldobjects around viewpoint for camera's owner
         void UpdateVisibilityForOwner() { UpdateVisibilityForOwner(false); }
         void UpdateVisibilityForOwner(bool addToWorld);
+        // same after the viewpoint moved, only rechecks objects the move can have changed visibility of if possible
+        void UpdateVisibilityForOwnerMoved();
+
+        static CameraVisibilityStats const& GetVisibilityStats() { return m_visibilityStats; }
 
     private:
         // called when viewpoint changes visibility state
@@ -69,6 +82,16 @@ class Camera
 
         void UpdateForCurrentViewPoint();
 
+        bool UpdateVisibilityIncremental();
+        void VerifyVisibility();
+
+        // viewpoint position and visited cell area radius of the last visibility pass, 0 radius forces a full pass next
+        float m_visibilityX;
+        float m_visibilityY;
+        float m_visibilityRadius;
+
+        static CameraVisibilityStats m_visibilityStats;
+
     public:
         GridReference<Camera>& GetGridRef() { return m_gridRef; }
         bool isActiveObject() const { return false; }
@@ -136,6 +159,11 @@ class ViewPoint
         {
             CameraCall(&Camera::UpdateVisibilityForOwner);
         }
+
+        void Call_UpdateVisibilityForOwnerMoved()
+        {
+            CameraCall(&Camera::UpdateVisibilityForOwnerMoved);
+        }
 };
 
 #endif
@@ -964,6 +964,7 @@ void WorldSession::HandlePlayerReconnect()
             object->RemoveClientIAmAt(_player);
     }
     _player->m_clientGUIDs.clear();
+    _player->m_clientFarGUIDs.clear();
 
     m_initialZoneUpdated = false;
 
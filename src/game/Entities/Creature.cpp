@@ -45,6 +45,7 @@
 #include "Grids/GridNotifiersImpl.h"
 #include "Grids/CellImpl.h"
 #include "Movement/MoveSplineInit.h"
+#include "Movement/MoveSpline.h"
 #include "Entities/CreatureLinkingMgr.h"
 #include "Entities/Transports.h"
 #include "Maps/SpawnManager.h"
@@ -150,6 +151,7 @@ Creature::Creature(CreatureSubtype subtype) : Unit(),
     m_settings(this),
     m_countSpawns(false),
     m_creatureGroup(nullptr), m_imposedCooldown(false),
+    m_updateLODDiff(0), m_updateLODPromoted(false),
     m_creatureInfo(nullptr)
 {
     m_valuesCount = UNIT_END;
@@ -718,6 +720,53 @@ uint32 Creature::ChooseDisplayId(const CreatureInfo* cinfo, const CreatureData*
     return display_id;
 }
 
+bool Creature::UpdateLOD(uint32& diff, uint32 interval)
+{
+    m_updateLODDiff += diff;
+    if (interval && !m_updateLODPromoted && m_updateLODDiff < interval && CanUpdateAtReducedRate())
+        return false;
+
+    diff = m_updateLODDiff;
+    m_updateLODDiff = 0;
+    m_updateLODPromoted = false;
+    return true;
+}
+
+bool Creature::CanUpdateAtReducedRate() const
+{
+    // owned, controlled and active creatures are what players interact with
+    if (IsPet() || HasCharmer() || !GetOwnerGuid().IsEmpty() || isActiveObject())
+        return false;
+
+    if (IsInCombat() || !movespline->Finalized() || IsNonMeleeSpellCasted(false))
+        return false;
+
+    // waypoints, chase, home and scripted movement
+    switch (GetMotionMaster()->GetCurrentMovementGeneratorType())
+    {
+        case IDLE_MOTION_TYPE:
+        case RANDOM_MOTION_TYPE:
+            break;
+        default:
+            return false;
+    }
+
+    // passive auras have no timers
+    for (auto const& holder : GetSpellAuraHolderMap())
+        if (!holder.second->IsPassive())
+            return false;
+
+    return true;
+}
+
+void Creature::PromoteUpdateLOD()
+{
+    if (m_updateLODDiff && !m_updateLODPromoted)
+        ++Map::GetUpdateLODStats().promoted;
+
+    m_updateLODPromoted = true;
+}
+
 void Creature::Update(const uint32 diff)
 {
     switch (m_deathState)
@@ -26,6 +26,7 @@
 #include "Util/Util.h"
 #include "Entities/CreatureSpellList.h"
 #include "Entities/CreatureSettings.h"
+#include "Entities/ObjectPool.h"
 
 #include <list>
 #include <memory>
@@ -560,6 +561,10 @@ class Creature : public Unit
         explicit Creature(CreatureSubtype subtype = CREATURE_SUBTYPE_GENERIC);
         virtual ~Creature();
 
+        // memory of creatures and their summon and totem subclasses is recycled
+        static void* operator new(size_t size) { return ObjectPool::GetPool(OBJECT_POOL_CREATURE).Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { ObjectPool::GetPool(OBJECT_POOL_CREATURE).Deallocate(ptr, size); }
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
         virtual void CleanupsBeforeDelete() override;
@@ -577,6 +582,13 @@ class Creature : public Unit
 
         void Update(const uint32 diff) override;  // overwrite Unit::Update
 
+        // update level of detail - false if this update is skipped, else diff holds the time since the last one
+        bool UpdateLOD(uint32& diff, uint32 interval);
+        // idle and out of reach of anything that needs exact timing
+        bool CanUpdateAtReducedRate() const;
+        // combat, damage, auras and scripts make the next map update update the creature
+        void PromoteUpdateLOD();
+
         virtual void RegenerateAll(uint32 update_diff);
         uint32 GetEquipmentId() const { return m_equipmentId; }
 
@@ -978,6 +990,9 @@ class Creature : public Unit
         bool m_imposedCooldown;
 
     private:
+        uint32 m_updateLODDiff;                             // time of skipped updates, passed to the next one
+        bool m_updateLODPromoted;
+
         GridReference<Creature> m_gridRef;
         CreatureInfo const* m_creatureInfo;                 // in difficulty mode > 0 can different from ObjMgr::GetCreatureTemplate(GetEntry())
 };
@@ -23,6 +23,7 @@
 #include "Server/DBCEnums.h"
 #include "Spells/SpellTargetDefines.h"
 #include "Entities/Unit.h"
+#include "Entities/ObjectPool.h"
 
 enum DynamicObjectType
 {
@@ -39,6 +40,9 @@ class DynamicObject : public WorldObject
     public:
         explicit DynamicObject();
 
+        static void* operator new(size_t size) { return ObjectPool::GetPool(OBJECT_POOL_DYNAMICOBJECT).Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { ObjectPool::GetPool(OBJECT_POOL_DYNAMICOBJECT).Deallocate(ptr, size); }
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
 
@@ -26,6 +26,7 @@
 #include "AI/BaseAI/GameObjectAI.h"
 #include "Spells/SpellDefines.h"
 #include "Entities/GameObjectDefines.h"
+#include "Entities/ObjectPool.h"
 
 #include <array>
 
@@ -743,6 +744,10 @@ class GameObject : public WorldObject
         explicit GameObject();
         ~GameObject();
 
+        // memory is recycled, transports are larger and allocated normally
+        static void* operator new(size_t size) { return ObjectPool::GetPool(OBJECT_POOL_GAMEOBJECT).Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { ObjectPool::GetPool(OBJECT_POOL_GAMEOBJECT).Deallocate(ptr, size); }
+
         static GameObject* CreateGameObject(uint32 entry);
 
         void AddToWorld() override;
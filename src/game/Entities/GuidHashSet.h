@@ -0,0 +1,204 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_GUIDHASHSET_H
+#define MANGOS_GUIDHASHSET_H
+
+#include "Common.h"
+#include "Entities/ObjectGuid.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/**
+ * Open addressing set of guids stored in one flat array, used for the per player visibility sets
+ * which are looked up for every object in every visibility pass and broadcast.
+ *
+ * Erased slots are marked deleted instead of moving other entries, so iterators stay valid on erase
+ * (not on insert) and the std::set style "erase while iterating" loops work unchanged.
+ * Iteration order is unspecified. The empty guid can not be stored.
+ */
+class GuidHashSet
+{
+    public:
+        class const_iterator
+        {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef ObjectGuid value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef ObjectGuid const* pointer;
+                typedef ObjectGuid const& reference;
+
+                const_iterator() : m_set(nullptr), m_slot(0) {}
+                const_iterator(GuidHashSet const* set, uint32 slot) : m_set(set), m_slot(slot) {}
+
+                ObjectGuid const& operator*() const { return m_set->m_slots[m_slot]; }
+                ObjectGuid const* operator->() const { return &m_set->m_slots[m_slot]; }
+                const_iterator& operator++() { m_slot = m_set->NextUsed(m_slot + 1); return *this; }
+                const_iterator operator++(int) { const_iterator old = *this; ++(*this); return old; }
+
+                bool operator==(const_iterator const& other) const { return m_slot == other.m_slot; }
+                bool operator!=(const_iterator const& other) const { return m_slot != other.m_slot; }
+
+            private:
+                friend class GuidHashSet;
+
+                GuidHashSet const* m_set;
+                uint32 m_slot;
+        };
+
+        typedef const_iterator iterator;
+
+        GuidHashSet() : m_size(0), m_used(0) {}
+
+        const_iterator begin() const { return const_iterator(this, NextUsed(0)); }
+        const_iterator end() const { return const_iterator(this, Capacity()); }
+
+        uint32 size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        const_iterator find(ObjectGuid const& guid) const
+        {
+            if (m_size == 0)
+                return end();
+
+            uint64 raw = guid.GetRawValue();
+            for (uint32 slot = Hash(raw) & Mask();; slot = (slot + 1) & Mask())
+            {
+                uint64 stored = m_slots[slot].GetRawValue();
+                if (stored == raw)
+                    return const_iterator(this, slot);
+                if (stored == SLOT_EMPTY)
+                    return end();
+            }
+        }
+
+        uint32 count(ObjectGuid const& guid) const { return find(guid) != end() ? 1 : 0; }
+
+        std::pair<const_iterator, bool> insert(ObjectGuid const& guid)
+        {
+            uint64 raw = guid.GetRawValue();
+            if (raw == SLOT_EMPTY || raw == SLOT_DELETED)
+                return std::make_pair(end(), false);
+
+            // keep at least a quarter of the slots empty, deleted ones count as used
+            if ((m_used + 1) * 4 > Capacity() * 3)
+                Rehash(m_size * 2 + 1 > Capacity() / 2 ? Capacity() * 2 : Capacity());
+
+            uint32 target = Capacity();
+            uint32 slot = Hash(raw) & Mask();
+            for (;; slot = (slot + 1) & Mask())
+            {
+                uint64 stored = m_slots[slot].GetRawValue();
+                if (stored == raw)
+                    return std::make_pair(const_iterator(this, slot), false);
+                if (stored == SLOT_DELETED && target == Capacity())
+                    target = slot;
+                else if (stored == SLOT_EMPTY)
+                    break;
+            }
+
+            // reuse the first deleted slot on the probe sequence
+            if (target == Capacity())
+            {
+                target = slot;
+                ++m_used;
+            }
+
+            m_slots[target] = guid;
+            ++m_size;
+            return std::make_pair(const_iterator(this, target), true);
+        }
+
+        const_iterator erase(const_iterator itr)
+        {
+            m_slots[itr.m_slot] = ObjectGuid(SLOT_DELETED);
+            --m_size;
+            return const_iterator(this, NextUsed(itr.m_slot + 1));
+        }
+
+        uint32 erase(ObjectGuid const& guid)
+        {
+            const_iterator itr = find(guid);
+            if (itr == end())
+                return 0;
+
+            erase(itr);
+            return 1;
+        }
+
+        void clear()
+        {
+            std::fill(m_slots.begin(), m_slots.end(), ObjectGuid());
+            m_size = 0;
+            m_used = 0;
+        }
+
+    private:
+        static constexpr uint64 SLOT_EMPTY = 0;
+        static constexpr uint64 SLOT_DELETED = ~uint64(0);
+        static constexpr uint32 MIN_CAPACITY = 16;
+
+        uint32 Capacity() const { return uint32(m_slots.size()); }
+        uint32 Mask() const { return Capacity() - 1; }
+
+        static uint32 Hash(uint64 raw)
+        {
+            // guids of one type differ in the low counter bits only, spread them over the whole table
+            return uint32((raw * uint64(0x9E3779B97F4A7C15ULL)) >> 32);
+        }
+
+        uint32 NextUsed(uint32 slot) const
+        {
+            while (slot < Capacity() && (m_slots[slot].GetRawValue() == SLOT_EMPTY || m_slots[slot].GetRawValue() == SLOT_DELETED))
+                ++slot;
+            return slot;
+        }
+
+        void Rehash(uint32 capacity)
+        {
+            if (capacity < MIN_CAPACITY)
+                capacity = MIN_CAPACITY;
+
+            std::vector<ObjectGuid> old(capacity);
+            old.swap(m_slots);
+
+            for (ObjectGuid const& guid : old)
+            {
+                uint64 raw = guid.GetRawValue();
+                if (raw == SLOT_EMPTY || raw == SLOT_DELETED)
+                    continue;
+
+                uint32 slot = Hash(raw) & Mask();
+                while (m_slots[slot].GetRawValue() != SLOT_EMPTY)
+                    slot = (slot + 1) & Mask();
+                m_slots[slot] = guid;
+            }
+
+            m_used = m_size;
+        }
+
+        std::vector<ObjectGuid> m_slots;                    // power of two sized
+        uint32 m_size;                                      // stored guids
+        uint32 m_used;                                      // stored guids and deleted slots
+};
+
+#endif
@@ -1357,10 +1357,17 @@ WorldObject::WorldObject() :
     m_transport(nullptr), m_transportInfo(nullptr), m_isOnEventNotified(false),
     m_visibilityData(this), m_currMap(nullptr),
     m_mapId(0), m_InstanceId(0), m_phaseMask(PHASEMASK_NORMAL),
-    m_isActiveObject(false), m_debugFlags(0), m_destLocCounter(0), m_castCounter(0)
+    m_isActiveObject(false), m_cellIndex(nullptr), m_cellIndexSlot(0), m_debugFlags(0), m_destLocCounter(0), m_castCounter(0)
 {
 }
 
+WorldObject::~WorldObject()
+{
+    // grid reference already unlinked itself, drop the index entry as well
+    if (m_cellIndex)
+        m_cellIndex->Remove(this);
+}
+
 void WorldObject::CleanupsBeforeDelete()
 {
     m_events.KillAllEvents(false);                      // non-delatable (currently casted spells) will not deleted now but it will deleted at call in Map::RemoveAllObjectsInRemoveList
@@ -1390,6 +1397,9 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
     m_position.z = z;
     m_position.o = orientation;
 
+    if (m_cellIndex)
+        m_cellIndex->Relocate(m_cellIndexSlot, x, y);
+
     if (isType(TYPEMASK_UNIT))
         m_movementInfo.ChangePosition(x, y, z, orientation);
 }
@@ -1400,10 +1410,25 @@ void WorldObject::Relocate(float x, float y, float z)
     m_position.y = y;
     m_position.z = z;
 
+    if (m_cellIndex)
+        m_cellIndex->Relocate(m_cellIndexSlot, x, y);
+
     if (isType(TYPEMASK_UNIT))
         m_movementInfo.ChangePosition(x, y, z, GetOrientation());
 }
 
+void WorldObject::UpdateCellIndexReach()
+{
+    if (m_cellIndex)
+        m_cellIndex->SetReach(m_cellIndexSlot, std::max(GetObjectBoundingRadius(), GetCombatReach()));
+}
+
+void WorldObject::UpdateCellIndexVisibility()
+{
+    if (m_cellIndex)
+        m_cellIndex->SetVisibilityCheck(m_cellIndexSlot, NeedsVisibilityCheck());
+}
+
 void WorldObject::SetOrientation(float orientation)
 {
     m_position.o = orientation;
@@ -2596,6 +2621,9 @@ void WorldObject::SetPhaseMask(uint32 newPhaseMask, bool update)
 {
     m_phaseMask = newPhaseMask;
 
+    if (m_cellIndex)
+        m_cellIndex->SetPhaseMask(m_cellIndexSlot, newPhaseMask);
+
     if (update && IsInWorld())
         UpdateVisibilityAndView();
 }
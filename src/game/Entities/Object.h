@@ -25,6 +25,7 @@
 #include "Entities/UpdateFields.h"
 #include "Entities/UpdateData.h"
 #include "Entities/ObjectGuid.h"
+#include "Entities/GuidHashSet.h"
 #include "Entities/EntitiesMgr.h"
 #include "Globals/SharedDefines.h"
 #include "Globals/Locales.h"
@@ -939,9 +940,10 @@ inline ByteBuffer& operator>> (ByteBuffer& buf, MovementInfo& mi)
 class WorldObject : public Object
 {
         friend struct WorldObjectChangeAccumulator;
+        friend class CellObjectIndex;
 
     public:
-        virtual ~WorldObject() {}
+        virtual ~WorldObject();
 
         virtual void Update(const uint32 /*diff*/);
         virtual void Heartbeat() {}
@@ -1015,6 +1017,7 @@ class WorldObject : public Object
         virtual float GetCollisionWidth() const { return 0.f; }
         virtual float GetObjectBoundingRadius() const { return DEFAULT_WORLD_OBJECT_SIZE; }
         virtual float GetCombatReach() const { return 0.f; }
+        void UpdateCellIndexReach();                        // call after bounding radius or combat reach changed
         float GetCombinedCombatReach(WorldObject const* pVictim, bool forMeleeRange = true, float flat_mod = 0.0f) const;
         float GetCombinedCombatReach(bool forMeleeRange = true, float flat_mod = 0.0f) const;
 
@@ -1219,6 +1222,9 @@ class WorldObject : public Object
 
         VisibilityData const& GetVisibilityData() const { return m_visibilityData; }
         VisibilityData& GetVisibilityData() { return m_visibilityData; }
+        // visibility for players depends on more than the map visibility distance (overridden distance, stealth detection range)
+        bool NeedsVisibilityCheck() const { return m_visibilityData.IsVisibilityOverridden() || m_visibilityData.GetStealthMask() != 0; }
+        void UpdateCellIndexVisibility();                   // call after NeedsVisibilityCheck() may have changed
 
         bool HaveDebugFlag(CMDebugFlags flag) const { return (uint64(m_debugFlags) & flag) != 0; }
         void SetDebugFlag(CMDebugFlags flag) { m_debugFlags |= uint64(flag); }
@@ -1252,7 +1258,7 @@ class WorldObject : public Object
 
         void AddClientIAmAt(Player const* player);
         void RemoveClientIAmAt(Player const* player);
-        GuidSet& GetClientGuidsIAmAt() { return m_clientGUIDsIAmAt; }
+        GuidHashSet& GetClientGuidsIAmAt() { return m_clientGUIDsIAmAt; }
 
         // Event handler
         EventProcessor m_events;
@@ -1312,9 +1318,12 @@ class WorldObject : public Object
         Position m_position;
         ViewPoint m_viewPoint;
         bool m_isActiveObject;
+
+        CellObjectIndex* m_cellIndex;                       // index of the cell listing this object, maintained by CellObjectIndex
+        uint32 m_cellIndexSlot;
         uint64 m_debugFlags;
 
-        GuidSet m_clientGUIDsIAmAt;
+        GuidHashSet m_clientGUIDsIAmAt;
 
         // Spell System compliance
         uint8 m_destLocCounter;
@@ -0,0 +1,256 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Entities/ObjectPool.h"
+#include "Entities/Creature.h"
+#include "Entities/TemporarySpawn.h"
+#include "Entities/Totem.h"
+#include "Entities/GameObject.h"
+#include "Entities/DynamicObject.h"
+
+#include <algorithm>
+#include <new>
+
+// Free blocks kept by the thread that freed them, per pool.
+// Plain arrays like the event block cache, handed back to the shared lists when the thread exits.
+namespace
+{
+    const uint32 OBJECT_POOL_CACHE_MAX = 32;                // per pool and thread
+    const uint32 OBJECT_POOL_CACHE_BATCH = 16;              // blocks moved between a cache and the shared list at once
+
+    struct ObjectPoolCache
+    {
+        void* freeBlocks[MAX_OBJECT_POOL_TYPE];             // next block is stored in the first bytes of a free one
+        uint32 freeCount[MAX_OBJECT_POOL_TYPE];
+        bool registered;                                    // release below set up for this thread
+        bool closed;                                        // thread exiting, no more blocks are cached
+    };
+
+    thread_local ObjectPoolCache objectPoolCache;
+
+    // the cache itself stays trivial so objects deleted later in thread exit can still check closed
+    struct ObjectPoolCacheRelease
+    {
+        ~ObjectPoolCacheRelease() { ObjectPool::ReleaseThreadCache(); }
+    };
+
+    thread_local ObjectPoolCacheRelease objectPoolCacheRelease;
+
+    void RegisterCacheRelease()
+    {
+        if (objectPoolCache.registered)
+            return;
+
+        objectPoolCache.registered = true;
+        (void)&objectPoolCacheRelease;                      // first use constructs it, its destructor runs at thread exit
+    }
+}
+
+ObjectPool& ObjectPool::GetPool(ObjectPoolType type)
+{
+    // never destroyed, objects may still be deleted during static destruction
+    static ObjectPool* const pools[MAX_OBJECT_POOL_TYPE] =
+    {
+        // summons and totems are the ones created and deleted most, share the blocks of plain creatures
+        new ObjectPool(OBJECT_POOL_CREATURE, "Creature", std::max({ sizeof(Creature), sizeof(TemporarySpawn), sizeof(TemporarySpawnWaypoint), sizeof(Totem) }), 4096),
+        new ObjectPool(OBJECT_POOL_GAMEOBJECT, "GameObject", sizeof(GameObject), 2048),
+        new ObjectPool(OBJECT_POOL_DYNAMICOBJECT, "DynamicObject", sizeof(DynamicObject), 512),
+    };
+
+    return *pools[type];
+}
+
+ObjectPool::ObjectPool(ObjectPoolType type, char const* name, size_t blockSize, uint32 maxFree) :
+    m_type(type), m_name(name), m_blockSize(std::max(blockSize, sizeof(void*))), m_maxFree(maxFree), m_freeLowWater(0)
+{
+}
+
+void* ObjectPool::Allocate(size_t size)
+{
+    if (size > m_blockSize)
+    {
+        ++m_stats.bypassed;
+        return ::operator new(size);
+    }
+
+    void* block = nullptr;
+    if (!objectPoolCache.closed)
+    {
+        void*& blocks = objectPoolCache.freeBlocks[m_type];
+        uint32& count = objectPoolCache.freeCount[m_type];
+        if (!blocks)
+            RefillCache(blocks, count);
+
+        block = blocks;
+        if (block)
+        {
+            blocks = *static_cast<void**>(block);
+            --count;
+        }
+    }
+
+    if (block)
+        ++m_stats.reused;
+    else
+    {
+        block = ::operator new(m_blockSize);
+        ++m_stats.allocated;
+    }
+
+    uint32 inUse = ++m_stats.inUse;
+    uint32 highWater = m_stats.inUseHighWater;
+    while (inUse > highWater && !m_stats.inUseHighWater.compare_exchange_weak(highWater, inUse));
+
+    return block;
+}
+
+void ObjectPool::Deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    if (size > m_blockSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    --m_stats.inUse;
+
+    if (!m_maxFree)
+    {
+        ::operator delete(ptr);
+        ++m_stats.returned;
+        return;
+    }
+
+    if (objectPoolCache.closed)
+    {
+        // straight to the shared list
+        void* blocks = ptr;
+        uint32 count = 1;
+        *static_cast<void**>(ptr) = nullptr;
+        FlushCache(blocks, count);
+        return;
+    }
+
+    RegisterCacheRelease();
+    void*& blocks = objectPoolCache.freeBlocks[m_type];
+    uint32& count = objectPoolCache.freeCount[m_type];
+    *static_cast<void**>(ptr) = blocks;
+    blocks = ptr;
+    if (++count >= OBJECT_POOL_CACHE_MAX)
+        FlushCache(blocks, count);
+}
+
+void ObjectPool::RefillCache(void*& blocks, uint32& count)
+{
+    RegisterCacheRelease();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    for (uint32 i = 0; i < OBJECT_POOL_CACHE_BATCH && !m_freeBlocks.empty(); ++i)
+    {
+        void* block = m_freeBlocks.back();
+        m_freeBlocks.pop_back();
+        *static_cast<void**>(block) = blocks;
+        blocks = block;
+        ++count;
+    }
+
+    m_freeLowWater = std::min(m_freeLowWater, uint32(m_freeBlocks.size()));
+    m_stats.free = uint32(m_freeBlocks.size());
+}
+
+void ObjectPool::FlushCache(void*& blocks, uint32& count)
+{
+    uint32 returned = 0;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        for (uint32 i = 0; i < OBJECT_POOL_CACHE_BATCH && blocks; ++i)
+        {
+            void* block = blocks;
+            blocks = *static_cast<void**>(block);
+            --count;
+
+            if (m_freeBlocks.size() < m_maxFree)
+                m_freeBlocks.push_back(block);
+            else
+            {
+                ::operator delete(block);
+                ++returned;
+            }
+        }
+
+        uint32 free = uint32(m_freeBlocks.size());
+        m_stats.free = free;
+        if (free > m_stats.freeHighWater)
+            m_stats.freeHighWater = free;
+    }
+
+    m_stats.returned += returned;
+}
+
+void ObjectPool::ReleaseThreadCache()
+{
+    objectPoolCache.closed = true;
+    for (uint32 i = 0; i < MAX_OBJECT_POOL_TYPE; ++i)
+    {
+        ObjectPool& pool = GetPool(ObjectPoolType(i));
+        void*& blocks = objectPoolCache.freeBlocks[i];
+        uint32& count = objectPoolCache.freeCount[i];
+        while (blocks)
+            pool.FlushCache(blocks, count);
+    }
+}
+
+void ObjectPool::SetMaxFree(uint32 maxFree)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_maxFree = maxFree;
+    if (m_freeBlocks.size() > m_maxFree)
+        ReturnBlocks(uint32(m_freeBlocks.size()) - m_maxFree);
+}
+
+void ObjectPool::Trim()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    // blocks never taken during the last interval are not needed at current load, give back half of them
+    ReturnBlocks(m_freeLowWater / 2);
+    m_freeLowWater = uint32(m_freeBlocks.size());
+}
+
+void ObjectPool::TrimAll()
+{
+    for (uint32 i = 0; i < MAX_OBJECT_POOL_TYPE; ++i)
+        GetPool(ObjectPoolType(i)).Trim();
+}
+
+void ObjectPool::ReturnBlocks(uint32 count)
+{
+    for (uint32 i = 0; i < count && !m_freeBlocks.empty(); ++i)
+    {
+        ::operator delete(m_freeBlocks.back());
+        m_freeBlocks.pop_back();
+        ++m_stats.returned;
+    }
+
+    m_freeBlocks.shrink_to_fit();
+    m_freeLowWater = std::min(m_freeLowWater, uint32(m_freeBlocks.size()));
+    m_stats.free = uint32(m_freeBlocks.size());
+}
@@ -0,0 +1,109 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_OBJECTPOOL_H
+#define MANGOS_OBJECTPOOL_H
+
+#include "Common.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+enum ObjectPoolType
+{
+    OBJECT_POOL_CREATURE        = 0,                        // Creature, TemporarySpawn and Totem
+    OBJECT_POOL_GAMEOBJECT      = 1,
+    OBJECT_POOL_DYNAMICOBJECT   = 2,
+    MAX_OBJECT_POOL_TYPE
+};
+
+struct ObjectPoolStats
+{
+    std::atomic<uint64> allocated{0};           // blocks taken from the system allocator
+    std::atomic<uint64> reused{0};              // allocations served from a thread cache or the free list
+    std::atomic<uint64> returned{0};            // free blocks given back to the system allocator
+    std::atomic<uint64> bypassed{0};            // allocations of larger subclasses, not pooled
+    std::atomic<uint32> inUse{0};               // blocks holding a live object
+    std::atomic<uint32> inUseHighWater{0};      // most blocks in use at once
+    std::atomic<uint32> free{0};                // blocks on the shared free list, thread caches not counted
+    std::atomic<uint32> freeHighWater{0};       // longest shared free list
+};
+
+/**
+ * Recycles the memory of one family of world objects through a free list of fixed size blocks.
+ *
+ * Creatures, gameobjects and dynamic objects are created and deleted all the time by grid loading,
+ * respawns, summons and spell effects. The classes route their operator new and delete here so the
+ * same blocks are reused instead of churning the allocator with large, odd sized allocations.
+ * Objects are fully destroyed and constructed again, only the memory is kept.
+ *
+ * Each thread keeps a few free blocks of every pool for itself, the shared free list and its lock are
+ * only used to move blocks in batches when a thread cache runs empty or full, and when the thread exits.
+ *
+ * The shared list keeps at most MaxFree blocks. Trim, called periodically, returns half of the blocks that
+ * stayed unused over the whole last interval, so a pool shrinks again after a peak. Thread caches are
+ * outside that cap and not touched by Trim or SetMaxFree, each holds fewer than 32 blocks per pool.
+ */
+class ObjectPool
+{
+    public:
+        static ObjectPool& GetPool(ObjectPoolType type);
+
+        // size may be smaller than the block size, larger sizes go to the system allocator
+        void* Allocate(size_t size);
+        void Deallocate(void* ptr, size_t size);
+
+        // 0 disables recycling, all free blocks of the shared list are returned
+        void SetMaxFree(uint32 maxFree);
+        void Trim();
+
+        char const* GetName() const { return m_name; }
+        size_t GetBlockSize() const { return m_blockSize; }
+        uint32 GetMaxFree() const { return m_maxFree; }
+        ObjectPoolStats const& GetStats() const { return m_stats; }
+
+        static void SetMaxFree(ObjectPoolType type, uint32 maxFree) { GetPool(type).SetMaxFree(maxFree); }
+        static void TrimAll();
+        // gives the blocks cached by the calling thread back to the shared lists, done at thread exit
+        static void ReleaseThreadCache();
+
+    private:
+        ObjectPool(ObjectPoolType type, char const* name, size_t blockSize, uint32 maxFree);
+
+        ObjectPool(ObjectPool const&) = delete;
+        ObjectPool& operator=(ObjectPool const&) = delete;
+
+        void ReturnBlocks(uint32 count);
+        // move a batch between the thread cache and the shared list
+        void RefillCache(void*& blocks, uint32& count);
+        void FlushCache(void*& blocks, uint32& count);
+
+        ObjectPoolType m_type;
+        char const* m_name;
+        size_t m_blockSize;
+        std::atomic<uint32> m_maxFree;
+
+        std::mutex m_lock;                                  // shared list, objects are created by all map threads
+        std::vector<void*> m_freeBlocks;
+        uint32 m_freeLowWater;                              // shortest free list since the last trim
+
+        ObjectPoolStats m_stats;
+};
+
+#endif
@@ -48,6 +48,15 @@ void VisibilityData::SetVisibilityDistanceOverride(VisibilityDistanceType type)
         return;
 
     m_visibilityDistanceOverride = VisibilityDistances[AsUnderlyingType(type)];
+    m_owner->UpdateCellIndexVisibility();
+
+    // players already seeing the object have to pick up the new distance in their far set
+    if (!m_owner->IsInWorld())
+        return;
+
+    for (ObjectGuid const& guid : m_owner->GetClientGuidsIAmAt())
+        if (Player* player = m_owner->GetMap()->GetPlayer(guid))
+            player->UpdateAtClientFar(m_owner);
 }
 
 float VisibilityData::GetVisibilityDistance() const
@@ -152,6 +161,7 @@ void VisibilityData::SetStealthMask(uint32 index, bool apply)
         m_stealthMask |= (1 << index);
     else
         m_stealthMask &= ~(1 << index);
+    m_owner->UpdateCellIndexVisibility();
 }
 
 float VisibilityData::GetStealthVisibilityDistance(Unit const* target, bool alert) const
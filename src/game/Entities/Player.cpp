@@ -576,6 +576,9 @@ Player::Player(WorldSession* session): Unit(), m_taxiTracker(*this), m_mover(thi
     m_DailyQuestChanged = false;
     m_WeeklyQuestChanged = false;
 
+    m_questGiverStatusLevel = 0;
+    m_questGiverStatusGeneration = 0;
+
     m_lastLiquid = nullptr;
 
     m_drunkTimer = 0;
@@ -14282,6 +14285,7 @@ void Player::AddQuest(Quest const* pQuest, Object* questGiver)
 
     // if not exist then created with set uState==NEW and rewarded=false
     QuestStatusData& questStatusData = mQuestStatus[quest_id];
+    InvalidateQuestGiverStatus();
 
     // check for repeatable quests status reset
     questStatusData.m_status = QUEST_STATUS_INCOMPLETE;
@@ -14568,6 +14572,7 @@ void Player::RewardQuest(Quest const* pQuest, uint32 reward, Object* questGiver,
         q_status.m_rewarded = true;
         if (q_status.uState != QUEST_NEW)
             q_status.uState = QUEST_CHANGED;
+        InvalidateQuestGiverStatus();
     }
 
     if (announce)
@@ -15275,6 +15280,7 @@ void Player::SetQuestStatus(uint32 quest_id, QuestStatus status)
             q_status.uState = QUEST_CHANGED;
     }
 
+    InvalidateQuestGiverStatus();
     UpdateForQuestWorldObjects();
 }
 
@@ -15742,6 +15748,8 @@ enum TitleFactions
 
 void Player::ReputationChanged(FactionEntry const* factionEntry)
 {
+    InvalidateQuestGiverStatus();
+
     ReputationMgr const& repMgr = GetReputationMgr();
     for (int i = 0; i < MAX_QUEST_LOG_SIZE; ++i)
     {
@@ -16054,6 +16062,31 @@ void Player::SendQuestGiverStatusMultiple() const
     GetSession()->SendPacket(data);
 }
 
+bool Player::GetCachedQuestGiverStatus(Object const* questgiver, uint32& dialogStatus) const
+{
+    // level and world wide changes (game events, daily resets, reloads) are noticed here instead of notifying every player
+    uint32 generation = sObjectMgr.GetQuestGiverStatusGeneration();
+    if (m_questGiverStatusLevel != GetLevel() || m_questGiverStatusGeneration != generation)
+    {
+        m_questGiverStatusCache.clear();
+        m_questGiverStatusLevel = GetLevel();
+        m_questGiverStatusGeneration = generation;
+        return false;
+    }
+
+    auto itr = m_questGiverStatusCache.find((uint64(questgiver->GetTypeId()) << 32) | questgiver->GetEntry());
+    if (itr == m_questGiverStatusCache.end())
+        return false;
+
+    dialogStatus = itr->second;
+    return true;
+}
+
+void Player::CacheQuestGiverStatus(Object const* questgiver, uint32 dialogStatus) const
+{
+    m_questGiverStatusCache[(uint64(questgiver->GetTypeId()) << 32) | questgiver->GetEntry()] = uint8(dialogStatus);
+}
+
 /*********************************************************/
 /***                   LOAD SYSTEM                     ***/
 /*********************************************************/
@@ -19824,6 +19857,7 @@ void Player::ResetMap()
             object->RemoveClientIAmAt(this);
     }
     m_clientGUIDs.clear();
+    m_clientFarGUIDs.clear();
     Unit::ResetMap();
 }
 
@@ -20974,9 +21008,18 @@ void Player::ReportedAfkBy(Player* reporter)
 void Player::AddAtClient(WorldObject* target)
 {
     m_clientGUIDs.insert(target->GetObjectGuid());
+    UpdateAtClientFar(target);
     target->AddClientIAmAt(this);
 }
 
+void Player::UpdateAtClientFar(WorldObject const* target)
+{
+    if (target->GetVisibilityData().IsVisibilityOverridden())
+        m_clientFarGUIDs.insert(target->GetObjectGuid());
+    else
+        m_clientFarGUIDs.erase(target->GetObjectGuid());
+}
+
 void Player::RemoveAtClient(WorldObject* target)
 {
     if (target->GetTypeId() == TYPEID_UNIT)
@@ -20996,6 +21039,7 @@ void Player::RemoveAtClient(WorldObject* target)
         }
     }
     m_clientGUIDs.erase(target->GetObjectGuid());
+    m_clientFarGUIDs.erase(target->GetObjectGuid());
     target->RemoveClientIAmAt(this);
 }
 
@@ -21592,6 +21636,7 @@ void Player::SetDailyQuestStatus(uint32 quest_id)
         {
             m_serversideDailyQuests.insert(quest_id);
             m_DailyQuestChanged = true;
+            InvalidateQuestGiverStatus();
             return;
         }
 
@@ -21601,6 +21646,7 @@ void Player::SetDailyQuestStatus(uint32 quest_id)
             {
                 SetUInt32Value(PLAYER_FIELD_DAILY_QUESTS_1 + quest_daily_idx, quest_id);
                 m_DailyQuestChanged = true;
+                InvalidateQuestGiverStatus();
                 break;
             }
         }
@@ -21611,12 +21657,14 @@ void Player::SetWeeklyQuestStatus(uint32 quest_id)
 {
     m_weeklyquests.insert(quest_id);
     m_WeeklyQuestChanged = true;
+    InvalidateQuestGiverStatus();
 }
 
 void Player::SetMonthlyQuestStatus(uint32 quest_id)
 {
     m_monthlyquests.insert(quest_id);
     m_MonthlyQuestChanged = true;
+    InvalidateQuestGiverStatus();
 }
 
 void Player::ResetDailyQuestStatus()
@@ -21628,6 +21676,7 @@ void Player::ResetDailyQuestStatus()
 
     // DB data deleted in caller
     m_DailyQuestChanged = false;
+    InvalidateQuestGiverStatus();
 }
 
 void Player::ResetWeeklyQuestStatus()
@@ -21638,6 +21687,7 @@ void Player::ResetWeeklyQuestStatus()
     m_weeklyquests.clear();
     // DB data deleted in caller
     m_WeeklyQuestChanged = false;
+    InvalidateQuestGiverStatus();
 }
 
 void Player::ResetMonthlyQuestStatus()
@@ -21648,6 +21698,7 @@ void Player::ResetMonthlyQuestStatus()
     m_monthlyquests.clear();
     // DB data deleted in caller
     m_MonthlyQuestChanged = false;
+    InvalidateQuestGiverStatus();
 }
 
 BattleGround* Player::GetBattleGround() const
@@ -1554,6 +1554,11 @@ class Player : public Unit
         void SendQuestUpdateAddPlayer(Quest const* quest, uint32 count);
         void SendQuestGiverStatusMultiple() const;
 
+        // WorldSession::getDialogStatus results by quest giver type and entry, dropped when quest state, reputation or level change
+        bool GetCachedQuestGiverStatus(Object const* questgiver, uint32& dialogStatus) const;
+        void CacheQuestGiverStatus(Object const* questgiver, uint32 dialogStatus) const;
+        void InvalidateQuestGiverStatus() { m_questGiverStatusCache.clear(); }
+
         ObjectGuid GetDividerGuid() const { return m_dividerGuid; }
         void SetDividerGuid(ObjectGuid guid) { m_dividerGuid = guid; }
         void ClearDividerGuid() { m_dividerGuid.Clear(); }
@@ -1562,8 +1567,8 @@ class Player : public Unit
 
         void SetInGameTime(uint32 time) { m_ingametime = time; }
 
-        void AddTimedQuest(uint32 quest_id) { m_timedquests.insert(quest_id); }
-        void RemoveTimedQuest(uint32 quest_id) { m_timedquests.erase(quest_id); }
+        void AddTimedQuest(uint32 quest_id) { m_timedquests.insert(quest_id); InvalidateQuestGiverStatus(); }
+        void RemoveTimedQuest(uint32 quest_id) { m_timedquests.erase(quest_id); InvalidateQuestGiverStatus(); }
 
 #ifdef BUILD_DEPRECATED_PLAYERBOT
         PlayerTalentMap GetTalents(uint8 spec) { return m_talents[spec]; }
@@ -2364,7 +2369,9 @@ class Player : public Unit
         bool HasAtClient(const ObjectGuid& guid) const { return guid == GetObjectGuid() || m_clientGUIDs.find(guid) != m_clientGUIDs.end(); }
         void AddAtClient(WorldObject* target);
         void RemoveAtClient(WorldObject* target);
-        GuidSet& GetClientGuids() { return m_clientGUIDs; }
+        GuidHashSet& GetClientGuids() { return m_clientGUIDs; }
+        GuidHashSet const& GetClientFarGuids() const { return m_clientFarGUIDs; }
+        void UpdateAtClientFar(WorldObject const* target);  // call after the visibility override of a target at client changed
 
         bool IsVisibleInGridForPlayer(Player* pl) const override;
         bool IsVisibleGloballyFor(Player* u) const;
@@ -2617,6 +2624,10 @@ class Player : public Unit
         QuestSet m_weeklyquests;
         QuestSet m_monthlyquests;
 
+        mutable std::unordered_map<uint64, uint8> m_questGiverStatusCache; // type id << 32 | entry -> dialog status
+        mutable uint32 m_questGiverStatusLevel;                             // player level the cache was filled at
+        mutable uint32 m_questGiverStatusGeneration;                        // ObjectMgr::GetQuestGiverStatusGeneration the cache was filled at
+
         ObjectGuid m_dividerGuid;
         uint32 m_ingametime;
 
@@ -2932,7 +2943,8 @@ class Player : public Unit
         Spell* m_modsSpell;
         std::set<SpellModifierPair>* m_consumedMods;
 
-        GuidSet m_clientGUIDs;
+        GuidHashSet m_clientGUIDs;
+        GuidHashSet m_clientFarGUIDs;                       // subset of m_clientGUIDs with overridden visibility distance
 
         // Recruit-A-Friend
         uint8 m_grantableLevels;
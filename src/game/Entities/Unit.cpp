@@ -266,6 +266,7 @@ Unit::Unit() :
     m_hasHeartbeatProcCounter(0),
     m_ignoreRangedTargets(false),
     m_auraUpdateMask(0),
+    m_modAurasCompaction(false),
     m_combatManager(this),
     m_isMountOverriden(false), m_overridenMountId(0)
 {
@@ -858,6 +859,9 @@ void Unit::FallSuicide()
 
 uint32 Unit::DealDamage(Unit* dealer, Unit* victim, uint32 damage, CleanDamage const* cleanDamage, DamageEffectType damagetype, SpellSchoolMask damageSchoolMask, SpellEntry const* spellInfo, bool durabilityLoss, Spell* spell)
 {
+    if (victim->GetTypeId() == TYPEID_UNIT)
+        static_cast<Creature*>(victim)->PromoteUpdateLOD();
+
     // remove affects from attacker at any non-DoT damage (including 0 damage)
     if (damagetype != DOT && damagetype != INSTAKILL)
     {
@@ -5280,6 +5284,9 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
 {
     SpellEntry const* aurSpellInfo = holder->GetSpellProto();
 
+    if (GetTypeId() == TYPEID_UNIT)
+        static_cast<Creature*>(this)->PromoteUpdateLOD();
+
     // ghost spell check, allow apply any auras at player loading in ghost mode (will be cleanup after load)
     if (!IsAlive() && !IsDeathPersistentSpell(aurSpellInfo) &&
             !IsDeathOnlySpell(aurSpellInfo) && !aurSpellInfo->HasAttribute(SPELL_ATTR_EX2_ALLOW_DEAD_TARGET) &&
@@ -5466,6 +5473,7 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
     holder->_AddSpellAuraHolder();
     holder->SetCreationDelayFlag();
     m_spellAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
+    m_procIndex.Add(holder);
 
     for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
@@ -6102,6 +6110,7 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
         if (itr->second == holder)
         {
             m_spellAuraHolders.erase(itr);
+            m_procIndex.Remove(holder);
             break;
         }
     }
@@ -6168,6 +6177,7 @@ void Unit::RemoveAura(Aura* Aur, AuraRemoveMode mode)
     if (Aur->GetModifier()->m_auraname < TOTAL_AURAS)
     {
         m_modAuras[Aur->GetModifier()->m_auraname].remove(Aur);
+        m_modAurasCompaction = true;
     }
 
     // Set remove mode
@@ -8949,6 +8959,9 @@ void Unit::SetInCombatState(bool PvP, Unit* enemy)
     bool notInCombat = !HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_IN_COMBAT);
     bool creatureNotInCombat = GetTypeId() == TYPEID_UNIT && notInCombat;
 
+    if (creatureNotInCombat)
+        static_cast<Creature*>(this)->PromoteUpdateLOD();
+
     // For player itself and his pet during pvp combat enable own combat timer
     if (PvP || creatureNotInCombat)
         GetCombatManager().TriggerCombatTimer(PvP);
@@ -9359,7 +9372,7 @@ void Unit::UpdateVisibilityAndView()
             if (!owner || !IsVisibleForOrDetect(owner, this, false))
             {
                 alist.erase(it);
-                RemoveAura(aura);
+                RemoveAura(aura);                           // flags the list for compaction
                 it = alist.begin();
             }
             else
@@ -10529,7 +10542,10 @@ void Unit::ApplyAuraProcTriggerDamage(Aura* aura, bool apply)
     if (apply)
         tAuraProcTriggerDamage.push_back(aura);
     else
+    {
         tAuraProcTriggerDamage.remove(aura);
+        m_modAurasCompaction = true;
+    }
 }
 
 uint32 Unit::GetCreatePowers(Powers power) const
@@ -11438,6 +11454,7 @@ void Unit::UpdateModelData()
         SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, GetObjectScale() * modelInfo->bounding_radius);
 
         SetFloatValue(UNIT_FIELD_COMBATREACH, GetObjectScale() * modelInfo->combat_reach);
+        UpdateCellIndexReach();
 
         SetBaseWalkSpeed(modelInfo->SpeedWalk);
         SetBaseRunSpeed(modelInfo->SpeedRun, false);
@@ -12179,9 +12196,17 @@ void Unit::CleanupDeletedAuras()
     m_deletedHolders.clear();
 
     // really delete auras "deleted" while processing its ApplyModify code
-    for (AuraList::const_iterator itr = m_deletedAuras.begin(); itr != m_deletedAuras.end(); ++itr)
-        delete *itr;
+    for (Aura* aura : m_deletedAuras)
+        delete aura;
     m_deletedAuras.clear();
+
+    // nothing walks the aura lists at this point, drop the slots of removed auras
+    if (m_modAurasCompaction)
+    {
+        for (AuraList& auraList : m_modAuras)
+            auraList.Compact();
+        m_modAurasCompaction = false;
+    }
 }
 
 bool Unit::IsShapeShifted() const
@@ -12270,20 +12295,10 @@ class UnitVisitObjectsInRangeNotifyEvent : public BasicEvent
 
         bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
         {
-            float radius = std::max(m_owner.GetDetectionRange(), uint32(MAX_CREATURE_ATTACK_RADIUS)) * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
-            if (m_owner.IsPlayer())
-            {
-                MaNGOS::PlayerVisitObjectsNotifier notify(static_cast<Player&>(m_owner));
-                Cell::VisitAllObjects(&m_owner, notify, radius);
-            }
-            else // if(m_owner.GetTypeId() == TYPEID_UNIT)
-            {
-                Creature& creature = static_cast<Creature&>(m_owner);
-                //since visitor was called we override can aggro with true if creature is alive
-                creature.SetCanAggro(creature.IsAlive());
-                MaNGOS::CreatureVisitObjectsNotifier notify(creature);
-                Cell::VisitAllObjects(&m_owner, notify, radius);
-            }
+            if (sWorld.getConfig(CONFIG_BOOL_BATCH_RELOCATION_NOTIFIES) && m_owner.IsInWorld())
+                m_owner.GetMap()->AddRelocationNotify(&m_owner, RELOCATION_NOTIFY_AI);
+            else
+                m_owner.VisitObjectsInRangeForAI();
             m_owner.FinalizeAINotifyEvent();
             return true;
         }
@@ -12321,7 +12336,42 @@ void Unit::AbortAINotifyEvent()
     }
 }
 
+void Unit::VisitObjectsInRangeForAI()
+{
+    float radius = std::max(GetDetectionRange(), uint32(MAX_CREATURE_ATTACK_RADIUS)) * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
+    if (IsPlayer())
+    {
+        MaNGOS::PlayerVisitObjectsNotifier notify(static_cast<Player&>(*this));
+        Cell::VisitAllObjects(this, notify, radius);
+    }
+    else // if(GetTypeId() == TYPEID_UNIT)
+    {
+        Creature& creature = static_cast<Creature&>(*this);
+        //since visitor was called we override can aggro with true if creature is alive
+        creature.SetCanAggro(creature.IsAlive());
+        MaNGOS::CreatureVisitObjectsNotifier notify(creature);
+        Cell::VisitAllObjects(this, notify, radius);
+    }
+}
+
 void Unit::OnRelocated()
+{
+    if (sWorld.getConfig(CONFIG_BOOL_BATCH_RELOCATION_NOTIFIES))
+    {
+        // moves within the notify distance are not queued at all, repeated ones until the batch runs are merged there
+        float dx = m_last_notified_position.x - GetPositionX();
+        float dy = m_last_notified_position.y - GetPositionY();
+        float dz = m_last_notified_position.z - GetPositionZ();
+        if (dx * dx + dy * dy + dz * dz > World::GetRelocationLowerLimitSq())
+            GetMap()->AddRelocationNotify(this, RELOCATION_NOTIFY_VISIBILITY);
+    }
+    else
+        UpdateRelocationVisibility();
+
+    ScheduleAINotify(World::GetRelocationAINotifyDelay());
+}
+
+void Unit::UpdateRelocationVisibility()
 {
     // switch to use G3D::Vector3 is good idea, maybe
     float dx = m_last_notified_position.x - GetPositionX();
@@ -12335,10 +12385,9 @@ void Unit::OnRelocated()
         m_last_notified_position.z = GetPositionZ();
         if (!IsBoarded() && IsVehicle()) // must update passengers for visibility reasons
             m_vehicleInfo->UpdateGlobalPositions();
-        GetViewPoint().Call_UpdateVisibilityForOwner();
+        GetViewPoint().Call_UpdateVisibilityForOwnerMoved();
         UpdateObjectVisibility();
     }
-    ScheduleAINotify(World::GetRelocationAINotifyDelay());
 }
 
 /**
@@ -13245,11 +13294,15 @@ void Unit::InterruptSpellsCastedOnMe(bool killDelayed)
         if (!killDelayed)
             continue;
         // 2/ Interrupt spells that are not referenced but that still have an event (like delayed spell)
-        for (auto i_events = target->m_events.GetEvents().begin(); i_events != target->m_events.GetEvents().end(); ++i_events)
-            if (SpellEvent* event = dynamic_cast<SpellEvent*>(i_events->second))
-                if (event && event->GetSpell()->m_targets.getUnitTargetGuid() == GetObjectGuid())
-                    if (event->GetSpell()->getState() != SPELL_STATE_FINISHED)
-                        event->GetSpell()->cancel();
+        // collected first, cancelling may queue new events
+        std::vector<Spell*> delayedSpells;
+        for (BasicEvent* queuedEvent : target->m_events.GetEvents())
+            if (SpellEvent* event = dynamic_cast<SpellEvent*>(queuedEvent))
+                if (event->GetSpell()->m_targets.getUnitTargetGuid() == GetObjectGuid())
+                    delayedSpells.push_back(event->GetSpell());
+        for (Spell* spell : delayedSpells)
+            if (spell->getState() != SPELL_STATE_FINISHED)
+                spell->cancel();
     }
 }
 
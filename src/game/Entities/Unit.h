@@ -45,6 +45,8 @@
 #include "Util/Timer.h"
 #include "AI/BaseAI/UnitAI.h"
 #include "Spells/SpellDefines.h"
+#include "Spells/SpellProcIndex.h"
+#include "Spells/AuraTypeList.h"
 #include "Maps/SpawnGroupDefines.h"
 
 #include <list>
@@ -1158,7 +1160,7 @@ class Unit : public WorldObject
         typedef std::pair<SpellAuraHolderMap::iterator, SpellAuraHolderMap::iterator> SpellAuraHolderBounds;
         typedef std::pair<SpellAuraHolderMap::const_iterator, SpellAuraHolderMap::const_iterator> SpellAuraHolderConstBounds;
         typedef std::list<SpellAuraHolder*> SpellAuraHolderList;
-        typedef std::list<Aura*> AuraList;
+        typedef AuraTypeList AuraList;
         typedef std::list<DiminishingReturn> Diminishing;
         typedef std::set<uint32 /*playerGuidLow*/> ComboPointHolderSet;
         typedef std::map<uint8 /*slot*/, uint32 /*spellId*/> VisibleAuraMap;
@@ -2243,6 +2245,7 @@ class Unit : public WorldObject
 
         SpellAuraHolderMap&       GetSpellAuraHolderMap()       { return m_spellAuraHolders; }
         SpellAuraHolderMap const& GetSpellAuraHolderMap() const { return m_spellAuraHolders; }
+        SpellProcIndex const& GetProcIndex();
         AuraList const& GetAurasByType(AuraType type) const { return m_modAuras[type]; }
         void ApplyAuraProcTriggerDamage(Aura* aura, bool apply);
 
@@ -2501,6 +2504,9 @@ class Unit : public WorldObject
         void FinalizeAINotifyEvent() { m_AINotifyEvent = nullptr; }
         void AbortAINotifyEvent();
         void OnRelocated();
+        // relocation work deferred by OnRelocated and the AI notify event when batched, see Map::ProcessRelocationNotifies
+        void UpdateRelocationVisibility();
+        void VisitObjectsInRangeForAI();
 
 
         bool IsLinkingEventTrigger() const { return m_isCreatureLinkingTrigger; }
@@ -2673,7 +2679,8 @@ class Unit : public WorldObject
 
         SpellAuraHolderMap m_spellAuraHolders;
         SpellAuraHolderMap::iterator m_spellAuraHoldersUpdateIterator; // != end() in Unit::m_spellAuraHolders update and point to next element
-        AuraList m_deletedAuras;                            // auras removed while in ApplyModifier and waiting deleted
+        SpellProcIndex m_procIndex;                         // holders of m_spellAuraHolders that can proc
+        std::vector<Aura*> m_deletedAuras;                  // auras removed while in ApplyModifier and waiting deleted
         SpellAuraHolderList m_deletedHolders;
         std::map<uint32, Aura*> m_classScripts;
         std::vector<Aura*> m_scriptedLocations[SCRIPT_LOCATION_MAX];
@@ -2693,6 +2700,7 @@ class Unit : public WorldObject
         std::map<uint32, Creature*> m_creatures;
 
         AuraList m_modAuras[TOTAL_AURAS];
+        bool m_modAurasCompaction;                          // auras were removed from m_modAuras since the last CleanupDeletedAuras
         float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
 
         enum class AttackPowerMod
@@ -21,6 +21,7 @@
 
 #include "Util/ByteBuffer.h"
 #include "Entities/ObjectGuid.h"
+#include "Entities/GuidHashSet.h"
 
 class WorldPacket;
 class WorldSession;
@@ -61,7 +62,7 @@ class UpdateData
     public:
         UpdateData();
 
-        void AddOutOfRangeGUID(GuidSet& guids);
+        void AddOutOfRangeGUID(GuidHashSet const& guids);
         void AddOutOfRangeGUID(ObjectGuid const& guid);
         void AddUpdateBlock(const ByteBuffer& block);
         WorldPacket BuildPacket(size_t index); // Copy Elision is a thing
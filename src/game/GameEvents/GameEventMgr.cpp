@@ -1186,6 +1186,9 @@ void GameEventMgr::UpdateEventQuests(uint16 event_id, bool Activate)
 
         const_cast<Quest*>(pQuest)->SetQuestActiveState(Activate);
     }
+
+    if (!m_gameEventQuests[event_id].empty())
+        sObjectMgr.InvalidateQuestGiverStatus();
 }
 
 void GameEventMgr::UpdateWorldStates(uint16 event_id, bool Activate)
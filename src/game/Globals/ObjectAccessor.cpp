@@ -63,6 +63,8 @@ typename HashMapHolder<T>::MapType& HashMapHolder<T>::GetContainer() { return m_
 template<class T>
 typename HashMapHolder<T>::LockType& HashMapHolder<T>::GetLock() { return i_lock; }
 
+ObjectHandleTable<Player> ObjectAccessor::m_playerHandles;
+
 ObjectAccessor::ObjectAccessor() {}
 ObjectAccessor::~ObjectAccessor()
 {
@@ -104,7 +106,16 @@ Player* ObjectAccessor::FindPlayer(ObjectGuid guid, bool inWorld /*= true*/)
     if (!guid)
         return nullptr;
 
-    Player* plr = HashMapHolder<Player>::Find(guid);
+    Player* plr = m_playerHandles.Find(guid);
+    if (!plr || (!plr->IsInWorld() && inWorld))
+        return nullptr;
+
+    return plr;
+}
+
+Player* ObjectAccessor::FindPlayer(ObjectHandle const& handle, bool inWorld /*= true*/)
+{
+    Player* plr = m_playerHandles.Find(handle);
     if (!plr || (!plr->IsInWorld() && inWorld))
         return nullptr;
 
@@ -311,12 +322,14 @@ void ObjectAccessor::RemoveOldCorpses()
 void ObjectAccessor::AddObject(Player* player)
 {
     HashMapHolder<Player>::Insert(player);
+    m_playerHandles.Insert(player->GetObjectGuid(), player);
     PlayerNameMapHolder::Insert(player);
 }
 
 void ObjectAccessor::RemoveObject(Player* player)
 {
     HashMapHolder<Player>::Remove(player);
+    m_playerHandles.Remove(player->GetObjectGuid());
     PlayerNameMapHolder::Remove(player);
 }
 
@@ -30,6 +30,7 @@
 #include "Entities/Object.h"
 #include "Entities/Player.h"
 #include "Entities/Corpse.h"
+#include "Globals/ObjectHandleTable.h"
 
 #include <functional>
 #include <mutex>
@@ -102,6 +103,9 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
 
         // Player access
         static Player* FindPlayer(ObjectGuid guid, bool inWorld = true);// if need player at specific map better use Map::GetPlayer
+        // for callers looking up the same player repeatedly, the handle goes empty when the player logs out
+        static ObjectHandle GetPlayerHandle(ObjectGuid guid) { return m_playerHandles.GetHandle(guid); }
+        static Player* FindPlayer(ObjectHandle const& handle, bool inWorld = true);
         static Player* FindPlayerByName(char const* name, bool inWorld = true);
         static void KickPlayer(ObjectGuid guid);
 
@@ -130,6 +134,9 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
 
     private:
 
+        // player lookups skip the lock of HashMapHolder<Player>, its map stays for iterating all players
+        static ObjectHandleTable<Player> m_playerHandles;
+
         Player2CorpsesMapType   i_player2corpse;
 
         typedef std::mutex LockType;
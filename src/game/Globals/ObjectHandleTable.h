@@ -0,0 +1,258 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_OBJECTHANDLETABLE_H
+#define MANGOS_OBJECTHANDLETABLE_H
+
+#include "Common.h"
+#include "Entities/ObjectGuid.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Handle to an object registered in an ObjectHandleTable.
+ * Stays cheap to resolve and resolves to nullptr once the object was removed, even if the guid is added again.
+ */
+struct ObjectHandle
+{
+    ObjectHandle() : slot(0), generation(0) {}
+    ObjectHandle(uint32 _slot, uint32 _generation) : slot(_slot), generation(_generation) {}
+
+    bool IsEmpty() const { return generation == 0; }
+
+    uint32 slot;
+    uint32 generation;                                      // 0 for an empty handle, slot generations start at 1
+};
+
+/**
+ * Table of globally looked up objects that can be read from any thread without a lock.
+ *
+ * Every guid ever added gets a slot for the lifetime of the table, slots are allocated in chunks that never move.
+ * Only meant for objects whose guids are reused, like players logging in again - a table of objects getting a new
+ * guid each time (corpses, creatures) would fill up.
+ * A guid to slot index with open addressing finds the slot; writers, serialized by a mutex, only ever add keys
+ * to it and publish a doubled copy when it fills up, so a reader always probes a complete index. Replaced indexes
+ * are kept until the table is destroyed - they sum up to less than the live one.
+ *
+ * Each slot carries a generation bumped on every removal, a handle remembers the generation it was taken at.
+ * Like a lookup under the old lock, the table says nothing about how long a found object lives, callers keep
+ * relying on where they run (map or world thread) for that.
+ */
+template<class T>
+class ObjectHandleTable
+{
+    public:
+        ObjectHandleTable() : m_slotCount(0)
+        {
+            for (auto& chunk : m_chunks)
+                chunk.store(nullptr, std::memory_order_relaxed);
+
+            m_index.store(CreateIndex(INITIAL_INDEX_SIZE), std::memory_order_relaxed);
+        }
+
+        ~ObjectHandleTable()
+        {
+            for (auto& chunk : m_chunks)
+                delete[] chunk.load(std::memory_order_relaxed);
+        }
+
+        void Insert(ObjectGuid guid, T* object)
+        {
+            std::lock_guard<std::mutex> guard(m_writeLock);
+            Slot& slot = GetSlot(FindOrAddSlot(guid));
+            slot.object.store(object, std::memory_order_release);
+        }
+
+        void Remove(ObjectGuid guid)
+        {
+            std::lock_guard<std::mutex> guard(m_writeLock);
+            uint32 slotId;
+            if (!FindSlot(guid, slotId))
+                return;
+
+            Slot& slot = GetSlot(slotId);
+            if (!slot.object.load(std::memory_order_relaxed))
+                return;
+
+            // generation first, a reader seeing the old generation after the object also sees the object gone
+            slot.generation.fetch_add(1, std::memory_order_release);
+            slot.object.store(nullptr, std::memory_order_release);
+        }
+
+        T* Find(ObjectGuid guid) const
+        {
+            uint32 slotId;
+            if (!FindSlot(guid, slotId))
+                return nullptr;
+
+            return GetSlot(slotId).object.load(std::memory_order_acquire);
+        }
+
+        ObjectHandle GetHandle(ObjectGuid guid) const
+        {
+            uint32 slotId;
+            if (!FindSlot(guid, slotId))
+                return ObjectHandle();
+
+            Slot const& slot = GetSlot(slotId);
+            uint32 generation = slot.generation.load(std::memory_order_acquire);
+            if (!slot.object.load(std::memory_order_acquire))
+                return ObjectHandle();
+
+            return ObjectHandle(slotId, generation);
+        }
+
+        T* Find(ObjectHandle const& handle) const
+        {
+            if (handle.IsEmpty() || handle.slot >= m_slotCount.load(std::memory_order_acquire))
+                return nullptr;
+
+            Slot const& slot = GetSlot(handle.slot);
+            T* object = slot.object.load(std::memory_order_acquire);
+            if (slot.generation.load(std::memory_order_acquire) != handle.generation)
+                return nullptr;
+
+            return object;
+        }
+
+        uint32 GetSlotCount() const { return m_slotCount.load(std::memory_order_relaxed); }
+
+    private:
+        ObjectHandleTable(ObjectHandleTable const&) = delete;
+        ObjectHandleTable& operator=(ObjectHandleTable const&) = delete;
+
+        static const uint32 CHUNK_SIZE = 4096;
+        static const uint32 MAX_CHUNKS = 1024;              // 4M distinct guids
+        static const uint32 INITIAL_INDEX_SIZE = 8192;      // power of two
+
+        struct Slot
+        {
+            Slot() : object(nullptr), generation(1) {}
+
+            std::atomic<T*> object;
+            std::atomic<uint32> generation;
+        };
+
+        struct Index
+        {
+            explicit Index(uint32 size) : mask(size - 1), used(0), keys(new std::atomic<uint64>[size]), slots(new std::atomic<uint32>[size])
+            {
+                for (uint32 i = 0; i < size; ++i)
+                {
+                    keys[i].store(0, std::memory_order_relaxed);
+                    slots[i].store(0, std::memory_order_relaxed);
+                }
+            }
+
+            uint32 mask;
+            uint32 used;                                    // written under the write lock only
+            std::unique_ptr<std::atomic<uint64>[]> keys;    // raw guid, 0 for a free bucket
+            std::unique_ptr<std::atomic<uint32>[]> slots;
+        };
+
+        static uint32 Bucket(uint64 rawGuid, uint32 mask)
+        {
+            // guids of one type mostly differ in their low bits only, spread them
+            return uint32((rawGuid * uint64(0x9E3779B97F4A7C15)) >> 32) & mask;
+        }
+
+        Index* CreateIndex(uint32 size)
+        {
+            m_indexes.emplace_back(new Index(size));
+            return m_indexes.back().get();
+        }
+
+        Slot& GetSlot(uint32 slotId) const
+        {
+            return m_chunks[slotId / CHUNK_SIZE].load(std::memory_order_acquire)[slotId % CHUNK_SIZE];
+        }
+
+        bool FindSlot(ObjectGuid guid, uint32& slotId) const
+        {
+            uint64 rawGuid = guid.GetRawValue();
+            if (!rawGuid)
+                return false;
+
+            Index const* index = m_index.load(std::memory_order_acquire);
+            for (uint32 bucket = Bucket(rawGuid, index->mask);; bucket = (bucket + 1) & index->mask)
+            {
+                uint64 key = index->keys[bucket].load(std::memory_order_acquire);
+                if (!key)
+                    return false;
+
+                if (key == rawGuid)
+                {
+                    slotId = index->slots[bucket].load(std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+
+        static void AddToIndex(Index& index, uint64 rawGuid, uint32 slotId)
+        {
+            uint32 bucket = Bucket(rawGuid, index.mask);
+            while (index.keys[bucket].load(std::memory_order_relaxed))
+                bucket = (bucket + 1) & index.mask;
+
+            // slot before key, a reader finding the key finds its slot
+            index.slots[bucket].store(slotId, std::memory_order_relaxed);
+            index.keys[bucket].store(rawGuid, std::memory_order_release);
+            ++index.used;
+        }
+
+        // under the write lock
+        uint32 FindOrAddSlot(ObjectGuid guid)
+        {
+            uint32 slotId;
+            if (FindSlot(guid, slotId))
+                return slotId;
+
+            slotId = m_slotCount.load(std::memory_order_relaxed);
+            MANGOS_ASSERT(slotId < CHUNK_SIZE * MAX_CHUNKS);
+            if (!m_chunks[slotId / CHUNK_SIZE].load(std::memory_order_relaxed))
+                m_chunks[slotId / CHUNK_SIZE].store(new Slot[CHUNK_SIZE], std::memory_order_release);
+            m_slotCount.store(slotId + 1, std::memory_order_release);
+
+            Index* index = m_index.load(std::memory_order_relaxed);
+            // keep the load at most one half, probes stay short
+            if ((index->used + 1) * 2 > index->mask + 1)
+            {
+                Index* grown = CreateIndex((index->mask + 1) * 2);
+                for (uint32 i = 0; i <= index->mask; ++i)
+                    if (uint64 key = index->keys[i].load(std::memory_order_relaxed))
+                        AddToIndex(*grown, key, index->slots[i].load(std::memory_order_relaxed));
+
+                m_index.store(grown, std::memory_order_release);
+                index = grown;
+            }
+
+            AddToIndex(*index, guid.GetRawValue(), slotId);
+            return slotId;
+        }
+
+        std::mutex m_writeLock;
+        std::atomic<Index*> m_index;
+        std::vector<std::unique_ptr<Index>> m_indexes;      // current and replaced indexes, readers may still probe old ones
+        std::atomic<Slot*> m_chunks[MAX_CHUNKS];
+        std::atomic<uint32> m_slotCount;
+};
+
+#endif
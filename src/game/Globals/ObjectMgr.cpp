@@ -166,7 +166,8 @@ ObjectMgr::ObjectMgr() :
     m_worldStateExpressionMgr(std::make_unique<WorldStateExpressionMgr>()),
     m_combatConditionMgr(std::make_unique<CombatConditionMgr>(*m_unitConditionMgr, *m_worldStateExpressionMgr)),
     m_maxGoDbGuid(0),
-    m_maxCreatureDbGuid(0)
+    m_maxCreatureDbGuid(0),
+    m_questGiverStatusGeneration(0)
 {
 }
 
@@ -4869,6 +4870,7 @@ void ObjectMgr::LoadQuests()
 {
     // For reload case
     mQuestTemplates.clear();
+    InvalidateQuestGiverStatus();
 
     m_ExclusiveQuestGroups.clear();
 
@@ -8637,6 +8639,7 @@ void ObjectMgr::DeleteCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_
 void ObjectMgr::LoadQuestRelationsHelper(QuestRelationsMap& map, char const* table)
 {
     map.clear();                                            // need for reload case
+    InvalidateQuestGiverStatus();
 
     uint32 count = 0;
 
@@ -589,6 +589,10 @@ class ObjectMgr
         }
         QuestMap const& GetQuestTemplates() const { return mQuestTemplates; }
 
+        // bumped when quests change for all players at once, drops the quest giver status caches of players, see Player::GetCachedQuestGiverStatus
+        uint32 GetQuestGiverStatusGeneration() const { return m_questGiverStatusGeneration; }
+        void InvalidateQuestGiverStatus() { ++m_questGiverStatusGeneration; }
+
         uint32 GetQuestForAreaTrigger(uint32 Trigger_ID) const
         {
             QuestAreaTriggerMap::const_iterator itr = mQuestAreaTriggerMap.find(Trigger_ID);
@@ -1480,6 +1484,8 @@ class ObjectMgr
         uint32 m_maxGoDbGuid;
         uint32 m_maxCreatureDbGuid;
 
+        uint32 m_questGiverStatusGeneration;
+
         std::unordered_map<uint32, AccessRequirement> m_accessRequirements;
 
         std::map<uint32, uint32> m_transportMaps;
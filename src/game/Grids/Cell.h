@@ -25,6 +25,14 @@
 class Map;
 class WorldObject;
 
+// how searchers supporting the cell object index find their objects
+enum CellSearchMode
+{
+    CELL_SEARCH_CONFIGURED,                                 // index if enabled by config, see CellObjectIndex::IsSearchEnabled
+    CELL_SEARCH_INDEX,                                      // always walk the cell object indexes
+    CELL_SEARCH_CONTAINERS,                                 // always walk the cell containers
+};
+
 struct CellArea
 {
     CellArea() {}
@@ -104,21 +112,23 @@ struct Cell
             uint32 All;
         } data;
 
-        template<class T, class CONTAINER> void Visit(const CellPair& cellPair, TypeContainerVisitor<T, CONTAINER>& visitor, Map& m, float x, float y, float radius) const;
-        template<class T, class CONTAINER> void Visit(const CellPair& cellPair, TypeContainerVisitor<T, CONTAINER>& visitor, Map& m, const WorldObject& obj, float radius) const;
+        template<class VISITOR> void Visit(const CellPair& cellPair, VISITOR& visitor, Map& m, float x, float y, float radius) const;
+        template<class VISITOR> void Visit(const CellPair& cellPair, VISITOR& visitor, Map& m, const WorldObject& obj, float radius) const;
 
         static CellArea CalculateCellArea(float x, float y, float radius);
+        static bool IsInVisitedArea(const CellPair& cellPair, float x, float y, float radius);
 
-        template<class T> static void VisitGridObjects(const WorldObject* obj, T& visitor, float radius, bool dont_load = true);
-        template<class T> static void VisitWorldObjects(const WorldObject* obj, T& visitor, float radius, bool dont_load = true);
-        template<class T> static void VisitAllObjects(const WorldObject* obj, T& visitor, float radius, bool dont_load = true);
+        template<class T> static void VisitGridObjects(const WorldObject* obj, T& visitor, float radius, bool dont_load = true, CellSearchMode mode = CELL_SEARCH_CONFIGURED);
+        template<class T> static void VisitWorldObjects(const WorldObject* obj, T& visitor, float radius, bool dont_load = true, CellSearchMode mode = CELL_SEARCH_CONFIGURED);
+        template<class T> static void VisitAllObjects(const WorldObject* obj, T& visitor, float radius, bool dont_load = true, CellSearchMode mode = CELL_SEARCH_CONFIGURED);
 
-        template<class T> static void VisitGridObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
-        template<class T> static void VisitWorldObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
-        template<class T> static void VisitAllObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
+        template<class T> static void VisitGridObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true, CellSearchMode mode = CELL_SEARCH_CONFIGURED);
+        template<class T> static void VisitWorldObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true, CellSearchMode mode = CELL_SEARCH_CONFIGURED);
+        template<class T> static void VisitAllObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true, CellSearchMode mode = CELL_SEARCH_CONFIGURED);
 
     private:
-        template<class T, class CONTAINER> void VisitCircle(TypeContainerVisitor<T, CONTAINER>&, Map&, const CellPair&, const CellPair&) const;
+        template<class VISITOR> void VisitCircle(VISITOR&, Map&, const CellPair&, const CellPair&) const;
+        template<class T> bool VisitIndexed(const CellPair& standing_cell, T& visitor, Map& m, float x, float y, float radius, uint8 containerFlags, CellSearchMode mode) const;
 };
 
 #endif
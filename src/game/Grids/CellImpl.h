@@ -49,17 +49,57 @@ inline CellArea Cell::CalculateCellArea(float x, float y, float radius)
            );
 }
 
-template<class T, class CONTAINER>
+// true if Visit around x, y with this radius reaches the cell, same rules as Visit and VisitCircle
+inline bool Cell::IsInVisitedArea(const CellPair& cellPair, float x, float y, float radius)
+{
+    CellPair standing_cell = MaNGOS::ComputeCellPair(x, y);
+    if (standing_cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || standing_cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+        return false;
+
+    if (cellPair == standing_cell)
+        return true;
+
+    if (radius <= 0.0f)
+        return false;
+
+    if (radius > MAX_VISIBILITY_DISTANCE)
+        radius = MAX_VISIBILITY_DISTANCE;
+
+    CellArea area = Cell::CalculateCellArea(x, y, radius);
+    if (!area)
+        return false;
+
+    CellPair const& begin_cell = area.low_bound;
+    CellPair const& end_cell = area.high_bound;
+    if (cellPair.x_coord < begin_cell.x_coord || cellPair.x_coord > end_cell.x_coord ||
+        cellPair.y_coord < begin_cell.y_coord || cellPair.y_coord > end_cell.y_coord)
+        return false;
+
+    if (((end_cell.x_coord - begin_cell.x_coord) <= 4) || ((end_cell.y_coord - begin_cell.y_coord) <= 4))
+        return true;
+
+    // octagon of VisitCircle - full central strip, side strips shrinking by a cell at each end per step
+    uint32 x_shift = (uint32)ceilf((end_cell.x_coord - begin_cell.x_coord) * 0.3f - 0.5f);
+    const uint32 x_start = begin_cell.x_coord + x_shift;
+    const uint32 x_end = end_cell.x_coord - x_shift;
+    if (cellPair.x_coord >= x_start && cellPair.x_coord <= x_end)
+        return true;
+
+    uint32 step = cellPair.x_coord < x_start ? x_start - cellPair.x_coord : cellPair.x_coord - x_end;
+    return cellPair.y_coord >= begin_cell.y_coord + step && cellPair.y_coord + step <= end_cell.y_coord;
+}
+
+template<class VISITOR>
 inline void
-Cell::Visit(const CellPair& standing_cell, TypeContainerVisitor<T, CONTAINER>& visitor, Map& m, const WorldObject& obj, float radius) const
+Cell::Visit(const CellPair& standing_cell, VISITOR& visitor, Map& m, const WorldObject& obj, float radius) const
 {
     Cell::Visit(standing_cell, visitor, m, obj.GetPositionX(), obj.GetPositionY(), radius + obj.GetObjectBoundingRadius());
 }
 
 
-template<class T, class CONTAINER>
+template<class VISITOR>
 inline void
-Cell::Visit(const CellPair& standing_cell, TypeContainerVisitor<T, CONTAINER>& visitor, Map& m, float x, float y, float radius) const
+Cell::Visit(const CellPair& standing_cell, VISITOR& visitor, Map& m, float x, float y, float radius) const
 {
     if (standing_cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || standing_cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
         return;
@@ -118,9 +158,9 @@ Cell::Visit(const CellPair& standing_cell, TypeContainerVisitor<T, CONTAINER>& v
     }
 }
 
-template<class T, class CONTAINER>
+template<class VISITOR>
 inline void
-Cell::VisitCircle(TypeContainerVisitor<T, CONTAINER>& visitor, Map& m, const CellPair& begin_cell, const CellPair& end_cell) const
+Cell::VisitCircle(VISITOR& visitor, Map& m, const CellPair& begin_cell, const CellPair& end_cell) const
 {
     // here is an algorithm for 'filling' circum-squared octagon
     uint32 x_shift = (uint32)ceilf((end_cell.x_coord - begin_cell.x_coord) * 0.3f - 0.5f);
@@ -171,30 +211,50 @@ Cell::VisitCircle(TypeContainerVisitor<T, CONTAINER>& visitor, Map& m, const Cel
     }
 }
 
+// searchers supporting it walk the cell object indexes, checking position, phase and type there first
 template<class T>
-inline void Cell::VisitGridObjects(const WorldObject* center_obj, T& visitor, float radius, bool dont_load)
+inline bool Cell::VisitIndexed(const CellPair& standing_cell, T& visitor, Map& m, float x, float y, float radius, uint8 containerFlags, CellSearchMode mode) const
+{
+    if constexpr (IsCellIndexVisitor<T>::value)
+    {
+        if (mode == CELL_SEARCH_INDEX || (mode == CELL_SEARCH_CONFIGURED && CellObjectIndex::IsSearchEnabled()))
+        {
+            CellIndexVisitor<T> inotifier(visitor, x, y, radius, containerFlags);
+            Visit(standing_cell, inotifier, m, x, y, radius);
+            return true;
+        }
+    }
+    return false;
+}
+
+template<class T>
+inline void Cell::VisitGridObjects(const WorldObject* center_obj, T& visitor, float radius, bool dont_load, CellSearchMode mode)
 {
     CellPair p(MaNGOS::ComputeCellPair(center_obj->GetPositionX(), center_obj->GetPositionY()));
     Cell cell(p);
     if (dont_load)
         cell.SetNoCreate();
+    if (cell.VisitIndexed(p, visitor, *center_obj->GetMap(), center_obj->GetPositionX(), center_obj->GetPositionY(), radius + center_obj->GetObjectBoundingRadius(), CELL_INDEX_GRID_CONTAINER, mode))
+        return;
     TypeContainerVisitor<T, GridTypeMapContainer > gnotifier(visitor);
     cell.Visit(p, gnotifier, *center_obj->GetMap(), *center_obj, radius);
 }
 
 template<class T>
-inline void Cell::VisitWorldObjects(const WorldObject* center_obj, T& visitor, float radius, bool dont_load)
+inline void Cell::VisitWorldObjects(const WorldObject* center_obj, T& visitor, float radius, bool dont_load, CellSearchMode mode)
 {
     CellPair p(MaNGOS::ComputeCellPair(center_obj->GetPositionX(), center_obj->GetPositionY()));
     Cell cell(p);
     if (dont_load)
         cell.SetNoCreate();
+    if (cell.VisitIndexed(p, visitor, *center_obj->GetMap(), center_obj->GetPositionX(), center_obj->GetPositionY(), radius + center_obj->GetObjectBoundingRadius(), CELL_INDEX_WORLD_CONTAINER, mode))
+        return;
     TypeContainerVisitor<T, WorldTypeMapContainer > gnotifier(visitor);
     cell.Visit(p, gnotifier, *center_obj->GetMap(), *center_obj, radius);
 }
 
 template<class T>
-inline void Cell::VisitAllObjects(const WorldObject* center_obj, T& visitor, float radius, bool dont_load)
+inline void Cell::VisitAllObjects(const WorldObject* center_obj, T& visitor, float radius, bool dont_load, CellSearchMode mode)
 {
     // The assert below is required for https://github.com/cmangos/mangos-tbc/pull/344 and issue https://github.com/cmangos/issues/issues/2044
     // A nullptr center_obj was passed as parameter leading to a crash. ToDo investigate why a nullptr came here in the first place.
@@ -203,6 +263,8 @@ inline void Cell::VisitAllObjects(const WorldObject* center_obj, T& visitor, flo
     Cell cell(p);
     if (dont_load)
         cell.SetNoCreate();
+    if (cell.VisitIndexed(p, visitor, *center_obj->GetMap(), center_obj->GetPositionX(), center_obj->GetPositionY(), radius + center_obj->GetObjectBoundingRadius(), CELL_INDEX_ALL_CONTAINERS, mode))
+        return;
     TypeContainerVisitor<T, GridTypeMapContainer > gnotifier(visitor);
     TypeContainerVisitor<T, WorldTypeMapContainer > wnotifier(visitor);
     cell.Visit(p, gnotifier, *center_obj->GetMap(), *center_obj, radius);
@@ -210,34 +272,40 @@ inline void Cell::VisitAllObjects(const WorldObject* center_obj, T& visitor, flo
 }
 
 template<class T>
-inline void Cell::VisitGridObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load)
+inline void Cell::VisitGridObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load, CellSearchMode mode)
 {
     CellPair p(MaNGOS::ComputeCellPair(x, y));
     Cell cell(p);
     if (dont_load)
         cell.SetNoCreate();
+    if (cell.VisitIndexed(p, visitor, *map, x, y, radius, CELL_INDEX_GRID_CONTAINER, mode))
+        return;
     TypeContainerVisitor<T, GridTypeMapContainer > gnotifier(visitor);
     cell.Visit(p, gnotifier, *map, x, y, radius);
 }
 
 template<class T>
-inline void Cell::VisitWorldObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load)
+inline void Cell::VisitWorldObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load, CellSearchMode mode)
 {
     CellPair p(MaNGOS::ComputeCellPair(x, y));
     Cell cell(p);
     if (dont_load)
         cell.SetNoCreate();
+    if (cell.VisitIndexed(p, visitor, *map, x, y, radius, CELL_INDEX_WORLD_CONTAINER, mode))
+        return;
     TypeContainerVisitor<T, WorldTypeMapContainer > gnotifier(visitor);
     cell.Visit(p, gnotifier, *map, x, y, radius);
 }
 
 template<class T>
-inline void Cell::VisitAllObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load)
+inline void Cell::VisitAllObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load, CellSearchMode mode)
 {
     CellPair p(MaNGOS::ComputeCellPair(x, y));
     Cell cell(p);
     if (dont_load)
         cell.SetNoCreate();
+    if (cell.VisitIndexed(p, visitor, *map, x, y, radius, CELL_INDEX_ALL_CONTAINERS, mode))
+        return;
     TypeContainerVisitor<T, GridTypeMapContainer > gnotifier(visitor);
     TypeContainerVisitor<T, WorldTypeMapContainer > wnotifier(visitor);
     cell.Visit(p, gnotifier, *map, x, y, radius);
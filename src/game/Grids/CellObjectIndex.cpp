@@ -0,0 +1,84 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Grids/CellObjectIndex.h"
+#include "Entities/Object.h"
+
+std::atomic<bool> CellObjectIndex::m_searchEnabled(true);
+
+CellObjectIndex::~CellObjectIndex()
+{
+    // cell destroyed with objects still listed, they must not touch it anymore
+    for (WorldObject* obj : m_objects)
+        obj->m_cellIndex = nullptr;
+}
+
+void CellObjectIndex::Insert(WorldObject* obj, void* typedObj, uint8 flags)
+{
+    // still listed somewhere else, should not happen but never leave a stale slot behind
+    if (obj->m_cellIndex)
+        obj->m_cellIndex->Remove(obj);
+
+    obj->m_cellIndex = this;
+    obj->m_cellIndexSlot = Size();
+
+    if (obj->NeedsVisibilityCheck())
+        flags |= CELL_INDEX_VISIBILITY_CHECK;
+
+    m_x.push_back(obj->GetPositionX());
+    m_y.push_back(obj->GetPositionY());
+    m_reach.push_back(std::max(obj->GetObjectBoundingRadius(), obj->GetCombatReach()));
+    m_phaseMask.push_back(obj->GetPhaseMask());
+    m_flags.push_back(flags);
+    m_typed.push_back(typedObj);
+    m_objects.push_back(obj);
+    m_guids.push_back(obj->GetObjectGuid().GetRawValue());
+}
+
+void CellObjectIndex::Remove(WorldObject* obj)
+{
+    if (obj->m_cellIndex != this)
+        return;
+
+    uint32 slot = obj->m_cellIndexSlot;
+    uint32 last = Size() - 1;
+    if (slot != last)
+    {
+        m_x[slot] = m_x[last];
+        m_y[slot] = m_y[last];
+        m_reach[slot] = m_reach[last];
+        m_phaseMask[slot] = m_phaseMask[last];
+        m_flags[slot] = m_flags[last];
+        m_typed[slot] = m_typed[last];
+        m_objects[slot] = m_objects[last];
+        m_guids[slot] = m_guids[last];
+        m_objects[slot]->m_cellIndexSlot = slot;
+    }
+
+    m_x.pop_back();
+    m_y.pop_back();
+    m_reach.pop_back();
+    m_phaseMask.pop_back();
+    m_flags.pop_back();
+    m_typed.pop_back();
+    m_objects.pop_back();
+    m_guids.pop_back();
+
+    obj->m_cellIndex = nullptr;
+    obj->m_cellIndexSlot = 0;
+}
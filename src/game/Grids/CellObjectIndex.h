@@ -0,0 +1,283 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_CELLOBJECTINDEX_H
+#define MANGOS_CELLOBJECTINDEX_H
+
+#include "Common.h"
+
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+#include <vector>
+
+class WorldObject;
+class Player;
+class Creature;
+class GameObject;
+class DynamicObject;
+class Corpse;
+
+// type and container bits packed in CellObjectIndex flags
+enum CellIndexFlags
+{
+    CELL_INDEX_PLAYER           = 0x01,
+    CELL_INDEX_CREATURE         = 0x02,
+    CELL_INDEX_GAMEOBJECT       = 0x04,
+    CELL_INDEX_DYNAMICOBJECT    = 0x08,
+    CELL_INDEX_CORPSE           = 0x10,
+
+    CELL_INDEX_UNIT             = CELL_INDEX_PLAYER | CELL_INDEX_CREATURE,
+    CELL_INDEX_ALL_TYPES        = CELL_INDEX_UNIT | CELL_INDEX_GAMEOBJECT | CELL_INDEX_DYNAMICOBJECT | CELL_INDEX_CORPSE,
+
+    CELL_INDEX_GRID_CONTAINER   = 0x20,                     // listed in the cell's grid object container
+    CELL_INDEX_WORLD_CONTAINER  = 0x40,                     // listed in the cell's world object container
+    CELL_INDEX_ALL_CONTAINERS   = CELL_INDEX_GRID_CONTAINER | CELL_INDEX_WORLD_CONTAINER,
+
+    CELL_INDEX_VISIBILITY_CHECK = 0x80,                     // visibility not decided by the normal distance alone (overridden distance, stealth)
+};
+
+// added to every range check, covers combined combat reach and melee leeway of distance checks made by searchers
+#define CELL_INDEX_SEARCH_MARGIN 8.0f
+
+/**
+ * Structure of arrays side index of the objects listed in a grid cell.
+ *
+ * Kept in sync by Grid (add/remove), WorldObject::Relocate and WorldObject::SetPhaseMask so range searches
+ * can reject objects by position, phase and type without touching the objects themselves.
+ * Order of entries is not stable, removal moves the last entry into the freed slot.
+ */
+class CellObjectIndex
+{
+    public:
+        CellObjectIndex() {}
+        ~CellObjectIndex();
+
+        // Grid hooks - cameras and other non world objects are not indexed
+        template<class T> void InsertGridObject(T* obj) { if constexpr (std::is_base_of<WorldObject, T>::value) Insert(obj, obj, GetTypeFlag(obj) | CELL_INDEX_GRID_CONTAINER); }
+        template<class T> void InsertWorldObject(T* obj) { if constexpr (std::is_base_of<WorldObject, T>::value) Insert(obj, obj, GetTypeFlag(obj) | CELL_INDEX_WORLD_CONTAINER); }
+        template<class T> void Remove(T* obj) { if constexpr (std::is_base_of<WorldObject, T>::value) Remove(static_cast<WorldObject*>(obj)); }
+
+        void Remove(WorldObject* obj);
+        void Relocate(uint32 slot, float x, float y) { m_x[slot] = x; m_y[slot] = y; }
+        void SetPhaseMask(uint32 slot, uint32 phaseMask) { m_phaseMask[slot] = phaseMask; }
+        void SetReach(uint32 slot, float reach) { m_reach[slot] = reach; }
+        void SetVisibilityCheck(uint32 slot, bool apply) { m_flags[slot] = apply ? (m_flags[slot] | CELL_INDEX_VISIBILITY_CHECK) : (m_flags[slot] & ~CELL_INDEX_VISIBILITY_CHECK); }
+
+        uint32 Size() const { return uint32(m_objects.size()); }
+        WorldObject* GetObject(uint32 slot) const { return m_objects[slot]; }
+        uint64 GetRawGuid(uint32 slot) const { return m_guids[slot]; }
+        uint8 GetFlags(uint32 slot) const { return m_flags[slot]; }
+
+        /**
+         * Calls visitor.VisitObject(T*) for every object of the given type and container flags in phase and within
+         * radius (plus object reach and CELL_INDEX_SEARCH_MARGIN) of x, y - radius <= 0 disables the range check.
+         * Returns true once the visitor reported it is done.
+         */
+        template<class VISITOR>
+        bool Visit(VISITOR& visitor, float x, float y, float radius, uint32 phaseMask, uint8 typeFlags, uint8 containerFlags) const;
+
+        /**
+         * Calls visitor.VisitObject(T*) for every object of the visitor's types whose distance based visibility may differ
+         * between viewers at oldX, oldY and x, y - objects closer than innerRadius to both positions or farther than
+         * outerRadius (plus object reach) from both are skipped, unless flagged CELL_INDEX_VISIBILITY_CHECK.
+         */
+        template<class VISITOR>
+        void VisitMoved(VISITOR& visitor, float oldX, float oldY, float x, float y, float innerRadius, float outerRadius) const;
+
+        // disabled searches walk the cell containers as before
+        static bool IsSearchEnabled() { return m_searchEnabled; }
+        static void SetSearchEnabled(bool enabled) { m_searchEnabled = enabled; }
+
+    private:
+        CellObjectIndex(CellObjectIndex const&) = delete;
+        CellObjectIndex& operator=(CellObjectIndex const&) = delete;
+
+        static uint8 GetTypeFlag(Player*) { return CELL_INDEX_PLAYER; }
+        static uint8 GetTypeFlag(Creature*) { return CELL_INDEX_CREATURE; }
+        static uint8 GetTypeFlag(GameObject*) { return CELL_INDEX_GAMEOBJECT; }
+        static uint8 GetTypeFlag(DynamicObject*) { return CELL_INDEX_DYNAMICOBJECT; }
+        static uint8 GetTypeFlag(Corpse*) { return CELL_INDEX_CORPSE; }
+
+        void Insert(WorldObject* obj, void* typedObj, uint8 flags);
+
+        template<class VISITOR>
+        static bool VisitTyped(VISITOR& visitor, void* obj, uint8 typeFlag);
+
+        // hot - scanned for every search
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_reach;
+        std::vector<uint32> m_phaseMask;
+        std::vector<uint8> m_flags;
+
+        // cold - only read for accepted candidates and on maintenance
+        std::vector<void*> m_typed;                         // object as the type it was listed with, see GetTypeFlag
+        std::vector<WorldObject*> m_objects;
+        std::vector<uint64> m_guids;
+
+        static std::atomic<bool> m_searchEnabled;
+};
+
+template<class VISITOR>
+inline bool CellObjectIndex::VisitTyped(VISITOR& visitor, void* obj, uint8 typeFlag)
+{
+    // only types the visitor asked for are instantiated, its check may not accept any other
+    if constexpr ((VISITOR::CellIndexTypes & CELL_INDEX_PLAYER) != 0)
+        if (typeFlag == CELL_INDEX_PLAYER)
+            return visitor.VisitObject(static_cast<Player*>(obj));
+    if constexpr ((VISITOR::CellIndexTypes & CELL_INDEX_CREATURE) != 0)
+        if (typeFlag == CELL_INDEX_CREATURE)
+            return visitor.VisitObject(static_cast<Creature*>(obj));
+    if constexpr ((VISITOR::CellIndexTypes & CELL_INDEX_GAMEOBJECT) != 0)
+        if (typeFlag == CELL_INDEX_GAMEOBJECT)
+            return visitor.VisitObject(static_cast<GameObject*>(obj));
+    if constexpr ((VISITOR::CellIndexTypes & CELL_INDEX_DYNAMICOBJECT) != 0)
+        if (typeFlag == CELL_INDEX_DYNAMICOBJECT)
+            return visitor.VisitObject(static_cast<DynamicObject*>(obj));
+    if constexpr ((VISITOR::CellIndexTypes & CELL_INDEX_CORPSE) != 0)
+        if (typeFlag == CELL_INDEX_CORPSE)
+            return visitor.VisitObject(static_cast<Corpse*>(obj));
+    return false;
+}
+
+template<class VISITOR>
+inline bool CellObjectIndex::Visit(VISITOR& visitor, float x, float y, float radius, uint32 phaseMask, uint8 typeFlags, uint8 containerFlags) const
+{
+    // filter a block of entries into a mask first, the loop has no branches and gets vectorized
+    const uint32 BLOCK_SIZE = 64;
+    uint8 accepted[BLOCK_SIZE];
+
+    const bool checkRange = radius > 0.0f;
+    const float range = radius + CELL_INDEX_SEARCH_MARGIN;
+    const uint32 count = Size();
+
+    float const* posX = m_x.data();
+    float const* posY = m_y.data();
+    float const* reach = m_reach.data();
+    uint32 const* phase = m_phaseMask.data();
+    uint8 const* flags = m_flags.data();
+
+    for (uint32 begin = 0; begin < count; begin += BLOCK_SIZE)
+    {
+        const uint32 blockSize = std::min(BLOCK_SIZE, count - begin);
+
+        for (uint32 i = 0; i < blockSize; ++i)
+        {
+            const uint32 slot = begin + i;
+            const float dx = posX[slot] - x;
+            const float dy = posY[slot] - y;
+            const float maxDist = range + reach[slot];
+            const bool inRange = (dx * dx + dy * dy <= maxDist * maxDist) | !checkRange;
+            accepted[i] = uint8(inRange & ((phase[slot] & phaseMask) != 0) & ((flags[slot] & typeFlags) != 0) & ((flags[slot] & containerFlags) != 0));
+        }
+
+        for (uint32 i = 0; i < blockSize; ++i)
+        {
+            if (!accepted[i])
+                continue;
+
+            const uint32 slot = begin + i;
+            if (VisitTyped(visitor, m_typed[slot], flags[slot] & CELL_INDEX_ALL_TYPES))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+template<class VISITOR>
+inline void CellObjectIndex::VisitMoved(VISITOR& visitor, float oldX, float oldY, float x, float y, float innerRadius, float outerRadius) const
+{
+    const uint32 BLOCK_SIZE = 64;
+    uint8 accepted[BLOCK_SIZE];
+
+    const float innerSq = innerRadius * innerRadius;
+    const uint32 count = Size();
+
+    float const* posX = m_x.data();
+    float const* posY = m_y.data();
+    float const* reach = m_reach.data();
+    uint8 const* flags = m_flags.data();
+
+    for (uint32 begin = 0; begin < count; begin += BLOCK_SIZE)
+    {
+        const uint32 blockSize = std::min(BLOCK_SIZE, count - begin);
+
+        for (uint32 i = 0; i < blockSize; ++i)
+        {
+            const uint32 slot = begin + i;
+            const float oldDx = posX[slot] - oldX;
+            const float oldDy = posY[slot] - oldY;
+            const float dx = posX[slot] - x;
+            const float dy = posY[slot] - y;
+            const float oldDistSq = oldDx * oldDx + oldDy * oldDy;
+            const float distSq = dx * dx + dy * dy;
+            const float maxDist = outerRadius + reach[slot];
+            const bool inside = (oldDistSq < innerSq) & (distSq < innerSq);
+            const bool outside = (oldDistSq > maxDist * maxDist) & (distSq > maxDist * maxDist);
+            accepted[i] = uint8(((!inside & !outside) | ((flags[slot] & CELL_INDEX_VISIBILITY_CHECK) != 0)) & ((flags[slot] & VISITOR::CellIndexTypes) != 0));
+        }
+
+        for (uint32 i = 0; i < blockSize; ++i)
+        {
+            if (!accepted[i])
+                continue;
+
+            // visibility updates can remove objects from the cell (pets unsummoned out of range)
+            const uint32 slot = begin + i;
+            if (slot >= Size())
+                return;
+
+            if (VisitTyped(visitor, m_typed[slot], m_flags[slot] & CELL_INDEX_ALL_TYPES))
+                return;
+        }
+    }
+}
+
+// detects searchers that can be fed from the cell object index, see Cell::VisitGridObjects
+template<class T, class = void>
+struct IsCellIndexVisitor : std::false_type {};
+
+template<class T>
+struct IsCellIndexVisitor<T, std::void_t<decltype(T::CellIndexTypes)> > : std::true_type {};
+
+/**
+ * Adapts a searcher for Cell::Visit - visits the cell object index of each cell instead of its containers.
+ */
+template<class VISITOR>
+struct CellIndexVisitor
+{
+    CellIndexVisitor(VISITOR& visitor, float x, float y, float radius, uint8 containerFlags)
+        : i_visitor(visitor), i_x(x), i_y(y), i_radius(radius), i_containerFlags(containerFlags), i_done(false) {}
+
+    void Visit(CellObjectIndex const& index)
+    {
+        if (!i_done)
+            i_done = index.Visit(i_visitor, i_x, i_y, i_radius, i_visitor.i_phaseMask, VISITOR::CellIndexTypes, i_containerFlags);
+    }
+
+    VISITOR& i_visitor;
+    float i_x;
+    float i_y;
+    float i_radius;
+    uint8 i_containerFlags;
+    bool i_done;
+};
+
+#endif
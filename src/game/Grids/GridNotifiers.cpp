@@ -59,9 +59,9 @@ void VisibleNotifier::Notify()
     }
 
     // Far objects update on player notify
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
+    for (GuidHashSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
     {
-        GuidSet::iterator current = itr++;
+        GuidHashSet::iterator current = itr++;
         if (WorldObject* obj = player.GetMap()->GetWorldObject(*current))
         {
             if (!obj->GetVisibilityData().IsVisibilityOverridden())
@@ -72,7 +72,7 @@ void VisibleNotifier::Notify()
         }
     }
 
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
+    for (GuidHashSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
     {
         if ((*itr).IsMOTransport())
         {
@@ -84,7 +84,7 @@ void VisibleNotifier::Notify()
 
     // generate outOfRange for not iterate objects
     i_data.AddOutOfRangeGUID(i_clientGUIDs);
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
+    for (GuidHashSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
     {
         if (WorldObject* target = player.GetMap()->GetWorldObject(*itr))
         {
@@ -233,7 +233,7 @@ template<class T>
 void ObjectUpdater::Visit(GridRefManager<T>& m)
 {
     for (auto& iter : m)
-        m_objectToUpdateSet.emplace(iter.getSource());
+        m_objectsToUpdate.push_back(iter.getSource());
 }
 
 bool CannibalizeObjectCheck::operator()(Corpse* u)
@@ -37,11 +37,14 @@ namespace MaNGOS
     {
         Camera& i_camera;
         UpdateData i_data;
-        GuidSet i_clientGUIDs;
+        GuidHashSet i_clientGUIDs;
         WorldObjectSet i_visibleNow;
 
         explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->GetClientGuids()) {}
+        // incremental pass - only the given guids at client go out of range if not visited
+        VisibleNotifier(Camera& c, GuidHashSet const& candidates) : i_camera(c), i_clientGUIDs(candidates) {}
         template<class T> void Visit(GridRefManager<T>& m);
+        template<class T> void UpdateVisibilityOf(T* target);
         void Visit(CameraMapType& /*m*/) {}
         void Notify(void);
     };
@@ -54,9 +57,9 @@ namespace MaNGOS
         template<class T> void Visit(GridRefManager<T>&) {}
         void Visit(CameraMapType&);
 
-        GuidSet& GetUnvisitedGuids() { return m_unvisitedGuids; }
+        GuidHashSet& GetUnvisitedGuids() { return m_unvisitedGuids; }
 
-        GuidSet m_unvisitedGuids;
+        GuidHashSet m_unvisitedGuids;
     };
 
     struct MessageDeliverer
@@ -130,7 +133,7 @@ namespace MaNGOS
 
     struct ObjectUpdater
     {
-        ObjectUpdater(WorldObjectUnSet& otus, const uint32& diff) : m_objectToUpdateSet(otus), m_timeDiff(diff) {}
+        ObjectUpdater(WorldObjectVector& otus, const uint32& diff) : m_objectsToUpdate(otus), m_timeDiff(diff) {}
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(PlayerMapType&) {}
         void Visit(CorpseMapType&) {}
@@ -138,7 +141,7 @@ namespace MaNGOS
         void Visit(CreatureMapType&);
 
         private:
-            WorldObjectUnSet& m_objectToUpdateSet;
+            WorldObjectVector& m_objectsToUpdate;               // every object sits in one cell, visited cells are distinct
             uint32 m_timeDiff;
     };
 
@@ -232,6 +235,10 @@ namespace MaNGOS
         void Visit(DynamicObjectMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+
+        // cell object index search, returns true when done
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_ALL_TYPES;
+        template<class T> bool VisitObject(T* obj);
     };
 
     template<class Check>
@@ -251,6 +258,10 @@ namespace MaNGOS
         void Visit(DynamicObjectMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+
+        // cell object index search, returns true when done
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_ALL_TYPES;
+        template<class T> bool VisitObject(T* obj);
     };
 
     template<class Do>
@@ -314,6 +325,10 @@ namespace MaNGOS
         void Visit(GameObjectMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+
+        // cell object index search, returns true when done
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_GAMEOBJECT;
+        template<class T> bool VisitObject(T* obj);
     };
 
     // Last accepted by Check GO if any (Check can change requirements at each call)
@@ -330,6 +345,10 @@ namespace MaNGOS
         void Visit(GameObjectMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+
+        // cell object index search, returns true when done
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_GAMEOBJECT;
+        template<class T> bool VisitObject(T* obj);
     };
 
     template<class Check>
@@ -345,6 +364,10 @@ namespace MaNGOS
         void Visit(GameObjectMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+
+        // cell object index search, returns true when done
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_GAMEOBJECT;
+        template<class T> bool VisitObject(T* obj);
     };
 
     // Unit searchers
@@ -364,6 +387,10 @@ namespace MaNGOS
         void Visit(PlayerMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+
+        // cell object index search, returns true when done
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_UNIT;
+        template<class T> bool VisitObject(T* obj);
     };
 
     // Last accepted by Check Unit if any (Check can change requirements at each call)
@@ -381,6 +408,10 @@ namespace MaNGOS
         void Visit(PlayerMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+
+        // cell object index search, returns true when done
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_UNIT;
+        template<class T> bool VisitObject(T* obj);
     };
 
     // All accepted by Check units if any
@@ -398,6 +429,10 @@ namespace MaNGOS
         void Visit(CreatureMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+
+        // cell object index search, returns true when done
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_UNIT;
+        template<class T> bool VisitObject(T* obj);
     };
 
     // Creature searchers
@@ -415,6 +450,10 @@ namespace MaNGOS
         void Visit(CreatureMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+
+        // cell object index search, returns true when done
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_CREATURE;
+        template<class T> bool VisitObject(T* obj);
     };
 
     // Last accepted by Check Creature if any (Check can change requirements at each call)
@@ -431,6 +470,10 @@ namespace MaNGOS
         void Visit(CreatureMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+
+        // cell object index search, returns true when done
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_CREATURE;
+        template<class T> bool VisitObject(T* obj);
     };
 
     template<class Check>
@@ -446,6 +489,10 @@ namespace MaNGOS
         void Visit(CreatureMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+
+        // cell object index search, returns true when done
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_CREATURE;
+        template<class T> bool VisitObject(T* obj);
     };
 
     template<class Do>
@@ -482,6 +529,10 @@ namespace MaNGOS
         void Visit(PlayerMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+
+        // cell object index search, returns true when done
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_PLAYER;
+        template<class T> bool VisitObject(T* obj);
     };
 
     template<class Check>
@@ -497,6 +548,10 @@ namespace MaNGOS
         void Visit(PlayerMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+
+        // cell object index search, returns true when done
+        static constexpr uint8 CellIndexTypes = CELL_INDEX_PLAYER;
+        template<class T> bool VisitObject(T* obj);
     };
 
     template<class Do>
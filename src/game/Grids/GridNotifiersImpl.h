@@ -33,16 +33,20 @@ template<class T>
 inline void MaNGOS::VisibleNotifier::Visit(GridRefManager<T>& m)
 {
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
-    {
-        i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
-        i_clientGUIDs.erase(iter->getSource()->GetObjectGuid());
-    }
+        UpdateVisibilityOf(iter->getSource());
+}
+
+template<class T>
+inline void MaNGOS::VisibleNotifier::UpdateVisibilityOf(T* target)
+{
+    i_camera.UpdateVisibilityOf(target, i_data, i_visibleNow);
+    i_clientGUIDs.erase(target->GetObjectGuid());
 }
 
 inline void MaNGOS::ObjectUpdater::Visit(CreatureMapType& m)
 {
     for (auto& iter : m)
-        m_objectToUpdateSet.emplace(iter.getSource());
+        m_objectsToUpdate.push_back(iter.getSource());
 }
 
 inline void UnitVisitObjectsNotifierWorker(Unit* unitA, Unit* unitB)
@@ -432,6 +436,21 @@ void MaNGOS::WorldObjectSearcher<Check>::Visit(DynamicObjectMapType& m)
     }
 }
 
+template<class Check>
+template<class T>
+bool MaNGOS::WorldObjectSearcher<Check>::VisitObject(T* obj)
+{
+    // already found
+    if (i_object)
+        return true;
+
+    if (!i_check(obj))
+        return false;
+
+    i_object = obj;
+    return true;
+}
+
 template<class Check>
 void MaNGOS::WorldObjectListSearcher<Check>::Visit(PlayerMapType& m)
 {
@@ -477,6 +496,15 @@ void MaNGOS::WorldObjectListSearcher<Check>::Visit(DynamicObjectMapType& m)
                 i_objects.push_back(itr->getSource());
 }
 
+template<class Check>
+template<class T>
+bool MaNGOS::WorldObjectListSearcher<Check>::VisitObject(T* obj)
+{
+    if (i_check(obj))
+        i_objects.push_back(obj);
+    return false;
+}
+
 // Gameobject searchers
 
 template<class Check>
@@ -499,6 +527,21 @@ void MaNGOS::GameObjectSearcher<Check>::Visit(GameObjectMapType& m)
     }
 }
 
+template<class Check>
+template<class T>
+bool MaNGOS::GameObjectSearcher<Check>::VisitObject(T* obj)
+{
+    // already found
+    if (i_object)
+        return true;
+
+    if (!i_check(obj))
+        return false;
+
+    i_object = obj;
+    return true;
+}
+
 template<class Check>
 void MaNGOS::GameObjectLastSearcher<Check>::Visit(GameObjectMapType& m)
 {
@@ -512,6 +555,15 @@ void MaNGOS::GameObjectLastSearcher<Check>::Visit(GameObjectMapType& m)
     }
 }
 
+template<class Check>
+template<class T>
+bool MaNGOS::GameObjectLastSearcher<Check>::VisitObject(T* obj)
+{
+    if (i_check(obj))
+        i_object = obj;
+    return false;
+}
+
 template<class Check>
 void MaNGOS::GameObjectListSearcher<Check>::Visit(GameObjectMapType& m)
 {
@@ -521,6 +573,15 @@ void MaNGOS::GameObjectListSearcher<Check>::Visit(GameObjectMapType& m)
                 i_objects.push_back(itr->getSource());
 }
 
+template<class Check>
+template<class T>
+bool MaNGOS::GameObjectListSearcher<Check>::VisitObject(T* obj)
+{
+    if (i_check(obj))
+        i_objects.push_back(obj);
+    return false;
+}
+
 // Unit searchers
 
 template<class Check>
@@ -563,6 +624,21 @@ void MaNGOS::UnitSearcher<Check>::Visit(PlayerMapType& m)
     }
 }
 
+template<class Check>
+template<class T>
+bool MaNGOS::UnitSearcher<Check>::VisitObject(T* obj)
+{
+    // already found
+    if (i_object)
+        return true;
+
+    if (!i_check(obj))
+        return false;
+
+    i_object = obj;
+    return true;
+}
+
 template<class Check>
 void MaNGOS::UnitLastSearcher<Check>::Visit(CreatureMapType& m)
 {
@@ -589,6 +665,15 @@ void MaNGOS::UnitLastSearcher<Check>::Visit(PlayerMapType& m)
     }
 }
 
+template<class Check>
+template<class T>
+bool MaNGOS::UnitLastSearcher<Check>::VisitObject(T* obj)
+{
+    if (i_check(obj))
+        i_object = obj;
+    return false;
+}
+
 template<class Check>
 void MaNGOS::UnitListSearcher<Check>::Visit(PlayerMapType& m)
 {
@@ -607,6 +692,15 @@ void MaNGOS::UnitListSearcher<Check>::Visit(CreatureMapType& m)
                 i_objects.push_back(itr->getSource());
 }
 
+template<class Check>
+template<class T>
+bool MaNGOS::UnitListSearcher<Check>::VisitObject(T* obj)
+{
+    if (i_check(obj))
+        i_objects.push_back(obj);
+    return false;
+}
+
 // Creature searchers
 
 template<class Check>
@@ -629,6 +723,21 @@ void MaNGOS::CreatureSearcher<Check>::Visit(CreatureMapType& m)
     }
 }
 
+template<class Check>
+template<class T>
+bool MaNGOS::CreatureSearcher<Check>::VisitObject(T* obj)
+{
+    // already found
+    if (i_object)
+        return true;
+
+    if (!i_check(obj))
+        return false;
+
+    i_object = obj;
+    return true;
+}
+
 template<class Check>
 void MaNGOS::CreatureLastSearcher<Check>::Visit(CreatureMapType& m)
 {
@@ -642,6 +751,15 @@ void MaNGOS::CreatureLastSearcher<Check>::Visit(CreatureMapType& m)
     }
 }
 
+template<class Check>
+template<class T>
+bool MaNGOS::CreatureLastSearcher<Check>::VisitObject(T* obj)
+{
+    if (i_check(obj))
+        i_object = obj;
+    return false;
+}
+
 template<class Check>
 void MaNGOS::CreatureListSearcher<Check>::Visit(CreatureMapType& m)
 {
@@ -651,6 +769,15 @@ void MaNGOS::CreatureListSearcher<Check>::Visit(CreatureMapType& m)
                 i_objects.push_back(itr->getSource());
 }
 
+template<class Check>
+template<class T>
+bool MaNGOS::CreatureListSearcher<Check>::VisitObject(T* obj)
+{
+    if (i_check(obj))
+        i_objects.push_back(obj);
+    return false;
+}
+
 template<class Check>
 void MaNGOS::PlayerSearcher<Check>::Visit(PlayerMapType& m)
 {
@@ -671,6 +798,21 @@ void MaNGOS::PlayerSearcher<Check>::Visit(PlayerMapType& m)
     }
 }
 
+template<class Check>
+template<class T>
+bool MaNGOS::PlayerSearcher<Check>::VisitObject(T* obj)
+{
+    // already found
+    if (i_object)
+        return true;
+
+    if (!i_check(obj))
+        return false;
+
+    i_object = obj;
+    return true;
+}
+
 template<class Check>
 void MaNGOS::PlayerListSearcher<Check>::Visit(PlayerMapType& m)
 {
@@ -680,6 +822,15 @@ void MaNGOS::PlayerListSearcher<Check>::Visit(PlayerMapType& m)
                 i_objects.push_back(itr->getSource());
 }
 
+template<class Check>
+template<class T>
+bool MaNGOS::PlayerListSearcher<Check>::VisitObject(T* obj)
+{
+    if (i_check(obj))
+        i_objects.push_back(obj);
+    return false;
+}
+
 template<class Builder>
 void MaNGOS::LocalizedPacketDo<Builder>::operator()(Player* p)
 {
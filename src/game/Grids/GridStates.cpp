@@ -18,6 +18,7 @@
 
 #include "Grids/GridStates.h"
 #include "Log/Log.h"
+#include "Maps/MapManager.h"
 
 void
 InvalidState::Update(Map&, NGridType&, GridInfo&, const uint32& /*x*/, const uint32& /*y*/, const uint32&) const
@@ -34,6 +35,7 @@ ActiveState::Update(Map& m, NGridType& grid, GridInfo& info, const uint32& x, co
         if (grid.ActiveObjectsInGrid() == 0 && !m.ActiveObjectsNearGrid(x, y))
         {
             grid.SetGridState(GRID_STATE_IDLE);
+            ++MapManager::GetGridStateStats().idled;
         }
         else
         {
@@ -58,9 +60,17 @@ RemovalState::Update(Map& m, NGridType& grid, GridInfo& info, const uint32& x, c
         info.UpdateTimeTracker(t_diff);
         if (info.getTimeTracker().Passed())
         {
+            // the tracker stays passed, one of the next updates unloads the grid
+            if (!m.TakeGridUnloadBudget())
+            {
+                ++MapManager::GetGridStateStats().unloadsDeferred;
+                return;
+            }
+
             if (!m.UnloadGrid(x, y, false))
             {
                 DEBUG_LOG("Grid[%u,%u] for map %u differed unloading due to players or active objects nearby", x, y, m.GetId());
+                ++MapManager::GetGridStateStats().unloadsRefused;
                 m.ResetGridExpiry(grid);
             }
         }
@@ -26,6 +26,9 @@
 #include "World/World.h"
 #include "Grids/CellImpl.h"
 #include "Maps/GridDefines.h"
+#include "Maps/MapManager.h"
+
+#include <chrono>
 
 class ObjectGridRespawnMover
 {
@@ -250,6 +253,8 @@ ObjectGridLoader::Load(GridType& grid)
 
 void ObjectGridLoader::LoadN(void)
 {
+    auto loadStart = std::chrono::steady_clock::now();
+
     i_gameObjects = 0; i_creatures = 0; i_corpses = 0;
     i_cell.data.Part.cell_y = 0;
     for (unsigned int x = 0; x < MAX_NUMBER_OF_CELLS; ++x)
@@ -258,11 +263,21 @@ void ObjectGridLoader::LoadN(void)
         for (unsigned int y = 0; y < MAX_NUMBER_OF_CELLS; ++y)
         {
             i_cell.data.Part.cell_y = y;
-            GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes> loader;
+            GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes, CellObjectIndex> loader;
             loader.Load(i_grid(x, y), *this);
         }
     }
-    DETAIL_FILTER_LOG(LOG_FILTER_MAP_LOADING, "%u GameObjects, %u Creatures, and %u Corpses/Bones loaded for grid %u on map %u", i_gameObjects, i_creatures, i_corpses, i_grid.GetGridId(), i_map->GetId());
+
+    GridStateStats& stats = MapManager::GetGridStateStats();
+    uint64 loadTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - loadStart).count();
+    ++stats.loaded;
+    stats.loadedObjects += i_gameObjects + i_creatures + i_corpses;
+    stats.loadTime += loadTime;
+    uint64 maxLoadTime = stats.maxLoadTime;
+    while (loadTime > maxLoadTime && !stats.maxLoadTime.compare_exchange_weak(maxLoadTime, loadTime));
+
+    DETAIL_FILTER_LOG(LOG_FILTER_MAP_LOADING, "%u GameObjects, %u Creatures, and %u Corpses/Bones loaded for grid %u on map %u in " UI64FMTD " us",
+                      i_gameObjects, i_creatures, i_corpses, i_grid.GetGridId(), i_map->GetId(), loadTime);
 }
 
 void ObjectGridUnloader::MoveToRespawnN()
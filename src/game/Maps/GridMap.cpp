@@ -20,6 +20,7 @@
 #include "Grids/CellImpl.h"
 #include "GridDefines.h"
 #include "Maps/Map.h"
+#include "Maps/MapManager.h"
 #include "Server/DBCEnums.h"
 #include "Server/DBCStores.h"
 #include "Maps/GridMap.h"
@@ -28,6 +29,7 @@
 #include "World/World.h"
 #include "Policies/Singleton.h"
 #include "Util/Util.h"
+#include "Maps/TerrainQueryTrace.h"
 
 #include <mutex>
 
@@ -768,15 +770,9 @@ void TerrainInfo::Unload(const uint32 x, const uint32 y)
     MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
     MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
 
-    if (m_GridMaps[x][y])
-    {
-        // decrease grid reference count...
-        if (UnrefGrid(x, y) == 0)
-        {
-            m_GridMapsLoadAttempted[x][y] = false;
-            // TODO: add your additional logic here
-        }
-    }
+    // Load referenced the tile whether or not its data was found, release it the same way
+    if (UnrefGrid(x, y) == 0)
+        m_GridMapsLoadAttempted[x][y] = false;
 }
 
 // call this method only
@@ -790,24 +786,27 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
     {
         for (int x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
         {
-            const int16& iRef = m_GridRef[x][y];
-            GridMap* pMap = m_GridMaps[x][y];
-
-            // delete those GridMap objects which have refcount = 0
-            if (pMap && iRef == 0)
+            GridMap* pMap = nullptr;
             {
+                // detach those GridMap objects which have refcount = 0, a map loading the grid meanwhile reads it again
+                LOCK_GUARD _lock(m_refMutex);
+                if (!m_GridMaps[x][y] || m_GridRef[x][y] != 0)
+                    continue;
+
+                pMap = m_GridMaps[x][y];
                 m_GridMaps[x][y] = nullptr;
                 m_GridMapsLoadAttempted[x][y] = false;
-                // delete grid data if reference count == 0
-                pMap->unloadData();
-                delete pMap;
+            }
 
-                // unload VMAPS...
-                m_vmgr->unloadMap(m_mapId, x, y);
+            // height and liquid data is freed by the map update threads, nothing can reach it anymore
+            sMapMgr.QueueGridTeardown(pMap);
+            ++MapManager::GetGridStateStats().tilesReleased;
 
-                // unload mmap... - not possible like this - mmaps are per-map
-                // MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId, x, y);
-            }
+            // unload VMAPS... - here, vmap trees are read without locking by all maps using this terrain
+            m_vmgr->unloadMap(m_mapId, x, y);
+
+            // unload mmap... - not possible like this - mmaps are per-map
+            // MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId, x, y);
         }
     }
 
@@ -836,9 +835,8 @@ int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
     MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
     MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
 
-    int16& iRef = m_GridRef[x][y];
-
     LOCK_GUARD _lock(m_refMutex);
+    int16& iRef = m_GridRef[x][y];
     if (iRef > 0)
         return (iRef -= 1);
 
@@ -847,6 +845,8 @@ int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
 
 float TerrainInfo::GetHeightStatic(float x, float y, float z, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
 {
+    TerrainQueryRecorder traceQuery(TERRAIN_QUERY_HEIGHT, GetMapId(), x, y, z, 0.0f, 0.0f, 0.0f, maxSearchDist, useVmaps);
+
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;            // Store Height obtained by maps
     float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
 
@@ -1034,6 +1034,8 @@ AreaNameInfo TerrainInfo::GetAreaName(float x, float y, float z, uint32 langInde
 
 uint16 TerrainInfo::GetAreaFlag(float x, float y, float z, bool* isOutdoors) const
 {
+    TerrainQueryRecorder traceQuery(TERRAIN_QUERY_AREA, GetMapId(), x, y, z, 0.0f, 0.0f, 0.0f, 0.0f, 0);
+
     uint32 mogpFlags = 0;
     int32 adtId, rootId, groupId;
     WMOAreaTableEntry const* foundWmoEntry = nullptr;
@@ -1103,6 +1105,8 @@ void TerrainInfo::GetZoneAndAreaId(uint32& zoneid, uint32& areaid, float x, floa
 
 GridMapLiquidStatus TerrainInfo::getLiquidStatus(float x, float y, float z, uint8 ReqLiquidType, GridMapLiquidData* data, float collisionHeight) const
 {
+    TerrainQueryRecorder traceQuery(TERRAIN_QUERY_LIQUID, GetMapId(), x, y, z, 0.0f, 0.0f, 0.0f, collisionHeight, ReqLiquidType);
+
     GridMapLiquidStatus result = LIQUID_MAP_NO_WATER;
     uint32 liquid_type = 0;
     float liquid_level = INVALID_HEIGHT_VALUE;
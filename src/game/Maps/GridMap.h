@@ -170,7 +170,8 @@ class TerrainInfo : public Referencable<std::atomic_long>
         // this method should be used only by TerrainManager
         // to cleanup unreferenced GridMap objects - they are too heavy
         // to destroy them dynamically, especially on highly populated servers
-        // THIS METHOD IS NOT THREAD-SAFE!!!! AND IT SHOULDN'T BE THREAD-SAFE!!!!
+        // call it between map updates only, the vmap tiles of unreferenced grids are unloaded here
+        // the GridMap objects themselves are freed by the map update threads
         void CleanUpGrids(const uint32 diff);
 
         bool CanCheckLiquidLevel(float x, float y) const;
@@ -44,13 +44,22 @@
 #include "Vmap/GameObjectModel.h"
 #include "LFG/LFGMgr.h"
 #include "BattleGround/BattleGroundMgr.h"
+#include "Maps/TerrainStreamer.h"
+#include "Maps/TerrainQueryTrace.h"
+#include "Movement/MoveSpline.h"
 
 #ifdef BUILD_METRICS
  #include "Metric/Metric.h"
 #endif
 
+#include <chrono>
+#include <limits>
+#include <optional>
 #include <time.h>
 
+RelocationNotifyStats Map::m_relocationNotifyStats;
+UpdateLODStats Map::m_updateLODStats;
+
 Map::~Map()
 {
     UnloadAll(true);
@@ -207,11 +216,82 @@ void Map::LoadMapAndVMap(int gx, int gy)
     if (m_bLoadedGrids[gx][gy])
         return;
 
-    if (m_TerrainData->Load(gx, gy)) // fails also on maps which have no tiles for everything except mmaps
-        m_bLoadedGrids[gx][gy] = true;
+    auto loadStart = std::chrono::steady_clock::now();
+
+    // the tile stays referenced until the grid unloads, also on maps which have no tiles for everything except mmaps
+    m_TerrainData->Load(gx, gy);
+    m_bLoadedGrids[gx][gy] = true;
 
     if (!MMAP::MMapFactory::createOrGetMMapManager()->IsMMapTileLoaded(GetId(), GetInstanceId(), gx, gy))
         MMAP::MMapFactory::createOrGetMMapManager()->loadMap(GetId(), GetInstanceId(), gx, gy, 0);
+
+    if (sTerrainStreamer.IsEnabled())
+    {
+        uint64 loadTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - loadStart).count();
+        sTerrainStreamer.OnGridLoaded(GetId(), GetInstanceId(), gx, gy, loadTime);
+    }
+}
+
+void Map::UpdateTerrainStreaming(uint32 diff)
+{
+    m_terrainStreamingTimer.Update(diff);
+    if (!m_terrainStreamingTimer.Passed())
+        return;
+
+    float elapsed = m_terrainStreamingTimer.GetCurrent() / float(IN_MILLISECONDS);
+    m_terrainStreamingTimer.SetCurrent(0);
+
+    float lookahead = sTerrainStreamer.GetLookahead() / float(IN_MILLISECONDS);
+
+    std::unordered_map<ObjectGuid, Position> samples;
+    for (auto& ref : m_mapRefManager)
+    {
+        Player* player = ref.getSource();
+        if (!player || !player->IsInWorld())
+            continue;
+
+        Position pos(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ());
+        samples.emplace(player->GetObjectGuid(), pos);
+
+        // taxi and other long splines - the path is known, request grids along it
+        if (!player->GetTransport() && !player->movespline->Finalized())
+        {
+            Movement::MoveSpline const& moveSpline = *player->movespline;
+            Movement::MoveSpline::MySpline const& spline = moveSpline._Spline();
+            int32 lookaheadTime = spline.length(moveSpline._currentSplineIdx()) + int32(sTerrainStreamer.GetLookahead());
+            for (int32 i = moveSpline._currentSplineIdx() + 1; i <= spline.last() && spline.length(i) <= lookaheadTime; ++i)
+                RequestTerrainStreamingAt(spline.getPoint(i).x, spline.getPoint(i).y);
+            continue;
+        }
+
+        // free movement - extrapolate from the last sample
+        auto itr = m_terrainStreamingSamples.find(player->GetObjectGuid());
+        if (itr == m_terrainStreamingSamples.end() || elapsed <= 0.0f)
+            continue;
+
+        float dx = (pos.x - itr->second.x) / elapsed;
+        float dy = (pos.y - itr->second.y) / elapsed;
+        if (dx == 0.0f && dy == 0.0f)
+            continue;
+
+        RequestTerrainStreamingAt(pos.x + dx * lookahead * 0.5f, pos.y + dy * lookahead * 0.5f);
+        RequestTerrainStreamingAt(pos.x + dx * lookahead, pos.y + dy * lookahead);
+    }
+
+    m_terrainStreamingSamples.swap(samples);
+}
+
+void Map::RequestTerrainStreamingAt(float x, float y)
+{
+    if (!MaNGOS::IsValidMapCoord(x, y))
+        return;
+
+    GridPair p = MaNGOS::ComputeGridPair(x, y);
+    int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+    int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+
+    if (!m_bLoadedGrids[gx][gy])
+        sTerrainStreamer.RequestGrid(GetId(), GetInstanceId(), gx, gy);
 }
 
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
@@ -221,9 +301,10 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
       m_activeNonPlayersIter(m_activeNonPlayers.end()), m_onEventNotifiedIter(m_onEventNotifiedObjects.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
       i_data(nullptr), i_script_id(0), m_transportsIterator(m_transports.begin()), m_defaultLight(GetDefaultMapLight(id)), m_spawnManager(*this),
-      m_variableManager(this)
+      m_variableManager(this), m_activeCellGeneration(0), m_gridUnloadBudget(0)
 {
     m_weatherSystem = new WeatherSystem(this);
+    m_terrainStreamingTimer.SetInterval(IN_MILLISECONDS);
 }
 
 void Map::Initialize(bool loadInstanceData /*= true*/)
@@ -707,31 +788,140 @@ bool Map::loaded(const GridPair& p) const
 
 #define MAP_METRICS
 
-void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer> &worldVisitor)
+void Map::UpdateActiveCells()
+{
+    ++m_activeCellGeneration;
+    m_updateLODCells.clear();
+
+    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    {
+        Player* player = m_mapRefIter->getSource();
+        if (!player->IsInWorld() || !player->IsPositionValid())
+            continue;
+
+        // lets update mobs/objects in ALL visible cells around player!
+        SetActiveCellSource(player, player->GetVisibilityData().GetVisibilityDistance(), true);
+
+        // If player is using far sight, its view point too
+        if (WorldObject* viewPoint = GetWorldObject(player->GetFarSightGuid()))
+            if (viewPoint->IsPositionValid())
+                SetActiveCellSource(viewPoint, viewPoint->IsInWorld() ? viewPoint->GetVisibilityData().GetVisibilityDistance() : GetVisibilityDistance(), true);
+    }
+
+    // non-player active objects
+    for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+    {
+        WorldObject* obj = *m_activeNonPlayersIter;
+        ++m_activeNonPlayersIter;
+
+        if (!obj->IsInWorld() || !obj->IsPositionValid())
+            continue;
+
+        SetActiveCellSource(obj, GetVisibilityDistance(), false);
+    }
+
+    // sources gone from the map or no longer active
+    for (auto itr = m_activeCellSources.begin(); itr != m_activeCellSources.end();)
+    {
+        if (itr->second.generation != m_activeCellGeneration)
+        {
+            ChangeActiveCellRefs(itr->second.area, -1);
+            itr = m_activeCellSources.erase(itr);
+        }
+        else
+            ++itr;
+    }
+}
+
+void Map::SetActiveCellSource(WorldObject* obj, float radius, bool playerView)
 {
-    // lets update mobs/objects in ALL visible cells around player!
-    CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), obj->IsInWorld() ? obj->GetVisibilityData().GetVisibilityDistance() : GetVisibilityDistance());
+    CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), radius);
 
-    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    // player cells with their distance to the nearest player, only for the update level of detail
+    if (playerView && sWorld.getConfig(CONFIG_BOOL_UPDATE_LOD))
     {
-        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        CellPair center = MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
+        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+        {
+            for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+            {
+                uint8 distance = uint8(std::max(std::abs(int32(x) - int32(center.x_coord)), std::abs(int32(y) - int32(center.y_coord))));
+                auto itr = m_updateLODCells.emplace((y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x, distance).first;
+                itr->second = std::min(itr->second, distance);
+            }
+        }
+    }
+
+    auto result = m_activeCellSources.emplace(obj->GetObjectGuid(), ActiveCellSource{ area, m_activeCellGeneration });
+    if (result.second)
+    {
+        ChangeActiveCellRefs(area, 1);
+        return;
+    }
+
+    ActiveCellSource& source = result.first->second;
+
+    // seen twice in this update (active object watched through far sight), cover both areas
+    if (source.generation == m_activeCellGeneration)
+    {
+        area.low_bound.x_coord = std::min(area.low_bound.x_coord, source.area.low_bound.x_coord);
+        area.low_bound.y_coord = std::min(area.low_bound.y_coord, source.area.low_bound.y_coord);
+        area.high_bound.x_coord = std::max(area.high_bound.x_coord, source.area.high_bound.x_coord);
+        area.high_bound.y_coord = std::max(area.high_bound.y_coord, source.area.high_bound.y_coord);
+    }
+
+    source.generation = m_activeCellGeneration;
+
+    // still within the same cells, the common case
+    if (area.low_bound == source.area.low_bound && area.high_bound == source.area.high_bound)
+        return;
+
+    ChangeActiveCellRefs(area, 1);
+    ChangeActiveCellRefs(source.area, -1);
+    source.area = area;
+}
+
+void Map::ChangeActiveCellRefs(CellArea const& area, int32 change)
+{
+    for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+    {
+        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
         {
-            // marked cells are those that have been visited
-            // don't visit the same cell twice
             uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-            if (!isCellMarked(cell_id))
+            if (change > 0)
             {
-                markCell(cell_id);
-                CellPair pair(x, y);
-                Cell cell(pair);
-                cell.SetNoCreate();
-                Visit(cell, gridVisitor);
-                Visit(cell, worldVisitor);
+                if (++m_activeCellRefs[cell_id] == 1)
+                    m_activeCells.insert(std::lower_bound(m_activeCells.begin(), m_activeCells.end(), cell_id), cell_id);
+            }
+            else
+            {
+                auto itr = m_activeCellRefs.find(cell_id);
+                if (itr == m_activeCellRefs.end() || --itr->second != 0)
+                    continue;
+
+                m_activeCellRefs.erase(itr);
+                m_activeCells.erase(std::lower_bound(m_activeCells.begin(), m_activeCells.end(), cell_id));
             }
         }
     }
 }
 
+uint32 Map::GetUpdateLODInterval(WorldObject const* obj) const
+{
+    CellPair pair = MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
+    auto itr = m_updateLODCells.find((pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + pair.x_coord);
+
+    // only kept alive by a non player active object
+    if (itr == m_updateLODCells.end())
+        return sWorld.getConfig(CONFIG_UINT32_UPDATE_LOD_NO_PLAYER_INTERVAL);
+
+    // the player's cell and its neighbours cover melee, aggro and most spell ranges
+    if (itr->second <= 1)
+        return 0;
+
+    return sWorld.getConfig(CONFIG_UINT32_UPDATE_LOD_FAR_INTERVAL);
+}
+
 void Map::Update(const uint32& t_diff)
 {
 
@@ -754,13 +944,16 @@ void Map::Update(const uint32& t_diff)
 
     m_dyn_tree.update(t_diff);
 
+    if (sTerrainStreamer.IsEnabled() && IsContinent())
+    {
+        sTerrainStreamer.PublishPrepared(GetId(), GetInstanceId());
+        UpdateTerrainStreaming(t_diff);
+    }
+
     GetMessager().Execute(this);
     m_spawnManager.Update();
 
-    /// update active cells around players and active objects
-    resetMarkedCells();
-
-    WorldObjectUnSet objToUpdate;
+    WorldObjectVector objToUpdate;
     MaNGOS::ObjectUpdater obj_updater(objToUpdate, t_diff);
     TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(obj_updater);    // For creature
     TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(obj_updater);   // For pets
@@ -809,69 +1002,50 @@ void Map::Update(const uint32& t_diff)
             plr->Update(t_diff);
     }
 
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    /// update active cells around players and active objects, in cell order
+    UpdateActiveCells();
+    for (uint32 cell_id : m_activeCells)
     {
-        Player* player = m_mapRefIter->getSource();
-        if (!player->IsInWorld() || !player->IsPositionValid())
-            continue;
-
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
-
-        // If player is using far sight, visit that object too
-        if (WorldObject* viewPoint = GetWorldObject(player->GetFarSightGuid()))
-            VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
+        CellPair pair(cell_id % TOTAL_NUMBER_OF_CELLS_PER_MAP, cell_id / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+        Cell cell(pair);
+        cell.SetNoCreate();
+        Visit(cell, grid_object_update);
+        Visit(cell, world_object_update);
     }
 
-    // non-player active objects
-    if (!m_activeNonPlayers.empty())
+    // update all objects, idle creatures away from players only every few updates with the diff summed up
+    bool updateLOD = sWorld.getConfig(CONFIG_BOOL_UPDATE_LOD);
+    uint64 lodUpdated = 0;
+    uint64 lodSkipped = 0;
+    for (auto wObj : objToUpdate)
     {
-        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+        uint32 diff = t_diff;
+        if (updateLOD && wObj->GetTypeId() == TYPEID_UNIT)
         {
-            // skip not in world
-            WorldObject* obj = *m_activeNonPlayersIter;
-
-            // step before processing, in this case if Map::Remove remove next object we correctly
-            // step to next-next, and if we step to end() then newly added objects can wait next update.
-            ++m_activeNonPlayersIter;
-
-            if (!obj->IsInWorld() || !obj->IsPositionValid())
-                continue;
-
-            objToUpdate.insert(obj);
-
-            // lets update mobs/objects in ALL visible cells around player!
-            CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
-
-            for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+            if (!static_cast<Creature*>(wObj)->UpdateLOD(diff, GetUpdateLODInterval(wObj)))
             {
-                for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
-                {
-                    // marked cells are those that have been visited
-                    // don't visit the same cell twice
-                    uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                    if (!isCellMarked(cell_id))
-                    {
-                        markCell(cell_id);
-                        CellPair pair(x, y);
-                        Cell cell(pair);
-                        cell.SetNoCreate();
-                        Visit(cell, grid_object_update);
-                        Visit(cell, world_object_update);
-                    }
-                }
+                ++lodSkipped;
+                continue;
             }
+            ++lodUpdated;
         }
+
+        wObj->Update(diff);
+        ++count;
     }
 
-    // update all objects
-    for (auto wObj : objToUpdate)
+    if (updateLOD)
     {
-        wObj->Update(t_diff);
-        ++count;
+        m_updateLODStats.updated += lodUpdated;
+        m_updateLODStats.skipped += lodSkipped;
+        ++m_updateLODStats.ticks;
     }
 
+    ProcessRelocationNotifies();
+
 #ifdef BUILD_METRICS
     meas.add_field("count", std::to_string(static_cast<int32>(count)));
+    meas.add_field("lod_skipped", std::to_string(static_cast<int32>(lodSkipped)));
 #endif
 
     // Send world objects and item update field changes
@@ -886,6 +1060,10 @@ void Map::Update(const uint32& t_diff)
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
     if (!IsBattleGroundOrArena())
     {
+        // spread unloading a large area over several updates
+        uint32 maxGridUnloads = sWorld.getConfig(CONFIG_UINT32_GRID_UNLOAD_MAX_PER_UPDATE);
+        m_gridUnloadBudget = maxGridUnloads ? maxGridUnloads : std::numeric_limits<uint32>::max();
+
         for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
         {
             NGridType* grid = i->getSource();
@@ -1042,6 +1220,64 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
     }
 }
 
+void Map::AddRelocationNotify(Unit* unit, uint8 notifyFlags)
+{
+    ++m_relocationNotifyStats.requested;
+
+    auto result = m_relocationNotifies.emplace(unit->GetObjectGuid(), notifyFlags);
+    if (!result.second)
+    {
+        result.first->second |= notifyFlags;
+        ++m_relocationNotifyStats.merged;
+    }
+}
+
+void Map::ProcessRelocationNotifies()
+{
+    if (m_relocationNotifies.empty())
+        return;
+
+    struct PendingNotify
+    {
+        uint32 cellId;
+        ObjectGuid guid;
+        uint8 flags;
+    };
+
+    // notifications raised while processing wait for the next update
+    std::vector<PendingNotify> pending;
+    pending.reserve(m_relocationNotifies.size());
+    for (auto const& itr : m_relocationNotifies)
+    {
+        Unit* unit = GetUnit(itr.first);
+        if (!unit || !unit->IsInWorld())
+            continue;
+
+        CellPair p = MaNGOS::ComputeCellPair(unit->GetPositionX(), unit->GetPositionY());
+        pending.push_back({ p.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + p.x_coord, itr.first, itr.second });
+    }
+    m_relocationNotifies.clear();
+
+    // units of the same cells visit the same cells around them, keep them together
+    std::sort(pending.begin(), pending.end(), [](PendingNotify const& left, PendingNotify const& right) { return left.cellId < right.cellId; });
+
+    for (PendingNotify const& notify : pending)
+    {
+        // earlier notifications can have removed it
+        Unit* unit = GetUnit(notify.guid);
+        if (!unit || !unit->IsInWorld())
+            continue;
+
+        if (notify.flags & RELOCATION_NOTIFY_VISIBILITY)
+            unit->UpdateRelocationVisibility();
+        if (notify.flags & RELOCATION_NOTIFY_AI)
+            unit->VisitObjectsInRangeForAI();
+    }
+
+    m_relocationNotifyStats.processed += pending.size();
+    ++m_relocationNotifyStats.batches;
+}
+
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang)
 {
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
@@ -1183,6 +1419,8 @@ bool Map::UnloadGrid(const uint32& x, const uint32& y, bool pForce)
     NGridType* grid = getNGrid(x, y);
     MANGOS_ASSERT(grid != nullptr);
 
+    auto unloadStart = std::chrono::steady_clock::now();
+
     {
         if (!pForce && ActiveObjectsNearGrid(x, y))
             return false;
@@ -1211,8 +1449,10 @@ bool Map::UnloadGrid(const uint32& x, const uint32& y, bool pForce)
         // wouldn't actually be removed because the grid is already unloaded.
         RemoveAllObjectsInRemoveList();
 
-        delete getNGrid(x, y);
+        // the emptied grid is freed in the background
+        grid->unlink();
         setNGrid(nullptr, x, y);
+        sMapMgr.QueueGridTeardown(grid);
     }
 
     int gx = (MAX_NUMBER_OF_GRIDS - 1) - x;
@@ -1226,7 +1466,14 @@ bool Map::UnloadGrid(const uint32& x, const uint32& y, bool pForce)
         m_TerrainData->Unload(gx, gy);
     }
 
-    DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Unloading grid[%u,%u] for map %u finished", x, y, i_id);
+    GridStateStats& stats = MapManager::GetGridStateStats();
+    uint64 unloadTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - unloadStart).count();
+    ++stats.unloaded;
+    stats.unloadTime += unloadTime;
+    uint64 maxUnloadTime = stats.maxUnloadTime;
+    while (unloadTime > maxUnloadTime && !stats.maxUnloadTime.compare_exchange_weak(maxUnloadTime, unloadTime));
+
+    DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Unloading grid[%u,%u] for map %u finished in " UI64FMTD " us", x, y, i_id, unloadTime);
     return true;
 }
 
@@ -2202,6 +2449,12 @@ bool Map::ScriptsStart(ScriptMapType scriptType, uint32 id, Object* source, Obje
 {
     MANGOS_ASSERT(source);
 
+    // scripts run on the map, but their source or target may be waiting for its update
+    if (source->GetTypeId() == TYPEID_UNIT)
+        static_cast<Creature*>(source)->PromoteUpdateLOD();
+    if (target && target->GetTypeId() == TYPEID_UNIT)
+        static_cast<Creature*>(target)->PromoteUpdateLOD();
+
     ///- Find the script map
     auto scriptMapMap = GetMapDataContainer().GetScriptMap(scriptType);
     ScriptMapMap::const_iterator scriptInfoMapMapItr = scriptMapMap->second.find(id);
@@ -2704,6 +2957,8 @@ void Map::PlayDirectSoundToMap(uint32 soundId, uint32 zoneId /*=0*/) const
  */
 bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, uint32 phasemask, bool ignoreM2Model) const
 {
+    TerrainQueryRecorder traceQuery(TERRAIN_QUERY_LOS, GetId(), srcX, srcY, srcZ, destX, destY, destZ, 0.0f, ignoreM2Model);
+
     return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model)
            && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask, ignoreM2Model);
 }
@@ -41,6 +41,7 @@
 #include "Util/UniqueTrackablePtr.h"
 #include "World/WorldStateVariableManager.h"
 
+#include <atomic>
 #include <bitset>
 #include <functional>
 #include <list>
@@ -122,6 +123,36 @@ struct ZoneDynamicInfo
 
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
 
+// work queued for a unit by Map::AddRelocationNotify
+enum RelocationNotifyFlags
+{
+    RELOCATION_NOTIFY_VISIBILITY    = 0x01,                 // Unit::UpdateRelocationVisibility
+    RELOCATION_NOTIFY_AI            = 0x02,                 // Unit::VisitObjectsInRangeForAI
+};
+
+struct RelocationNotifyStats
+{
+    std::atomic<uint64> requested{0};                       // notifications queued
+    std::atomic<uint64> merged{0};                          // of those, merged into one already pending for the unit
+    std::atomic<uint64> processed{0};                       // units processed by batches
+    std::atomic<uint64> batches{0};
+};
+
+struct UpdateLODStats
+{
+    std::atomic<uint64> updated{0};                         // creatures updated in active cells
+    std::atomic<uint64> skipped{0};                         // updates skipped for distance, diff is carried over
+    std::atomic<uint64> promoted{0};                        // skipping creatures updated early by combat, damage, auras or scripts
+    std::atomic<uint64> ticks{0};                           // map updates, for the average per update
+};
+
+struct EventAIUpdateStats
+{
+    std::atomic<uint64> updates{0};                         // event timer updates of EventAI creatures
+    std::atomic<uint64> events{0};                          // timer driven events looked at by those
+    std::atomic<uint64> updateTime{0};                      // ns spent in them, actions they started included
+};
+
 typedef std::unordered_map<uint32 /*zoneId*/, ZoneDynamicInfo> ZoneDynamicInfoMap;
 
 class Map : public GridRefManager<NGridType>
@@ -154,7 +185,6 @@ class Map : public GridRefManager<NGridType>
 
         static void DeleteFromWorld(Player* pl);        // player object will deleted at call
 
-        void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(const uint32&);
 
         void MessageBroadcast(Player const*, WorldPacket const&, bool to_self);
@@ -180,6 +210,9 @@ class Map : public GridRefManager<NGridType>
         void DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float z, float orientation);
 
         template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor);
+        template<class T> void Visit(const Cell& cell, CellIndexVisitor<T>& visitor);
+        // object index of the cell, loads its grid unless the cell is no create - nullptr if not loaded
+        CellObjectIndex const* GetCellIndex(const Cell& cell);
 
         bool IsRemovalGrid(float x, float y) const
         {
@@ -198,6 +231,14 @@ class Map : public GridRefManager<NGridType>
         void ForceLoadGrid(float x, float y);
         bool UnloadGrid(const uint32& x, const uint32& y, bool pForce);
         virtual void UnloadAll(bool pForce);
+        // false once GridUnload.MaxPerUpdate grids were unloaded in this update, the rest wait for the next ones
+        bool TakeGridUnloadBudget()
+        {
+            if (!m_gridUnloadBudget)
+                return false;
+            --m_gridUnloadBudget;
+            return true;
+        }
 
         void ResetGridExpiry(NGridType& grid, float factor = 1) const
         {
@@ -260,9 +301,8 @@ class Map : public GridRefManager<NGridType>
 
         void UpdateObjectVisibility(WorldObject* obj, Cell cell, const CellPair& cellpair);
 
-        void resetMarkedCells() { marked_cells.reset(); }
-        bool isCellMarked(uint32 pCellId) const { return marked_cells.test(pCellId); }
-        void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
+        // ids of the cells around players and active objects, ascending - row by row, so slices of it are compact regions
+        std::vector<uint32> const& GetActiveCells() const { return m_activeCells; }
 
         bool HavePlayers() const { return !m_mapRefManager.isEmpty(); }
         uint32 GetPlayersCountExceptGMs() const;
@@ -341,6 +381,16 @@ class Map : public GridRefManager<NGridType>
             i_objectsToClientUpdate.erase(obj);
         }
 
+        // relocation notifications are collected during the update and done once per unit in ProcessRelocationNotifies
+        void AddRelocationNotify(Unit* unit, uint8 notifyFlags);
+        static RelocationNotifyStats const& GetRelocationNotifyStats() { return m_relocationNotifyStats; }
+
+        // creatures far from players are updated less often, 0 for every update
+        uint32 GetUpdateLODInterval(WorldObject const* obj) const;
+        static UpdateLODStats& GetUpdateLODStats() { return m_updateLODStats; }
+
+        EventAIUpdateStats& GetEventAIUpdateStats() { return m_eventAIUpdateStats; }
+
         // DynObjects currently
         uint32 GenerateLocalLowGuid(HighGuid guidhigh);
 
@@ -445,6 +495,11 @@ class Map : public GridRefManager<NGridType>
 
     private:
         void LoadMapAndVMap(int gx, int gy);
+        // requests grids players are heading for from the terrain streamer
+        void UpdateTerrainStreaming(uint32 diff);
+        void RequestTerrainStreamingAt(float x, float y);
+
+        void ProcessRelocationNotifies();
 
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
 
@@ -509,6 +564,7 @@ class Map : public GridRefManager<NGridType>
         GraveyardManager m_graveyardManager;
     private:
         time_t i_gridExpiry;
+        uint32 m_gridUnloadBudget;
         time_t m_curTime;
         tm m_curTimeTm;
 
@@ -518,7 +574,20 @@ class Map : public GridRefManager<NGridType>
         TerrainInfo* const m_TerrainData;
         bool m_bLoadedGrids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
-        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        // active cells, changed only where the areas of players and active objects moved
+        struct ActiveCellSource
+        {
+            CellArea area;
+            uint32 generation;                              // last update the source was seen in
+        };
+        void UpdateActiveCells();
+        void SetActiveCellSource(WorldObject* obj, float radius, bool playerView);
+        void ChangeActiveCellRefs(CellArea const& area, int32 change);
+
+        std::unordered_map<ObjectGuid, ActiveCellSource> m_activeCellSources;
+        std::unordered_map<uint32 /*cell_id*/, uint32> m_activeCellRefs;    // number of source areas covering the cell
+        std::vector<uint32> m_activeCells;
+        uint32 m_activeCellGeneration;
 
         WorldObjectSet i_objectsToRemove;
 
@@ -548,6 +617,20 @@ class Map : public GridRefManager<NGridType>
         // Dynamic Map tree object
         DynamicMapTree m_dyn_tree;
 
+        // player positions of the last terrain streaming pass, for velocity estimation
+        ShortIntervalTimer m_terrainStreamingTimer;
+        std::unordered_map<ObjectGuid, Position> m_terrainStreamingSamples;
+
+        // pending relocation notifications of this update, RelocationNotifyFlags by unit
+        std::unordered_map<ObjectGuid, uint8> m_relocationNotifies;
+        static RelocationNotifyStats m_relocationNotifyStats;
+
+        // cells around players of this update with their distance in cells to the nearest one
+        std::unordered_map<uint32 /*cell_id*/, uint8> m_updateLODCells;
+        static UpdateLODStats m_updateLODStats;
+
+        EventAIUpdateStats m_eventAIUpdateStats;
+
         // WeatherSystem
         WeatherSystem* m_weatherSystem;
 
@@ -666,4 +749,25 @@ Map::Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor)
         getNGrid(x, y)->Visit(cell_x, cell_y, visitor);
     }
 }
+
+template<class T>
+inline void
+Map::Visit(const Cell& cell, CellIndexVisitor<T>& visitor)
+{
+    if (CellObjectIndex const* index = GetCellIndex(cell))
+        visitor.Visit(*index);
+}
+
+inline CellObjectIndex const* Map::GetCellIndex(const Cell& cell)
+{
+    const uint32 x = cell.GridX();
+    const uint32 y = cell.GridY();
+
+    if (!cell.NoCreate() || loaded(GridPair(x, y)))
+    {
+        EnsureGridLoaded(cell);
+        return &(*getNGrid(x, y))(cell.CellX(), cell.CellY()).GetIndex();
+    }
+    return nullptr;
+}
 #endif
@@ -27,12 +27,16 @@
 #include "Grids/CellImpl.h"
 #include "Globals/ObjectMgr.h"
 #include "Maps/MapWorkers.h"
+#include "Maps/TerrainStreamer.h"
+#include <chrono>
 #include <future>
 
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex>
 INSTANTIATE_SINGLETON_2(MapManager, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(MapManager, std::recursive_mutex);
 
+GridStateStats MapManager::m_gridStateStats;
+
 MapManager::MapManager()
     : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN))
 {
@@ -74,13 +78,54 @@ void MapManager::DeleteStateMachine()
 
 void MapManager::UpdateGridState(grid_state_t state, Map& map, NGridType& ngrid, GridInfo& ginfo, const uint32& x, const uint32& y, const uint32& t_diff)
 {
-    // TODO: The grid state array itself is static and therefore 100% safe, however, the data
-    // the state classes in it accesses is not, since grids are shared across maps (for example
-    // in instances), so some sort of locking will be necessary later.
-
+    // The grid state array itself is static and the NGrids belong to the updating map. The terrain
+    // tiles shared between maps (for example by instances) are reference counted under TerrainInfo's lock.
     si_GridStates[state]->Update(map, ngrid, ginfo, x, y, t_diff);
 }
 
+void MapManager::QueueGridTeardown(NGridType* grid)
+{
+    std::lock_guard<std::mutex> guard(m_teardownLock);
+    m_teardown.grids.push_back(grid);
+}
+
+void MapManager::QueueGridTeardown(GridMap* gridMap)
+{
+    std::lock_guard<std::mutex> guard(m_teardownLock);
+    m_teardown.gridMaps.push_back(gridMap);
+}
+
+void MapManager::ExecuteGridTeardown(GridTeardown& teardown)
+{
+    auto teardownStart = std::chrono::steady_clock::now();
+
+    for (NGridType* grid : teardown.grids)
+        delete grid;
+
+    for (GridMap* gridMap : teardown.gridMaps)
+        delete gridMap;
+
+    m_gridStateStats.teardowns += teardown.grids.size() + teardown.gridMaps.size();
+    m_gridStateStats.teardownTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - teardownStart).count();
+}
+
+void MapManager::ScheduleGridTeardown()
+{
+    GridTeardown teardown;
+    {
+        std::lock_guard<std::mutex> guard(m_teardownLock);
+        if (m_teardown.grids.empty() && m_teardown.gridMaps.empty())
+            return;
+
+        std::swap(teardown, m_teardown);
+    }
+
+    if (m_updater.activated())
+        m_updater.schedule_update(new GridTeardownWorker([teardown = std::move(teardown)]() mutable { ExecuteGridTeardown(teardown); }, m_updater));
+    else
+        ExecuteGridTeardown(teardown);
+}
+
 void MapManager::InitializeVisibilityDistanceInfo()
 {
     for (auto& i_map : i_maps)
@@ -196,6 +241,9 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
+    // grids and terrain tiles unloaded during the last update are freed alongside the map updates
+    ScheduleGridTeardown();
+
     for (auto& map : i_maps)
     {
         if (m_updater.activated())
@@ -250,13 +298,22 @@ bool MapManager::IsValidMAP(uint32 mapid)
 
 void MapManager::UnloadAll()
 {
+    // stop background terrain reads and drop their model references first
+    sTerrainStreamer.Shutdown();
+
     for (auto& i_map : i_maps)
         i_map.second->UnloadAll(true);
 
     i_maps.clear();
 
     if (m_updater.activated())
+    {
+        m_updater.wait();
         m_updater.deactivate();
+    }
+
+    ExecuteGridTeardown(m_teardown);
+    m_teardown = GridTeardown();
 
     TerrainManager::Instance().UnloadAll();
 }
@@ -28,6 +28,7 @@
 #include "Maps/MapUpdater.h"
 #include "Util/UniqueTrackablePtr.h"
 
+#include <atomic>
 #include <functional>
 
 class Transport;
@@ -53,6 +54,24 @@ struct MapID
     uint32 nInstanceId;
 };
 
+// process wide counters of grid loads and state transitions, exported through .debug perf gridstate and metrics
+struct GridStateStats
+{
+    std::atomic<uint64> loaded{0};              // grids whose objects were loaded
+    std::atomic<uint64> loadedObjects{0};       // creatures, gameobjects and corpses of those grids
+    std::atomic<uint64> loadTime{0};            // microseconds on the map threads
+    std::atomic<uint64> maxLoadTime{0};         // microseconds, slowest single grid load
+    std::atomic<uint64> idled{0};               // active grids left without players or active objects nearby
+    std::atomic<uint64> unloaded{0};            // grids detached from their map
+    std::atomic<uint64> unloadsDeferred{0};     // unloads pushed to a later map update by GridUnload.MaxPerUpdate
+    std::atomic<uint64> unloadsRefused{0};      // unloads cancelled for players or active objects nearby
+    std::atomic<uint64> unloadTime{0};          // microseconds on the map threads
+    std::atomic<uint64> maxUnloadTime{0};       // microseconds, slowest single grid unload
+    std::atomic<uint64> tilesReleased{0};       // terrain tiles no map referenced anymore
+    std::atomic<uint64> teardowns{0};           // unloaded grids and terrain tiles freed in the background
+    std::atomic<uint64> teardownTime{0};        // microseconds on the map update threads
+};
+
 class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex> >
 {
         friend class MaNGOS::OperatorNew<MapManager>;
@@ -71,6 +90,11 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         void UpdateGridState(grid_state_t state, Map& map, NGridType& ngrid, GridInfo& ginfo, const uint32& x, const uint32& y, const uint32& t_diff);
 
+        // memory of unloaded grids and unreferenced terrain tiles, freed next to the next map updates
+        void QueueGridTeardown(NGridType* grid);
+        void QueueGridTeardown(GridMap* gridMap);
+        static GridStateStats& GetGridStateStats() { return m_gridStateStats; }
+
         // only const version for outer users
         void DeleteInstance(uint32 mapid, uint32 instanceId);
 
@@ -179,6 +203,14 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         void InitStateMachine();
         void DeleteStateMachine();
 
+        struct GridTeardown
+        {
+            std::vector<NGridType*> grids;
+            std::vector<GridMap*> gridMaps;
+        };
+        static void ExecuteGridTeardown(GridTeardown& teardown);
+        void ScheduleGridTeardown();
+
         Map* CreateInstance(uint32 id, Player* player);
         DungeonMap* CreateDungeonMap(uint32 id, uint32 InstanceId, Difficulty difficulty, DungeonPersistentState* save, Team ownerTeam);
         BattleGroundMap* CreateBattleGroundMap(uint32 id, uint32 InstanceId, BattleGround* bg);
@@ -189,6 +221,11 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         IntervalTimer i_timer;
 
         MapUpdater m_updater;
+
+        std::mutex m_teardownLock;                          // grids are unloaded by all map threads
+        GridTeardown m_teardown;
+
+        static GridStateStats m_gridStateStats;
 };
 
 template<typename Do>
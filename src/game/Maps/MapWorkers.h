@@ -26,6 +26,8 @@
 #include "Entities/Object.h"
 #include "Platform/Define.h"
 
+#include <functional>
+
 class Worker
 {
     public:
@@ -58,6 +60,23 @@ class MapUpdateWorker : public Worker
         uint32 m_diff;
 };
 
+class GridTeardownWorker : public Worker
+{
+    public:
+        GridTeardownWorker(std::function<void()>&& teardown, MapUpdater& updater) :
+            Worker(updater), m_teardown(std::move(teardown))
+        {}
+
+        void execute() override
+        {
+            m_teardown();
+            GetWorker().update_finished();
+        }
+
+    private:
+        std::function<void()> m_teardown;
+};
+
 class GridCrawler : public Worker
 {
     public:
@@ -67,7 +86,7 @@ class GridCrawler : public Worker
 
         void execute() override
         {
-            WorldObjectUnSet objToUpdate;
+            WorldObjectVector objToUpdate;
             MaNGOS::ObjectUpdater obj_updater(objToUpdate, m_diff);
             TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(obj_updater);    // For creature
             TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(obj_updater);   // For pets
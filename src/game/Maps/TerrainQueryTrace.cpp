@@ -0,0 +1,130 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/TerrainQueryTrace.h"
+#include "Log/Log.h"
+
+static char const TERRAIN_QUERY_TRACE_HEADER[] = "# terrain query trace 1";
+// order of TerrainQueryType
+static char const TERRAIN_QUERY_TYPE_CHARS[MAX_TERRAIN_QUERY_TYPE + 1] = "HLAWP";
+
+std::atomic<bool> TerrainQueryTrace::m_recording(false);
+std::mutex TerrainQueryTrace::m_lock;
+FILE* TerrainQueryTrace::m_file = nullptr;
+uint32 TerrainQueryTrace::m_remaining = 0;
+
+thread_local bool TerrainQueryRecorder::m_inQuery = false;
+
+bool TerrainQueryTrace::Start(std::string const& filename, uint32 maxQueries)
+{
+    Stop();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_file = fopen(filename.c_str(), "w");
+    if (!m_file)
+    {
+        sLog.outError("TerrainQueryTrace: can't open %s for writing", filename.c_str());
+        return false;
+    }
+
+    fprintf(m_file, "%s\n", TERRAIN_QUERY_TRACE_HEADER);
+    m_remaining = maxQueries;
+    m_recording = true;
+    sLog.outString("Recording up to %u terrain queries to %s", maxQueries, filename.c_str());
+    return true;
+}
+
+void TerrainQueryTrace::Stop()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_recording = false;
+    if (m_file)
+    {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+void TerrainQueryTrace::Record(TerrainQuery const& query)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (!m_file)
+        return;
+
+    fprintf(m_file, "%c %u %.3f %.3f %.3f %.3f %.3f %.3f %.3f %u\n", TERRAIN_QUERY_TYPE_CHARS[query.type], query.mapId,
+            query.x, query.y, query.z, query.destX, query.destY, query.destZ, query.param, query.flags);
+
+    if (--m_remaining == 0)
+    {
+        m_recording = false;
+        fclose(m_file);
+        m_file = nullptr;
+        sLog.outString("Terrain query trace complete");
+    }
+}
+
+bool TerrainQueryTrace::Read(std::string const& filename, std::vector<TerrainQuery>& queries)
+{
+    FILE* file = fopen(filename.c_str(), "r");
+    if (!file)
+        return false;
+
+    char line[256];
+    uint32 lineNumber = 0;
+    while (fgets(line, sizeof(line), file))
+    {
+        ++lineNumber;
+        if (line[0] == '#' || line[0] == '\n')
+            continue;
+
+        char typeChar;
+        TerrainQuery query;
+        if (sscanf(line, "%c %u %f %f %f %f %f %f %f %u", &typeChar, &query.mapId, &query.x, &query.y, &query.z,
+                   &query.destX, &query.destY, &query.destZ, &query.param, &query.flags) != 10)
+        {
+            sLog.outError("TerrainQueryTrace: malformed line %u in %s", lineNumber, filename.c_str());
+            continue;
+        }
+
+        char const* typePos = strchr(TERRAIN_QUERY_TYPE_CHARS, typeChar);
+        if (!typePos || !typeChar)
+        {
+            sLog.outError("TerrainQueryTrace: unknown query type '%c' in line %u of %s", typeChar, lineNumber, filename.c_str());
+            continue;
+        }
+
+        query.type = TerrainQueryType(typePos - TERRAIN_QUERY_TYPE_CHARS);
+        queries.push_back(query);
+    }
+
+    fclose(file);
+    return true;
+}
+
+char const* TerrainQueryTrace::GetTypeName(TerrainQueryType type)
+{
+    switch (type)
+    {
+        case TERRAIN_QUERY_HEIGHT: return "height";
+        case TERRAIN_QUERY_LOS:    return "los";
+        case TERRAIN_QUERY_AREA:   return "area";
+        case TERRAIN_QUERY_LIQUID: return "liquid";
+        case TERRAIN_QUERY_PATH:   return "path";
+        default:                   return "unknown";
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_TERRAIN_QUERY_TRACE_H
+#define MANGOS_TERRAIN_QUERY_TRACE_H
+
+#include "Common.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum TerrainQueryType
+{
+    TERRAIN_QUERY_HEIGHT    = 0,                            // TerrainInfo::GetHeightStatic
+    TERRAIN_QUERY_LOS       = 1,                            // Map::IsInLineOfSight
+    TERRAIN_QUERY_AREA      = 2,                            // TerrainInfo::GetAreaFlag
+    TERRAIN_QUERY_LIQUID    = 3,                            // TerrainInfo::getLiquidStatus
+    TERRAIN_QUERY_PATH      = 4,                            // PathFinder::calculate
+    MAX_TERRAIN_QUERY_TYPE
+};
+
+struct TerrainQuery
+{
+    TerrainQueryType type;
+    uint32 mapId;
+    float x, y, z;
+    float destX, destY, destZ;                              // los and path only
+    float param;                                            // max search distance (height), collision height (liquid)
+    uint32 flags;                                           // use vmaps (height), ignore m2 (los), required liquid type (liquid), straight line (path)
+};
+
+/**
+ * Records terrain queries issued by the server to a text file, one query per line, for replay by
+ * contrib/terrain_bench. Queries issued from within another recorded query are not recorded again,
+ * replaying the outer one repeats them.
+ */
+class TerrainQueryTrace
+{
+    public:
+        // starts recording to filename, stops by itself after maxQueries
+        static bool Start(std::string const& filename, uint32 maxQueries);
+        static void Stop();
+        static bool IsRecording() { return m_recording.load(std::memory_order_relaxed); }
+
+        static bool Read(std::string const& filename, std::vector<TerrainQuery>& queries);
+        static char const* GetTypeName(TerrainQueryType type);
+
+    private:
+        friend class TerrainQueryRecorder;
+
+        static void Record(TerrainQuery const& query);
+
+        static std::atomic<bool> m_recording;
+        static std::mutex m_lock;
+        static FILE* m_file;
+        static uint32 m_remaining;
+};
+
+// records its query if tracing is enabled and it is not nested in another recorded query
+class TerrainQueryRecorder
+{
+    public:
+        TerrainQueryRecorder(TerrainQueryType type, uint32 mapId, float x, float y, float z, float destX, float destY, float destZ, float param, uint32 flags) : m_nested(true)
+        {
+            if (!TerrainQueryTrace::IsRecording() || m_inQuery)
+                return;
+
+            TerrainQueryTrace::Record({ type, mapId, x, y, z, destX, destY, destZ, param, flags });
+            m_inQuery = true;
+            m_nested = false;
+        }
+
+        ~TerrainQueryRecorder()
+        {
+            if (!m_nested)
+                m_inQuery = false;
+        }
+
+    private:
+        bool m_nested;
+        static thread_local bool m_inQuery;
+};
+
+#endif
@@ -0,0 +1,276 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/TerrainStreamer.h"
+#include "Log/Log.h"
+#include "World/World.h"
+#include "MotionGenerators/MoveMap.h"
+#include "Vmap/VMapFactory.h"
+#include "Vmap/VMapManager2.h"
+#include "Util/Timer.h"
+
+#define CLASS_LOCK MaNGOS::ClassLevelLockable<TerrainStreamer, std::mutex>
+INSTANTIATE_SINGLETON_2(TerrainStreamer, CLASS_LOCK);
+INSTANTIATE_CLASS_MUTEX(TerrainStreamer, std::mutex);
+
+// prepared grids not loaded by their map within this time are dropped again
+static const uint32 TERRAIN_STREAMING_EXPIRE_TIME = 60 * IN_MILLISECONDS;
+
+TerrainStreamerStats TerrainStreamer::m_stats;
+
+TerrainStreamer::TerrainStreamer() : m_enabled(false), m_lookahead(0), m_maxPending(0), m_stop(false)
+{
+}
+
+TerrainStreamer::~TerrainStreamer()
+{
+    Shutdown();
+}
+
+void TerrainStreamer::Initialize()
+{
+    m_enabled = sWorld.getConfig(CONFIG_BOOL_TERRAIN_STREAMING);
+    m_lookahead = sWorld.getConfig(CONFIG_UINT32_TERRAIN_STREAMING_LOOKAHEAD);
+    m_maxPending = sWorld.getConfig(CONFIG_UINT32_TERRAIN_STREAMING_MAX_PENDING);
+
+    if (!m_enabled || m_ioThread.joinable())
+        return;
+
+    m_stop = false;
+    m_ioThread = std::thread(&TerrainStreamer::IoThread, this);
+    sLog.outString("Terrain streaming enabled (lookahead %u ms, %u grids max pending)", m_lookahead, m_maxPending);
+}
+
+void TerrainStreamer::Shutdown()
+{
+    m_enabled = false;
+
+    if (m_ioThread.joinable())
+    {
+        m_stop = true;
+        m_queue.Cancel();
+        m_ioThread.join();
+    }
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    for (auto& grid : m_grids)
+        ReleaseGrid(grid.second);
+    m_grids.clear();
+}
+
+void TerrainStreamer::RequestGrid(uint32 mapId, uint32 instanceId, uint32 gx, uint32 gy)
+{
+    if (!m_enabled)
+        return;
+
+    uint64 key = MakeKey(mapId, instanceId, gx, gy);
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_grids.size() >= m_maxPending || m_grids.find(key) != m_grids.end())
+            return;
+
+        PreparedGrid& grid = m_grids[key];
+        grid.mapId = mapId;
+        grid.instanceId = instanceId;
+        grid.gx = gx;
+        grid.gy = gy;
+        grid.requestTime = WorldTimer::getMSTime();
+    }
+
+    ++m_stats.requested;
+    m_queue.Push(std::move(key));
+}
+
+void TerrainStreamer::PublishPrepared(uint32 mapId, uint32 instanceId)
+{
+    struct NavTile { uint32 gx, gy; unsigned char* data; uint32 size; };
+    std::vector<NavTile> navTiles;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        for (auto& itr : m_grids)
+        {
+            PreparedGrid& grid = itr.second;
+            if (!grid.ready || !grid.navData || grid.mapId != mapId || grid.instanceId != instanceId)
+                continue;
+
+            navTiles.push_back({ grid.gx, grid.gy, grid.navData, grid.navDataSize });
+            grid.navData = nullptr;
+        }
+    }
+
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    for (NavTile const& tile : navTiles)
+    {
+        // loaded by the map meanwhile
+        if (mmap->IsMMapTileLoaded(mapId, instanceId, tile.gx, tile.gy))
+        {
+            dtFree(tile.data);
+            continue;
+        }
+
+        // takes ownership of data, also on failure
+        if (mmap->loadPreparedMap(mapId, instanceId, tile.gx, tile.gy, tile.data, tile.size))
+            ++m_stats.published;
+    }
+}
+
+void TerrainStreamer::OnGridLoaded(uint32 mapId, uint32 instanceId, uint32 gx, uint32 gy, uint64 loadTime)
+{
+    bool prefetched = false;
+    if (m_enabled)
+    {
+        PreparedGrid grid;
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            auto itr = m_grids.find(MakeKey(mapId, instanceId, gx, gy));
+            if (itr != m_grids.end())
+            {
+                // not ready yet - io thread finds the entry gone and drops its result
+                prefetched = itr->second.ready;
+                grid = std::move(itr->second);
+                m_grids.erase(itr);
+            }
+        }
+
+        // the map holds its own model references now
+        if (prefetched)
+            ReleaseGrid(grid);
+    }
+
+    if (prefetched)
+    {
+        ++m_stats.prefetchedLoads;
+        m_stats.prefetchedLoadTime += loadTime;
+    }
+    else
+    {
+        ++m_stats.lateLoads;
+        m_stats.lateLoadTime += loadTime;
+    }
+}
+
+void TerrainStreamer::Update()
+{
+    if (!m_enabled)
+        return;
+
+    std::vector<PreparedGrid> expiredGrids;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        uint32 now = WorldTimer::getMSTime();
+        for (auto itr = m_grids.begin(); itr != m_grids.end();)
+        {
+            if (itr->second.ready && WorldTimer::getMSTimeDiff(itr->second.requestTime, now) > TERRAIN_STREAMING_EXPIRE_TIME)
+            {
+                expiredGrids.push_back(std::move(itr->second));
+                itr = m_grids.erase(itr);
+            }
+            else
+                ++itr;
+        }
+    }
+
+    for (PreparedGrid& grid : expiredGrids)
+    {
+        ReleaseGrid(grid);
+        ++m_stats.expired;
+    }
+}
+
+void TerrainStreamer::IoThread()
+{
+    while (!m_stop)
+    {
+        uint64 key = 0;
+        m_queue.WaitAndPop(key);
+        if (m_stop)
+            return;
+
+        PrepareGrid(key);
+    }
+}
+
+void TerrainStreamer::PrepareGrid(uint64 key)
+{
+    PreparedGrid result;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        auto itr = m_grids.find(key);
+        if (itr == m_grids.end())
+            return;                                         // loaded by its map in the meantime
+
+        result.mapId = itr->second.mapId;
+        result.instanceId = itr->second.instanceId;
+        result.gx = itr->second.gx;
+        result.gy = itr->second.gy;
+    }
+
+    // .map - the grid map itself is cheap to build, only get the file into the os cache
+    char mapFileName[32];
+    snprintf(mapFileName, sizeof(mapFileName), "maps/%03u%02u%02u.map", result.mapId, result.gx, result.gy);
+    if (FILE* mapFile = fopen((sWorld.GetDataPath() + mapFileName).c_str(), "rb"))
+    {
+        char buffer[64 * 1024];
+        while (fread(buffer, 1, sizeof(buffer), mapFile) == sizeof(buffer));
+        fclose(mapFile);
+    }
+
+    // vmaps - load the models, the map tree picks them up by reference count
+    VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+    if (vmgr->isMapLoadingEnabled())
+        static_cast<VMAP::VMapManager2*>(vmgr)->prefetchTileModels((sWorld.GetDataPath() + "vmaps").c_str(), result.mapId, result.gx, result.gy, result.models);
+
+    // mmaps - whole tile, added to the navmesh by the map thread
+    if (MMAP::MMapFactory::IsPathfindingEnabled(result.mapId, nullptr))
+        result.navData = MMAP::MMapManager::readTileData(result.mapId, result.gx, result.gy, 0, result.navDataSize);
+
+    ++m_stats.prepared;
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        auto itr = m_grids.find(key);
+        if (itr != m_grids.end())
+        {
+            itr->second.ready = true;
+            itr->second.navData = result.navData;
+            itr->second.navDataSize = result.navDataSize;
+            itr->second.models = std::move(result.models);
+            return;
+        }
+    }
+
+    // grid got loaded while we were reading it
+    ReleaseGrid(result);
+}
+
+void TerrainStreamer::ReleaseGrid(PreparedGrid& grid)
+{
+    if (grid.navData)
+    {
+        dtFree(grid.navData);
+        grid.navData = nullptr;
+    }
+
+    if (!grid.models.empty())
+    {
+        VMAP::VMapManager2* vmgr = static_cast<VMAP::VMapManager2*>(VMAP::VMapFactory::createOrGetVMapManager());
+        for (std::string const& model : grid.models)
+            vmgr->releaseModelInstance(model);
+        grid.models.clear();
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_TERRAIN_STREAMER_H
+#define MANGOS_TERRAIN_STREAMER_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+#include "Util/ProducerConsumerQueue.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// process wide counters, exported through .mmap stats and metrics
+struct TerrainStreamerStats
+{
+    std::atomic<uint64> requested{0};           // grids queued for prefetch
+    std::atomic<uint64> prepared{0};            // grids read by the io thread
+    std::atomic<uint64> published{0};           // navmesh tiles handed over to a map before it needed them
+    std::atomic<uint64> expired{0};             // prepared grids never claimed by a map
+    std::atomic<uint64> prefetchedLoads{0};     // grid loads that found their data prepared
+    std::atomic<uint64> prefetchedLoadTime{0};  // microseconds
+    std::atomic<uint64> lateLoads{0};           // grid loads that had to read everything on the map thread
+    std::atomic<uint64> lateLoadTime{0};        // microseconds
+};
+
+/**
+ * Reads map, vmap and mmap data of grids players are about to enter on a background io thread.
+ *
+ * Maps predict grids from player movement (see Map::UpdateTerrainStreaming) and request them here.
+ * Navmesh tiles are read into memory and added to the map's navmesh on its own thread (PublishPrepared),
+ * vmap models are loaded and referenced until the map loads the grid, .map files are only read
+ * ahead so the synchronous load hits the file cache. Map trees and GridMaps themselves are still
+ * built by the map thread since they are read without locking.
+ */
+class TerrainStreamer : public MaNGOS::Singleton<TerrainStreamer, MaNGOS::ClassLevelLockable<TerrainStreamer, std::mutex> >
+{
+        friend class MaNGOS::OperatorNew<TerrainStreamer>;
+
+    public:
+        void Initialize();
+        void Shutdown();
+
+        bool IsEnabled() const { return m_enabled; }
+        uint32 GetLookahead() const { return m_lookahead; }
+
+        // queue a grid for background loading, no-op if already queued or prepared
+        void RequestGrid(uint32 mapId, uint32 instanceId, uint32 gx, uint32 gy);
+        // add navmesh tiles prepared for this map - call from the map's update only
+        void PublishPrepared(uint32 mapId, uint32 instanceId);
+        // a grid was loaded on the map thread - drops the prefetch holds and records the stall
+        void OnGridLoaded(uint32 mapId, uint32 instanceId, uint32 gx, uint32 gy, uint64 loadTime);
+        // drop prepared grids no map claimed in time
+        void Update();
+
+        static TerrainStreamerStats& GetStats() { return m_stats; }
+
+    private:
+        TerrainStreamer();
+        ~TerrainStreamer();
+
+        TerrainStreamer(const TerrainStreamer&);
+        TerrainStreamer& operator=(const TerrainStreamer&);
+
+        struct PreparedGrid
+        {
+            PreparedGrid() : mapId(0), instanceId(0), gx(0), gy(0), requestTime(0), ready(false), navData(nullptr), navDataSize(0) {}
+
+            uint32 mapId;
+            uint32 instanceId;
+            uint32 gx;
+            uint32 gy;
+            uint32 requestTime;
+            bool ready;
+
+            unsigned char* navData;             // mmtile data, owned until published
+            uint32 navDataSize;
+            std::vector<std::string> models;    // vmap models referenced until the grid is loaded
+        };
+
+        typedef std::unordered_map<uint64, PreparedGrid> PreparedGridMap;
+
+        static uint64 MakeKey(uint32 mapId, uint32 instanceId, uint32 gx, uint32 gy)
+        {
+            return (uint64(instanceId) << 32) | (mapId << 12) | (gx << 6) | gy;
+        }
+
+        void IoThread();
+        void PrepareGrid(uint64 key);
+        static void ReleaseGrid(PreparedGrid& grid);
+
+        std::atomic<bool> m_enabled;                    // cleared by Shutdown on the world thread, read by map threads
+        uint32 m_lookahead;
+        uint32 m_maxPending;
+
+        std::mutex m_lock;
+        PreparedGridMap m_grids;
+
+        ProducerConsumerQueue<uint64> m_queue;
+        std::thread m_ioThread;
+        std::atomic<bool> m_stop;
+
+        static TerrainStreamerStats m_stats;
+};
+
+#define sTerrainStreamer TerrainStreamer::Instance()
+
+#endif
@@ -168,7 +168,11 @@ namespace MMAP
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMapData: Loaded %03i.mmap", mapId);
 
         // store inside our map list
-        m_loadedMMaps.emplace(packInstanceId(mapId, instanceId), std::make_unique<MMapData>(mesh));
+        auto mmapData = std::make_unique<MMapData>(mesh);
+        if (uint32 cacheSize = sWorld.getConfig(CONFIG_UINT32_PATH_FIND_CACHE_SIZE))
+            mmapData->pathCache = std::make_unique<PathCache>(cacheSize);
+
+        m_loadedMMaps.emplace(packInstanceId(mapId, instanceId), std::move(mmapData));
         return true;
     }
 
@@ -205,31 +209,36 @@ namespace MMAP
         if (!loadMapData(mapId, instanceId))
             return false;
 
-        // get this mmap data
-        const auto& mmapData = m_loadedMMaps[packInstanceId(mapId, instanceId)];
-        MANGOS_ASSERT(mmapData->navMesh);
+        // check if we already have this tile loaded
+        if (IsMMapTileLoaded(mapId, instanceId, x, y))
+        {
+            sLog.outError("MMAP:loadMap: Asked to load already loaded navmesh tile. ");
+            return false;
+        }
+
+        uint32 dataSize = 0;
+        unsigned char* data = readTileData(mapId, x, y, number, dataSize);
+        if (!data)
+            return false;
 
+        return loadPreparedMap(mapId, instanceId, x, y, data, dataSize);
+    }
+
+    unsigned char* MMapManager::readTileData(uint32 mapId, int32 x, int32 y, uint32 number, uint32& dataSize)
+    {
         char fileName[100];
         if (number == 0)
             sprintf(fileName, "%03u%02i%02i.mmtile", mapId, x, y);
         else
             sprintf(fileName, "%03u%02i%02i_%02i.mmtile", mapId, x, y, number);
 
-        // check if we already have this tile loaded
-        uint32 packedGridPos = packTileID(x, y);
-        if (mmapData->mmapLoadedTiles.find(packedGridPos) != mmapData->mmapLoadedTiles.end())
-        {
-            sLog.outError("MMAP:loadMap: Asked to load already loaded navmesh tile. ");
-            return false;
-        }
-
         std::string filePath = sWorld.GetDataPath() + std::string("mmaps/") + fileName;
         // load this tile
         FILE* file = fopen(filePath.c_str(), "rb");
         if (!file)
         {
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "ERROR: MMAP:loadMap: Could not open mmtile file '%s'", fileName);
-            return false;
+            return nullptr;
         }
 
         // read header
@@ -240,7 +249,7 @@ namespace MMAP
         {
             sLog.outError("MMAP:loadMap: Bad header in mmap %s", fileName);
             fclose(file);
-            return false;
+            return nullptr;
         }
 
         if (fileHeader.mmapVersion != MMAP_VERSION)
@@ -248,7 +257,7 @@ namespace MMAP
             sLog.outError("MMAP:loadMap: %s was built with generator v%i, expected v%i",
                           fileName, fileHeader.mmapVersion, MMAP_VERSION);
             fclose(file);
-            return false;
+            return nullptr;
         }
 
         unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
@@ -259,26 +268,51 @@ namespace MMAP
         {
             sLog.outError("MMAP:loadMap: Bad header or data in mmap %s", fileName);
             fclose(file);
-            return false;
+            dtFree(data);
+            return nullptr;
         }
 
         fclose(file);
 
+        dataSize = fileHeader.size;
+        return data;
+    }
+
+    bool MMapManager::loadPreparedMap(uint32 mapId, uint32 instanceId, int32 x, int32 y, unsigned char* data, uint32 dataSize)
+    {
+        // make sure the mmap is loaded and ready to load tiles
+        if (!loadMapData(mapId, instanceId))
+        {
+            dtFree(data);
+            return false;
+        }
+
+        // get this mmap data
+        const auto& mmapData = m_loadedMMaps[packInstanceId(mapId, instanceId)];
+        MANGOS_ASSERT(mmapData->navMesh);
+
+        uint32 packedGridPos = packTileID(x, y);
+        if (mmapData->mmapLoadedTiles.find(packedGridPos) != mmapData->mmapLoadedTiles.end())
+        {
+            dtFree(data);
+            return false;
+        }
+
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        dtStatus dtResult = mmapData->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
+        dtStatus dtResult = mmapData->navMesh->addTile(data, dataSize, DT_TILE_FREE_DATA, 0, &tileRef);
         if (dtStatusFailed(dtResult))
         {
-            sLog.outError("MMAP:loadMap: Could not load %s into navmesh", fileName);
+            sLog.outError("MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
             dtFree(data);
             return false;
         }
 
         mmapData->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
         ++m_loadedTiles;
-        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap:%s: Loaded into %03i[%02i,%02i]", fileName, mapId, header->x, header->y);
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap: Loaded into %03i[%02i,%02i]", mapId, header->x, header->y);
         return true;
     }
 
@@ -378,6 +412,10 @@ namespace MMAP
 
         dtTileRef tileRef = mmapData->mmapLoadedTiles[packedGridPos];
 
+        // cached corridors through this tile would reference dead polys after removal
+        if (mmapData->pathCache)
+            mmapData->pathCache->InvalidateTile(mmapData->navMesh, tileRef);
+
         // unload, and mark as non loaded
         dtStatus dtResult = mmapData->navMesh->removeTile(tileRef, nullptr, nullptr);
         if (dtStatusFailed(dtResult))
@@ -483,6 +521,15 @@ namespace MMAP
         return m_loadedModels[mapId]->navMesh;
     }
 
+    PathCache* MMapManager::GetPathCache(uint32 mapId, uint32 instanceId)
+    {
+        auto itr = m_loadedMMaps.find(packInstanceId(mapId, instanceId));
+        if (itr == m_loadedMMaps.end())
+            return nullptr;
+
+        return (*itr).second->pathCache.get();
+    }
+
     dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
     {
         auto itr = m_loadedMMaps.find(packInstanceId(mapId, instanceId));
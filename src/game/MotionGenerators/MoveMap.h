@@ -20,6 +20,7 @@
 #define _MOVE_MAP_H
 
 #include "Common.h"
+#include "MotionGenerators/PathCache.h"
 #include <Detour/Include/DetourAlloc.h>
 #include <Detour/Include/DetourNavMesh.h>
 #include <Detour/Include/DetourNavMeshQuery.h>
@@ -53,6 +54,10 @@ namespace MMAP
         MMapData(dtNavMesh* mesh) : navMesh(mesh) {}
         ~MMapData()
         {
+            if (pathCache)
+                pathCache->Clear();
+
+
             for (auto& navMeshQuerie : navMeshQueries)
                 dtFreeNavMeshQuery(navMeshQuerie.second);
 
@@ -65,6 +70,8 @@ namespace MMAP
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+
+        std::unique_ptr<PathCache> pathCache; // corridors shared by all PathFinders of this map, null if disabled
     };
 
     struct MMapGOData
@@ -95,6 +102,10 @@ namespace MMAP
             ~MMapManager();
 
             bool loadMap(uint32 mapId, uint32 instanceId, int32 x, int32 y, uint32 number);
+            // reads a mmtile from disk without touching any navmesh - thread safe, result must be dtFree'd or passed to loadPreparedMap
+            static unsigned char* readTileData(uint32 mapId, int32 x, int32 y, uint32 number, uint32& dataSize);
+            // adds tile data read by readTileData to the navmesh, takes ownership of data
+            bool loadPreparedMap(uint32 mapId, uint32 instanceId, int32 x, int32 y, unsigned char* data, uint32 dataSize);
             bool loadMapData(uint32 mapId, uint32 instanceId);
             void loadAllGameObjectModels(std::vector<uint32> const& displayIds);
             bool loadGameObject(uint32 displayId);
@@ -108,6 +119,7 @@ namespace MMAP
             dtNavMeshQuery const* GetModelNavMeshQuery(uint32 displayId);
             dtNavMesh const* GetNavMesh(uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetGONavMesh(uint32 displayId);
+            PathCache* GetPathCache(uint32 mapId, uint32 instanceId);
 
             uint32 getLoadedTilesCount() const { return m_loadedTiles; }
             uint32 getLoadedMapsCount() const { return m_loadedMMaps.size(); }
@@ -0,0 +1,144 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MotionGenerators/PathCache.h"
+#include <Detour/Include/DetourCommon.h>
+
+namespace MMAP
+{
+    // how far (squared, in yards) a requester may be from the cached start/end to reuse the point path
+    static const float PATH_CACHE_POINT_TOLERANCE_SQ = 0.25f;
+
+    PathCacheStats PathCache::m_stats;
+
+    PathCacheEntry const* PathCache::FindCorridor(PathCacheKey const& key)
+    {
+        auto itr = m_index.find(key);
+        if (itr == m_index.end())
+        {
+            ++m_stats.misses;
+            return nullptr;
+        }
+
+        // move to front - most recently used
+        m_entries.splice(m_entries.begin(), m_entries, itr->second);
+
+        ++m_stats.hits;
+        m_stats.timeSaved += itr->second->buildTime;
+        return &(*itr->second);
+    }
+
+    void PathCache::StoreCorridor(PathCacheKey const& key, dtPolyRef const* polyRefs, uint32 polyLength, uint64 buildTime)
+    {
+        if (!m_maxEntries || !polyLength)
+            return;
+
+        auto itr = m_index.find(key);
+        if (itr != m_index.end())
+        {
+            m_entries.erase(itr->second);
+            m_index.erase(itr);
+        }
+
+        // evict least recently used
+        while (m_entries.size() >= m_maxEntries)
+        {
+            m_index.erase(m_entries.back().key);
+            m_entries.pop_back();
+        }
+
+        m_entries.emplace_front();
+        PathCacheEntry& entry = m_entries.front();
+        entry.key = key;
+        entry.polyRefs.assign(polyRefs, polyRefs + polyLength);
+        entry.useStraightPath = false;
+        entry.buildTime = buildTime;
+        dtVset(entry.startPoint, 0.0f, 0.0f, 0.0f);
+        dtVset(entry.endPoint, 0.0f, 0.0f, 0.0f);
+
+        m_index.emplace(key, m_entries.begin());
+    }
+
+    bool PathCache::FindPoints(PathCacheKey const& key, float const* startPoint, float const* endPoint, bool useStraightPath, std::vector<float>& points)
+    {
+        auto itr = m_index.find(key);
+        if (itr == m_index.end())
+            return false;
+
+        PathCacheEntry const& entry = *itr->second;
+        if (entry.points.empty() || entry.useStraightPath != useStraightPath)
+            return false;
+
+        if (dtVdistSqr(entry.startPoint, startPoint) > PATH_CACHE_POINT_TOLERANCE_SQ ||
+            dtVdistSqr(entry.endPoint, endPoint) > PATH_CACHE_POINT_TOLERANCE_SQ)
+            return false;
+
+        points = entry.points;
+        ++m_stats.pointHits;
+        return true;
+    }
+
+    void PathCache::StorePoints(PathCacheKey const& key, float const* startPoint, float const* endPoint, bool useStraightPath, float const* points, uint32 pointCount)
+    {
+        auto itr = m_index.find(key);
+        if (itr == m_index.end())
+            return;
+
+        PathCacheEntry& entry = *itr->second;
+        entry.points.assign(points, points + pointCount * 3);
+        entry.useStraightPath = useStraightPath;
+        dtVcopy(entry.startPoint, startPoint);
+        dtVcopy(entry.endPoint, endPoint);
+    }
+
+    void PathCache::InvalidateTile(dtNavMesh const* navMesh, dtTileRef tileRef)
+    {
+        if (m_entries.empty())
+            return;
+
+        uint32 tileIndex = navMesh->decodePolyIdTile(tileRef);
+        for (auto itr = m_entries.begin(); itr != m_entries.end();)
+        {
+            bool touchesTile = false;
+            for (dtPolyRef polyRef : itr->polyRefs)
+            {
+                if (navMesh->decodePolyIdTile(polyRef) == tileIndex)
+                {
+                    touchesTile = true;
+                    break;
+                }
+            }
+
+            if (touchesTile)
+            {
+                m_index.erase(itr->key);
+                itr = m_entries.erase(itr);
+                ++m_stats.invalidations;
+            }
+            else
+                ++itr;
+        }
+    }
+
+    void PathCache::Clear()
+    {
+        m_stats.invalidations += m_entries.size();
+        m_index.clear();
+        m_entries.clear();
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PATH_CACHE_H
+#define MANGOS_PATH_CACHE_H
+
+#include "Common.h"
+#include <Detour/Include/DetourNavMesh.h>
+
+#include <atomic>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace MMAP
+{
+    // identifies one poly corridor request on a navmesh
+    struct PathCacheKey
+    {
+        dtPolyRef startPoly;
+        dtPolyRef endPoly;
+        uint16 includeFlags;
+        uint16 excludeFlags;
+        uint32 maxPolys;                    // corridors are truncated by the requester's path limit
+
+        bool operator==(PathCacheKey const& other) const
+        {
+            return startPoly == other.startPoly && endPoly == other.endPoly &&
+                includeFlags == other.includeFlags && excludeFlags == other.excludeFlags &&
+                maxPolys == other.maxPolys;
+        }
+    };
+
+    struct PathCacheKeyHash
+    {
+        std::size_t operator()(PathCacheKey const& key) const
+        {
+            std::size_t hash = std::hash<dtPolyRef>()(key.startPoly);
+            hash ^= std::hash<dtPolyRef>()(key.endPoly) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<uint32>()((uint32(key.includeFlags) << 16) | key.excludeFlags) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<uint32>()(key.maxPolys) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+
+    struct PathCacheEntry
+    {
+        PathCacheKey key;
+        std::vector<dtPolyRef> polyRefs;    // corridor as returned by findPath
+
+        // point path built along the corridor for the last requester (detour y,z,x order)
+        // only reused when the requester starts and ends at the same spot
+        std::vector<float> points;
+        float startPoint[3];
+        float endPoint[3];
+        bool useStraightPath;
+
+        uint64 buildTime;                   // microseconds spent in findPath when the corridor was built
+    };
+
+    // process wide counters, exported through .mmap stats and metrics
+    struct PathCacheStats
+    {
+        std::atomic<uint64> hits{0};
+        std::atomic<uint64> misses{0};
+        std::atomic<uint64> pointHits{0};
+        std::atomic<uint64> invalidations{0};
+        std::atomic<uint64> timeSaved{0};   // microseconds of findPath work avoided by hits
+    };
+
+    // bounded LRU cache of poly corridors and smoothed points, one per navmesh instance (see MMapData)
+    // not thread safe - owned and used by the map thread only, same as the dtNavMeshQuery next to it
+    class PathCache
+    {
+        public:
+            explicit PathCache(uint32 maxEntries) : m_maxEntries(maxEntries) {}
+
+            PathCacheEntry const* FindCorridor(PathCacheKey const& key);
+            void StoreCorridor(PathCacheKey const& key, dtPolyRef const* polyRefs, uint32 polyLength, uint64 buildTime);
+
+            bool FindPoints(PathCacheKey const& key, float const* startPoint, float const* endPoint, bool useStraightPath, std::vector<float>& points);
+            void StorePoints(PathCacheKey const& key, float const* startPoint, float const* endPoint, bool useStraightPath, float const* points, uint32 pointCount);
+
+            // drops every corridor that passes through the given tile
+            void InvalidateTile(dtNavMesh const* navMesh, dtTileRef tileRef);
+            void Clear();
+
+            uint32 GetSize() const { return uint32(m_entries.size()); }
+            uint32 GetMaxSize() const { return m_maxEntries; }
+
+            static PathCacheStats& GetStats() { return m_stats; }
+
+        private:
+            typedef std::list<PathCacheEntry> EntryList;
+            typedef std::unordered_map<PathCacheKey, EntryList::iterator, PathCacheKeyHash> EntryIndex;
+
+            EntryList m_entries;                // most recently used first
+            EntryIndex m_index;
+            uint32 m_maxEntries;
+
+            static PathCacheStats m_stats;
+    };
+}
+
+#endif
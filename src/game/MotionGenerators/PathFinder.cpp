@@ -23,6 +23,7 @@
 #include "Log/Log.h"
 #include "World/World.h"
 #include "Entities/Transports.h"
+#include "Maps/TerrainQueryTrace.h"
 #include <Detour/Include/DetourCommon.h>
 #include <Detour/Include/DetourMath.h>
 
@@ -30,6 +31,7 @@
  #include "Metric/Metric.h"
 #endif
 
+#include <chrono>
 #include <limits>
 ////////////////// PathFinder //////////////////
 PathFinder::PathFinder(const Unit* owner, bool ignoreNormalization) :
@@ -37,7 +39,8 @@ PathFinder::PathFinder(const Unit* owner, bool ignoreNormalization) :
     m_pointPathLimit(MAX_POINT_PATH_LENGTH), // TODO: Fix legitimate long paths
     m_cachedPoints(m_pointPathLimit * VERTEX_SIZE), m_pathPolyRefs(m_pointPathLimit), m_polyLength(0),
     m_smoothPathPolyRefs(m_pointPathLimit), m_sourceUnit(owner), m_navMesh(nullptr), m_navMeshQuery(nullptr),
-    m_defaultMapId(m_sourceUnit->GetMapId()), m_ignoreNormalization(ignoreNormalization)
+    m_defaultMapId(m_sourceUnit->GetMapId()), m_ignoreNormalization(ignoreNormalization),
+    m_pathCache(nullptr), m_pathCacheKey(), m_corridorCached(false)
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::PathInfo for %u \n", m_sourceUnit->GetGUIDLow());
 
@@ -61,13 +64,17 @@ void PathFinder::SetCurrentNavMesh()
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         if (GenericTransport* transport = m_sourceUnit->GetTransport())
+        {
             m_navMeshQuery = mmap->GetModelNavMeshQuery(transport->GetDisplayId());
+            m_pathCache = nullptr;                  // transport models are shared between maps and threads
+        }
         else
         {
             if (m_defaultMapId != m_sourceUnit->GetMapId())
                 m_defaultNavMeshQuery = mmap->GetNavMeshQuery(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
 
             m_navMeshQuery = m_defaultNavMeshQuery;
+            m_pathCache = mmap->GetPathCache(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
         }
 
         if (m_navMeshQuery)
@@ -93,6 +100,8 @@ bool PathFinder::calculate(Vector3 const& start, Vector3 const& dest, bool force
     if (!MaNGOS::IsValidMapCoord(start.x, start.y, start.z))
         return false;
 
+    TerrainQueryRecorder traceQuery(TERRAIN_QUERY_PATH, m_sourceUnit->GetMapId(), start.x, start.y, start.z, dest.x, dest.y, dest.z, 0.0f, straightLine);
+
 #ifdef BUILD_METRICS
     metric::duration<std::chrono::microseconds> meas("pathfinder.calculate", {
         { "entry", std::to_string(m_sourceUnit->GetEntry()) },
@@ -215,6 +224,8 @@ dtPolyRef PathFinder::getPolyByLocation(const float* point, float* distance)
 
 void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
 {
+    m_corridorCached = false;
+
     // *** getting start/end poly logic ***
     if (m_sourceUnit->GetMap()->IsDungeon())
     {
@@ -469,15 +480,41 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
 
         if (!m_straightLine)
         {
-            dtResult = m_navMeshQuery->findPath(
-                    startPoly,          // start polygon
-                    endPoly,            // end polygon
-                    startPoint,         // start position
-                    endPoint,           // end position
-                    &m_filter,          // polygon search filter
-                    m_pathPolyRefs.data(), // [out] path
-                    (int*)&m_polyLength,
-                    m_pointPathLimit);   // max number of polygons in output path
+            m_pathCacheKey = { startPoly, endPoly, m_filter.getIncludeFlags(), m_filter.getExcludeFlags(), m_pointPathLimit };
+
+            MMAP::PathCacheEntry const* cached = m_pathCache ? m_pathCache->FindCorridor(m_pathCacheKey) : nullptr;
+            if (cached)
+            {
+                DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: corridor found in path cache\n");
+
+                m_polyLength = uint32(cached->polyRefs.size());
+                memcpy(m_pathPolyRefs.data(), cached->polyRefs.data(), m_polyLength * sizeof(dtPolyRef));
+                m_corridorCached = true;
+                dtResult = DT_SUCCESS;
+            }
+            else
+            {
+                auto buildStart = std::chrono::steady_clock::now();
+
+                dtResult = m_navMeshQuery->findPath(
+                        startPoly,          // start polygon
+                        endPoly,            // end polygon
+                        startPoint,         // start position
+                        endPoint,           // end position
+                        &m_filter,          // polygon search filter
+                        m_pathPolyRefs.data(), // [out] path
+                        (int*)&m_polyLength,
+                        m_pointPathLimit);   // max number of polygons in output path
+
+                // only complete corridors are shared, partial ones may resolve once more tiles are loaded
+                if (m_pathCache && dtStatusSucceed(dtResult) && !dtStatusDetail(dtResult, DT_PARTIAL_RESULT) &&
+                    m_polyLength && m_pathPolyRefs[m_polyLength - 1] == endPoly)
+                {
+                    uint64 buildTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - buildStart).count();
+                    m_pathCache->StoreCorridor(m_pathCacheKey, m_pathPolyRefs.data(), m_polyLength, buildTime);
+                    m_corridorCached = true;
+                }
+            }
         }
         else
         {
@@ -619,7 +656,15 @@ void PathFinder::BuildPointPath(const float* startPoint, const float* endPoint)
     {
         float* pathPoints = m_cachedPoints.data();
 
-        if (m_useStraightPath)
+        // same corridor and same spots as a previous requester - reuse its point path
+        std::vector<float> cachedPathPoints;
+        if (m_corridorCached && m_pathCache->FindPoints(m_pathCacheKey, startPoint, endPoint, m_useStraightPath, cachedPathPoints))
+        {
+            pointCount = uint32(cachedPathPoints.size() / VERTEX_SIZE);
+            memcpy(pathPoints, cachedPathPoints.data(), cachedPathPoints.size() * sizeof(float));
+            dtResult = DT_SUCCESS;
+        }
+        else if (m_useStraightPath)
         {
             dtResult = m_navMeshQuery->findStraightPath(
                 startPoint,         // start position
@@ -644,6 +689,9 @@ void PathFinder::BuildPointPath(const float* startPoint, const float* endPoint)
                 m_pointPathLimit);    // maximum number of points
         }
 
+        if (m_corridorCached && cachedPathPoints.empty() && dtStatusSucceed(dtResult) && pointCount >= 2)
+            m_pathCache->StorePoints(m_pathCacheKey, startPoint, endPoint, m_useStraightPath, pathPoints, pointCount);
+
         if (pointCount > 2 && sWorld.getConfig(CONFIG_BOOL_PATH_FIND_OPTIMIZE))
         {
             uint32 tempPointCounter = 2;
@@ -20,6 +20,7 @@
 #define MANGOS_PATH_FINDER_H
 
 #include "MoveMapSharedDefines.h"
+#include "MotionGenerators/PathCache.h"
 
 #include <Detour/Include/DetourNavMesh.h>
 #include <Detour/Include/DetourNavMeshQuery.h>
@@ -120,6 +121,10 @@ class PathFinder
 
         dtQueryFilter m_filter;                     // use single filter for all movements, update it when needed
 
+        MMAP::PathCache*        m_pathCache;        // shared corridor cache of the current navmesh, null if disabled
+        MMAP::PathCacheKey      m_pathCacheKey;     // key of the current corridor, valid if m_corridorCached
+        bool                    m_corridorCached;   // current corridor is stored in m_pathCache
+
         void setStartPosition(const Vector3& point) { m_startPosition = point; }
         void setEndPosition(const Vector3& point) { m_actualEndPosition = point; m_endPosition = point; }
         void setActualEndPosition(const Vector3& point) { m_actualEndPosition = point; }
@@ -666,40 +666,10 @@ void WorldSession::HandleQuestPushResult(WorldPacket& recvPacket)
     }
 }
 
-/**
- * What - if any - kind of explanation mark or question-mark should a quest-giver display for a player
- * @param pPlayer - for whom
- * @param questgiver - from whom
- * @param defstatus - initial set status (usually it will be called with DIALOG_STATUS_NONE) - must not be DIALOG_STATUS_UNDEFINED
- */
-uint32 WorldSession::getDialogStatus(const Player* pPlayer, const Object* questgiver, uint32 defstatus) const
+// status from the quests of the relation bounds alone, cacheable is cleared when it depends on more than Player::GetCachedQuestGiverStatus watches
+static uint32 GetQuestRelationsDialogStatus(const Player* pPlayer, QuestRelationsMapBounds const& rbounds, QuestRelationsMapBounds const& irbounds, bool& cacheable)
 {
-    MANGOS_ASSERT(defstatus != DIALOG_STATUS_UNDEFINED);
-
-    uint32 dialogStatus = defstatus;
-
-    QuestRelationsMapBounds rbounds;                        // QuestRelations (quest-giver)
-    QuestRelationsMapBounds irbounds;                       // InvolvedRelations (quest-finisher)
-
-    switch (questgiver->GetTypeId())
-    {
-        case TYPEID_UNIT:
-        {
-            rbounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(questgiver->GetEntry());
-            irbounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(questgiver->GetEntry());
-            break;
-        }
-        case TYPEID_GAMEOBJECT:
-        {
-            rbounds = sObjectMgr.GetGOQuestRelationsMapBounds(questgiver->GetEntry());
-            irbounds = sObjectMgr.GetGOQuestInvolvedRelationsMapBounds(questgiver->GetEntry());
-            break;
-        }
-        default:
-            // it's impossible, but check ^)
-            sLog.outError("Warning: GetDialogStatus called for unexpected type %u", questgiver->GetTypeId());
-            return DIALOG_STATUS_NONE;
-    }
+    uint32 dialogStatus = DIALOG_STATUS_NONE;
 
     // Check markings for quest-finisher
     for (QuestRelationsMap::const_iterator itr = irbounds.first; itr != irbounds.second; ++itr)
@@ -711,6 +681,10 @@ uint32 WorldSession::getDialogStatus(const Player* pPlayer, const Object* questg
         if (!pQuest || !pQuest->IsActive())
             continue;
 
+        // conditions and skill values change without any quest or reputation event
+        if (pQuest->GetRequiredCondition() || pQuest->GetRequiredSkill())
+            cacheable = false;
+
         QuestStatus status = pPlayer->GetQuestStatus(quest_id);
 
         if (status == QUEST_STATUS_COMPLETE && !pPlayer->GetQuestRewardStatus(quest_id))
@@ -734,6 +708,9 @@ uint32 WorldSession::getDialogStatus(const Player* pPlayer, const Object* questg
         if (!pQuest || !pQuest->IsActive())
             continue;
 
+        if (pQuest->GetRequiredCondition() || pQuest->GetRequiredSkill())
+            cacheable = false;
+
         QuestStatus status = pPlayer->GetQuestStatus(quest_id);
 
         if (status == QUEST_STATUS_NONE)                    // For all other cases the mark is handled either at some place else, or with involved-relations already
@@ -770,6 +747,51 @@ uint32 WorldSession::getDialogStatus(const Player* pPlayer, const Object* questg
     return dialogStatus;
 }
 
+/**
+ * What - if any - kind of explanation mark or question-mark should a quest-giver display for a player
+ * @param pPlayer - for whom
+ * @param questgiver - from whom
+ * @param defstatus - initial set status (usually it will be called with DIALOG_STATUS_NONE) - must not be DIALOG_STATUS_UNDEFINED
+ */
+uint32 WorldSession::getDialogStatus(const Player* pPlayer, const Object* questgiver, uint32 defstatus) const
+{
+    MANGOS_ASSERT(defstatus != DIALOG_STATUS_UNDEFINED);
+
+    QuestRelationsMapBounds rbounds;                        // QuestRelations (quest-giver)
+    QuestRelationsMapBounds irbounds;                       // InvolvedRelations (quest-finisher)
+
+    switch (questgiver->GetTypeId())
+    {
+        case TYPEID_UNIT:
+        {
+            rbounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(questgiver->GetEntry());
+            irbounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(questgiver->GetEntry());
+            break;
+        }
+        case TYPEID_GAMEOBJECT:
+        {
+            rbounds = sObjectMgr.GetGOQuestRelationsMapBounds(questgiver->GetEntry());
+            irbounds = sObjectMgr.GetGOQuestInvolvedRelationsMapBounds(questgiver->GetEntry());
+            break;
+        }
+        default:
+            // it's impossible, but check ^)
+            sLog.outError("Warning: GetDialogStatus called for unexpected type %u", questgiver->GetTypeId());
+            return DIALOG_STATUS_NONE;
+    }
+
+    uint32 dialogStatus;
+    if (!pPlayer->GetCachedQuestGiverStatus(questgiver, dialogStatus))
+    {
+        bool cacheable = true;
+        dialogStatus = GetQuestRelationsDialogStatus(pPlayer, rbounds, irbounds, cacheable);
+        if (cacheable)
+            pPlayer->CacheQuestGiverStatus(questgiver, dialogStatus);
+    }
+
+    return std::max(defstatus, dialogStatus);
+}
+
 void WorldSession::HandleQuestgiverStatusMultipleQuery(WorldPacket& /*recvPacket*/)
 {
     DEBUG_LOG("WORLD: Received opcode CMSG_QUESTGIVER_STATUS_MULTIPLE_QUERY");
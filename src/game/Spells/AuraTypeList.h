@@ -0,0 +1,134 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_AURATYPELIST_H
+#define MANGOS_AURATYPELIST_H
+
+#include "Common.h"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+class Aura;
+
+/**
+ * Auras of one aura type on a unit (Unit::AuraList), kept in one array for the modifier sums of stat updates.
+ *
+ * Iterators behave like the ones of the std::list used before: they stay valid when auras are added or
+ * removed during a walk, auras added meanwhile are still visited. Removing an aura only clears its slot,
+ * iteration skips cleared slots until Compact() drops them, Unit does so where no walk can be in progress.
+ */
+class AuraTypeList
+{
+    public:
+        class const_iterator
+        {
+            public:
+                typedef std::bidirectional_iterator_tag iterator_category;
+                typedef Aura* value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef Aura* const* pointer;
+                typedef Aura* const& reference;
+
+                const_iterator() : m_list(nullptr), m_index(0) {}
+                const_iterator(AuraTypeList const* list, size_t index) : m_list(list), m_index(index) { SkipForward(); }
+
+                reference operator*() const { return m_list->m_auras[m_index]; }
+                pointer operator->() const { return &m_list->m_auras[m_index]; }
+
+                const_iterator& operator++() { ++m_index; SkipForward(); return *this; }
+                const_iterator operator++(int) { const_iterator itr = *this; ++*this; return itr; }
+                const_iterator& operator--() { do --m_index; while (!m_list->m_auras[m_index]); return *this; }
+                const_iterator operator--(int) { const_iterator itr = *this; --*this; return itr; }
+
+                // the end is wherever the list currently ends
+                bool operator==(const_iterator const& other) const { return IsEnd() ? other.IsEnd() : m_index == other.m_index; }
+                bool operator!=(const_iterator const& other) const { return !(*this == other); }
+
+            private:
+                friend class AuraTypeList;
+
+                bool IsEnd() const { return m_index >= m_list->m_auras.size(); }
+                void SkipForward() { while (!IsEnd() && !m_list->m_auras[m_index]) ++m_index; }
+
+                AuraTypeList const* m_list;
+                size_t m_index;
+        };
+
+        typedef const_iterator iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef const_reverse_iterator reverse_iterator;
+        typedef Aura* value_type;
+
+        AuraTypeList() : m_count(0) {}
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, m_auras.size()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+        bool empty() const { return m_count == 0; }
+        size_t size() const { return m_count; }
+        Aura* front() const { return *begin(); }
+        Aura* back() const { return *rbegin(); }
+
+        void push_back(Aura* aura)
+        {
+            m_auras.push_back(aura);
+            ++m_count;
+        }
+
+        void remove(Aura* aura)
+        {
+            for (Aura*& slot : m_auras)
+            {
+                if (slot == aura)
+                {
+                    slot = nullptr;
+                    --m_count;
+                }
+            }
+        }
+
+        const_iterator erase(const_iterator itr)
+        {
+            m_auras[itr.m_index] = nullptr;
+            --m_count;
+            return ++itr;
+        }
+
+        void clear()
+        {
+            m_auras.clear();
+            m_count = 0;
+        }
+
+        // drops cleared slots, invalidates iterators
+        void Compact()
+        {
+            if (m_count != m_auras.size())
+                m_auras.erase(std::remove(m_auras.begin(), m_auras.end(), nullptr), m_auras.end());
+        }
+
+    private:
+        std::vector<Aura*> m_auras;                         // nullptr for removed auras until compacted
+        size_t m_count;
+};
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_FLATIDMAP_H
+#define MANGOS_FLATIDMAP_H
+
+#include "Common.h"
+
+#include <utility>
+#include <vector>
+
+/**
+ * Read only id -> value table compiled from a map once its loading is done.
+ *
+ * Values are stored packed in id order, a dense array indexed by id holds their positions,
+ * so a lookup is two array reads instead of a tree or hash walk. Meant for spell and area ids,
+ * the index takes 4 bytes per id up to the highest one stored.
+ */
+template<class T>
+class FlatIdMap
+{
+    public:
+        FlatIdMap() {}
+
+        // Container: any map with uint32 keys and T values
+        template<class Container>
+        void Assign(Container const& source)
+        {
+            clear();
+
+            if (source.empty())
+                return;
+
+            uint32 maxId = 0;
+            for (auto const& itr : source)
+                if (itr.first > maxId)
+                    maxId = itr.first;
+
+            m_index.assign(maxId + 1, 0);
+            m_values.reserve(source.size());
+            for (auto const& itr : source)
+            {
+                m_values.push_back(itr.second);
+                m_index[itr.first] = uint32(m_values.size());
+            }
+        }
+
+        // for building without a source map, ids added in ascending order keep the values in id order
+        void Insert(uint32 id, T const& value)
+        {
+            if (id >= m_index.size())
+                m_index.resize(id + 1, 0);
+
+            if (m_index[id])
+                m_values[m_index[id] - 1] = value;
+            else
+            {
+                m_values.push_back(value);
+                m_index[id] = uint32(m_values.size());
+            }
+        }
+
+        void reserve(uint32 maxId, size_t count)
+        {
+            m_index.reserve(maxId + 1);
+            m_values.reserve(count);
+        }
+
+        void clear()
+        {
+            m_index.clear();
+            m_values.clear();
+        }
+
+        T const* Find(uint32 id) const
+        {
+            if (id >= m_index.size() || !m_index[id])
+                return nullptr;
+
+            return &m_values[m_index[id] - 1];
+        }
+
+        bool empty() const { return m_values.empty(); }
+        size_t size() const { return m_values.size(); }
+
+    private:
+        std::vector<uint32> m_index;                        // position in m_values + 1, 0 for ids without value
+        std::vector<T> m_values;
+};
+
+/**
+ * Read only id -> values table compiled from a multimap once its loading is done.
+ *
+ * All values sit in one array in key order, with values of a key in the order the multimap had them.
+ * A dense array indexed by id gives where the values of each id start, so equal_range is two array reads.
+ * Iterators and bounds behave like the ones of the multimap, existing loops over them keep working.
+ */
+template<class T>
+class FlatIdMultiMap
+{
+    public:
+        typedef std::pair<uint32, T> value_type;
+        typedef typename std::vector<value_type>::const_iterator const_iterator;
+        typedef const_iterator iterator;
+
+        FlatIdMultiMap() {}
+
+        // Container: multimap with uint32 keys and T values, iterated in key order
+        template<class Container>
+        void Assign(Container const& source)
+        {
+            clear();
+
+            if (source.empty())
+                return;
+
+            m_values.assign(source.begin(), source.end());
+
+            // m_offsets[id] is the number of values with a lower key, one more entry closes the last key
+            uint32 maxId = m_values.back().first;
+            m_offsets.assign(maxId + 2, 0);
+            for (value_type const& value : m_values)
+                ++m_offsets[value.first + 1];
+            for (uint32 id = 1; id < m_offsets.size(); ++id)
+                m_offsets[id] += m_offsets[id - 1];
+        }
+
+        void clear()
+        {
+            m_offsets.clear();
+            m_values.clear();
+        }
+
+        const_iterator begin() const { return m_values.begin(); }
+        const_iterator end() const { return m_values.end(); }
+
+        const_iterator lower_bound(uint32 id) const
+        {
+            if (uint64(id) + 1 >= m_offsets.size())
+                return end();
+
+            return begin() + m_offsets[id];
+        }
+
+        const_iterator upper_bound(uint32 id) const
+        {
+            if (uint64(id) + 1 >= m_offsets.size())
+                return end();
+
+            return begin() + m_offsets[id + 1];
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(uint32 id) const
+        {
+            return std::make_pair(lower_bound(id), upper_bound(id));
+        }
+
+        const_iterator find(uint32 id) const
+        {
+            const_iterator itr = lower_bound(id);
+            return itr != upper_bound(id) ? itr : end();
+        }
+
+        size_t count(uint32 id) const { return upper_bound(id) - lower_bound(id); }
+
+        bool empty() const { return m_values.empty(); }
+        size_t size() const { return m_values.size(); }
+
+    private:
+        std::vector<uint32> m_offsets;
+        std::vector<value_type> m_values;
+};
+
+#endif
@@ -442,6 +442,9 @@ Spell::Spell(WorldObject* caster, SpellEntry const* info, uint32 triggeredFlags,
     else
         m_spellInfo = info;
 
+    m_spellHot = sSpellMgr.GetSpellHotEntry(m_spellInfo->Id);
+    MANGOS_ASSERT(m_spellHot);
+
     m_triggeredBySpellInfo = triggeredBy;
     m_caster = dynamic_cast<Unit*>(caster);
     m_referencedFromCurrentSpell = false;
@@ -619,7 +622,7 @@ void Spell::FillTargetMap()
     {
         // not call for empty effect.
         // Also some spells use not used effect targets for store targets for dummy effect in triggered spells
-        if (m_spellInfo->Effect[i] == SPELL_EFFECT_NONE)
+        if (m_spellHot->Effect[i] == SPELL_EFFECT_NONE)
             continue;
 
         auto& data = SpellTargetMgr::GetSpellTargetingData(m_spellInfo->Id);
@@ -631,8 +634,8 @@ void Spell::FillTargetMap()
 
         if (effectTargetType == TARGET_TYPE_SPECIAL_UNIT) // area auras need custom handling
         {
-            uint32 targetA = m_spellInfo->EffectImplicitTargetA[i];
-            uint32 targetB = m_spellInfo->EffectImplicitTargetB[i];
+            uint32 targetA = m_spellHot->EffectImplicitTargetA[i];
+            uint32 targetB = m_spellHot->EffectImplicitTargetB[i];
             bool hadTarget = false;
             // need to pick a single unit target if existant and use it for area aura owner
             if (targetA && !ignoredTargets.first)
@@ -653,14 +656,14 @@ void Spell::FillTargetMap()
         }
         else
         {
-            uint32 targetA = m_spellInfo->EffectImplicitTargetA[i];
-            uint32 targetB = m_spellInfo->EffectImplicitTargetB[i];
+            uint32 targetA = m_spellHot->EffectImplicitTargetA[i];
+            uint32 targetB = m_spellHot->EffectImplicitTargetB[i];
             if (targetA == TARGET_NONE && targetB == TARGET_NONE)
             {
                 // if no targeting available, attempt to use entry mask
-                if (m_spellInfo->Targets && SpellTargetMgr::CanEffectBeFilledWithMask(m_spellInfo->Id, i, m_spellInfo->Targets))
+                if (m_spellHot->Targets && SpellTargetMgr::CanEffectBeFilledWithMask(m_spellInfo->Id, i, m_spellHot->Targets))
                     FillFromTargetFlags(targetingData, SpellEffectIndex(i));
-                else if (uint32 defaultTarget = SpellEffectInfoTable[m_spellInfo->Effect[i]].defaultTarget) // else resort to default effect type if it exists
+                else if (uint32 defaultTarget = SpellEffectInfoTable[m_spellHot->Effect[i]].defaultTarget) // else resort to default effect type if it exists
                     SetTargetMap(SpellEffectIndex(i), defaultTarget, false, targetingData);
             }
             else // normal case, use existing spell data
@@ -5507,7 +5510,7 @@ Unit* Spell::GetPrefilledUnitTargetOrUnitTarget(SpellEffectIndex effIndex) const
 SpellCastResult Spell::CheckCast(bool strict)
 {
     // check cooldowns to prevent cheating (ignore passive spells, that client side visual only)
-    if (!m_ignoreCooldowns && !m_spellInfo->HasAttribute(SPELL_ATTR_PASSIVE)
+    if (!m_ignoreCooldowns && !m_spellHot->HasAttribute(SPELL_ATTR_PASSIVE)
             && !m_trueCaster->IsSpellReady(*m_spellInfo, m_CastItem ? m_CastItem->GetProto() : nullptr))
     {
         if (m_triggeredByAuraSpell)
@@ -5516,7 +5519,7 @@ SpellCastResult Spell::CheckCast(bool strict)
             return SPELL_FAILED_NOT_READY;
     }
 
-    if (!m_spellInfo->HasAttribute(SPELL_ATTR_PASSIVE))
+    if (!m_spellHot->HasAttribute(SPELL_ATTR_PASSIVE))
     {
         if (m_trueCaster->IsPlayer())
         {
@@ -5545,10 +5548,10 @@ SpellCastResult Spell::CheckCast(bool strict)
 
     if (m_caster)
     {
-        if (!m_caster->IsAlive() && m_caster->GetTypeId() == TYPEID_PLAYER && !m_spellInfo->HasAttribute(SPELL_ATTR_ALLOW_CAST_WHILE_DEAD) && !m_spellInfo->HasAttribute(SPELL_ATTR_PASSIVE))
+        if (!m_caster->IsAlive() && m_caster->GetTypeId() == TYPEID_PLAYER && !m_spellHot->HasAttribute(SPELL_ATTR_ALLOW_CAST_WHILE_DEAD) && !m_spellHot->HasAttribute(SPELL_ATTR_PASSIVE))
             return SPELL_FAILED_CASTER_DEAD;
 
-        if (!m_IsTriggeredSpell && !m_caster->IsStandState() && m_caster->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_PLAYER_CONTROLLED) && !m_spellInfo->HasAttribute(SPELL_ATTR_ALLOW_WHILE_SITTING))
+        if (!m_IsTriggeredSpell && !m_caster->IsStandState() && m_caster->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_PLAYER_CONTROLLED) && !m_spellHot->HasAttribute(SPELL_ATTR_ALLOW_WHILE_SITTING))
             return SPELL_FAILED_NOT_STANDING;
 
         if ((!m_IsTriggeredSpell || m_triggeredByAuraSpell) && IsNonCombatSpell(m_spellInfo) && m_caster->IsInCombat() && !m_caster->IsIgnoreUnitState(m_spellInfo, IGNORE_UNIT_COMBAT_STATE))
@@ -5564,11 +5567,11 @@ SpellCastResult Spell::CheckCast(bool strict)
             sWorld.getConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK) &&
             VMAP::VMapFactory::createOrGetVMapManager()->isLineOfSightCalcEnabled())
         {
-            if (m_spellInfo->HasAttribute(SPELL_ATTR_ONLY_OUTDOORS) &&
+            if (m_spellHot->HasAttribute(SPELL_ATTR_ONLY_OUTDOORS) &&
                 !m_caster->GetTerrain()->IsOutdoors(m_caster->GetPositionX(), m_caster->GetPositionY(), m_caster->GetPositionZ()))
                 return SPELL_FAILED_ONLY_OUTDOORS; // TODO: If at least one effect is SPELL_AURA_MOUNTED return mounts not allowed
 
-            if (m_spellInfo->HasAttribute(SPELL_ATTR_ONLY_INDOORS) &&
+            if (m_spellHot->HasAttribute(SPELL_ATTR_ONLY_INDOORS) &&
                 m_caster->GetTerrain()->IsOutdoors(m_caster->GetPositionX(), m_caster->GetPositionY(), m_caster->GetPositionZ()))
                 return SPELL_FAILED_ONLY_INDOORS;
         }
@@ -5585,34 +5588,34 @@ SpellCastResult Spell::CheckCast(bool strict)
                 if (shapeError != SPELL_CAST_OK)
                     return shapeError;
 
-                if (m_spellInfo->HasAttribute(SPELL_ATTR_ONLY_STEALTHED) && !(m_caster->HasStealthAura()))
+                if (m_spellHot->HasAttribute(SPELL_ATTR_ONLY_STEALTHED) && !(m_caster->HasStealthAura()))
                     return SPELL_FAILED_ONLY_STEALTHED;
             }
         }
 
-        if (m_caster->HasAuraTypeWithMiscvalue(SPELL_AURA_BLOCK_SPELL_FAMILY, m_spellInfo->SpellFamilyName))
+        if (m_caster->HasAuraTypeWithMiscvalue(SPELL_AURA_BLOCK_SPELL_FAMILY, m_spellHot->SpellFamilyName))
             return SPELL_FAILED_SPELL_UNAVAILABLE;
 
         // caster state requirements
-        if (m_spellInfo->CasterAuraState && !m_caster->HasAuraState(AuraState(m_spellInfo->CasterAuraState)))
+        if (m_spellHot->CasterAuraState && !m_caster->HasAuraState(AuraState(m_spellHot->CasterAuraState)))
             return SPELL_FAILED_CASTER_AURASTATE;
 
-        if (m_spellInfo->CasterAuraStateNot && m_caster->HasAuraState(AuraState(m_spellInfo->CasterAuraStateNot)))
+        if (m_spellHot->CasterAuraStateNot && m_caster->HasAuraState(AuraState(m_spellHot->CasterAuraStateNot)))
             return SPELL_FAILED_CASTER_AURASTATE;
 
         // Caster aura req check if need
-        if (m_spellInfo->casterAuraSpell && !m_caster->HasAura(m_spellInfo->casterAuraSpell))
+        if (m_spellHot->casterAuraSpell && !m_caster->HasAura(m_spellHot->casterAuraSpell))
             return SPELL_FAILED_CASTER_AURASTATE;
-        if (m_spellInfo->excludeCasterAuraSpell)
+        if (m_spellHot->excludeCasterAuraSpell)
         {
             // Special cases of non existing auras handling
-            if (m_spellInfo->excludeCasterAuraSpell == 61988)
+            if (m_spellHot->excludeCasterAuraSpell == 61988)
             {
                 // Avenging Wrath Marker
                 if (m_caster->HasAura(61987))
                     return SPELL_FAILED_CASTER_AURASTATE;
             }
-            else if (m_caster->HasAura(m_spellInfo->excludeCasterAuraSpell))
+            else if (m_caster->HasAura(m_spellHot->excludeCasterAuraSpell))
                 return SPELL_FAILED_CASTER_AURASTATE;
         }
 
@@ -5622,7 +5625,7 @@ SpellCastResult Spell::CheckCast(bool strict)
             return m_caster->getClass() == CLASS_WARRIOR ? SPELL_FAILED_CASTER_AURASTATE : SPELL_FAILED_NO_COMBO_POINTS;
 
         // Nefarian class calls spell failed
-        switch (m_spellInfo->SpellFamilyName)
+        switch (m_spellHot->SpellFamilyName)
         {
             case SPELLFAMILY_DRUID:
             {
@@ -5655,7 +5658,7 @@ SpellCastResult Spell::CheckCast(bool strict)
                 break;
         }
 
-        if (m_spellInfo->HasAttribute(SPELL_ATTR_EX7_DEBUG_SPELL) && !m_caster->HasFlag(UNIT_FIELD_FLAGS_2, UNIT_FLAG2_ALLOW_CHEAT_SPELLS))
+        if (m_spellHot->HasAttribute(SPELL_ATTR_EX7_DEBUG_SPELL) && !m_caster->HasFlag(UNIT_FIELD_FLAGS_2, UNIT_FLAG2_ALLOW_CHEAT_SPELLS))
         {
             m_param1 = SPELL_FAILED_CUSTOM_ERROR_65;
             return SPELL_FAILED_CUSTOM_ERROR;
@@ -8703,8 +8706,12 @@ SpellCastResult Spell::CanOpenLock(SpellEffectIndex effIndex, uint32 lockId, Ski
  */
 void Spell::FillAreaTargets(UnitList& targetUnitMap, float radius, float cone, SpellNotifyPushType pushType, SpellTargets spellTargets, WorldObject* originalCaster /*=nullptr*/)
 {
-    MaNGOS::SpellNotifierCreatureAndPlayer notifier(*this, targetUnitMap, radius, cone, pushType, spellTargets, originalCaster);
+    // reused by every area search of the map thread, the checks after the grid visit never start another one
+    static thread_local MaNGOS::SpellAreaCandidates candidates;
+
+    MaNGOS::SpellNotifierCreatureAndPlayer notifier(*this, targetUnitMap, candidates, radius, cone, pushType, spellTargets, originalCaster);
     Cell::VisitAllObjects(notifier.GetCenterX(), notifier.GetCenterY(), m_trueCaster->GetMap(), notifier, radius);
+    notifier.PushInRange();
 }
 
 void Spell::FillRaidOrPartyTargets(UnitList& targetUnitMap, Unit* member, Unit* center, float radius, bool raid, bool withPets, bool withcaster) const
@@ -9166,6 +9173,30 @@ void Spell::ProcReflectProcs(TargetInfo& targetInfo)
         Unit::ProcDamageAndSpell(ProcSystemArguments(m_caster, m_caster, PROC_FLAG_NONE, PROC_FLAG_TAKE_HARMFUL_SPELL, PROC_EX_REFLECT, 1, 0, BASE_ATTACK, m_spellInfo));
 }
 
+// keeps the first count units in the order a stable sort by comp would give them, without sorting the rest
+template<class Compare>
+static void KeepFirstSorted(UnitList& units, uint32 count, Compare comp)
+{
+    std::vector<std::pair<Unit*, uint32>> ordered;
+    ordered.reserve(units.size());
+    for (Unit* unit : units)
+        ordered.emplace_back(unit, uint32(ordered.size()));
+
+    // equal units stay in list order, like with list::sort
+    std::partial_sort(ordered.begin(), ordered.begin() + count, ordered.end(), [&comp](std::pair<Unit*, uint32> const& left, std::pair<Unit*, uint32> const& right)
+    {
+        if (comp(left.first, right.first))
+            return true;
+        if (comp(right.first, left.first))
+            return false;
+        return left.second < right.second;
+    });
+
+    units.clear();
+    for (uint32 i = 0; i < count; ++i)
+        units.push_back(ordered[i].first);
+}
+
 void Spell::FilterTargetMap(UnitList& filterUnitList, SpellTargetFilterScheme scheme, uint32 chainTargetCount)
 {
     switch (scheme)
@@ -9188,10 +9219,7 @@ void Spell::FilterTargetMap(UnitList& filterUnitList, SpellTargetFilterScheme sc
         case SCHEME_CLOSEST:
         {
             if (m_affectedTargetCount && filterUnitList.size() > m_affectedTargetCount)
-            {
-                filterUnitList.sort(TargetDistanceOrderNear(m_trueCaster));
-                filterUnitList.resize(m_affectedTargetCount);
-            }
+                KeepFirstSorted(filterUnitList, m_affectedTargetCount, TargetDistanceOrderNear(m_trueCaster));
             break;
         }
         case SCHEME_FURTHEST:
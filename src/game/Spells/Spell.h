@@ -38,6 +38,7 @@ class GameObject;
 class Group;
 class Aura;
 struct SpellTargetEntry;
+struct SpellHotEntry;
 struct SpellScript;
 struct AuraScript;
 struct SpellTargetingData;
@@ -636,6 +637,7 @@ class Spell
         Item* GetCastItem() { return m_CastItem; }
 
         SpellEntry const* m_spellInfo;
+        SpellHotEntry const* m_spellHot;                    // cast check fields of m_spellInfo
         SpellEntry const* m_triggeredBySpellInfo;
         int32 m_currentBasePoints[MAX_EFFECT_INDEX];        // cache SpellEntry::CalculateSimpleValue and use for set custom base points
         uint8 m_cast_count;
@@ -1157,9 +1159,47 @@ namespace MaNGOS
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
 
+    /**
+     * Units found by a SpellNotifierCreatureAndPlayer grid visit, one array per field.
+     * Range checks of all candidates run as one loop over the plain float arrays,
+     * everything else is checked only for the ones in range.
+     */
+    struct SpellAreaCandidates
+    {
+        std::vector<Unit*> units;
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+        std::vector<float> extraRadius;                     // added to the area radius for this unit
+        std::vector<uint8> inRange;
+
+        void clear()
+        {
+            units.clear();
+            x.clear();
+            y.clear();
+            z.clear();
+            extraRadius.clear();
+            inRange.clear();
+        }
+
+        void Add(Unit* unit, float extra)
+        {
+            Position const& pos = unit->GetPosition();
+            units.push_back(unit);
+            x.push_back(pos.x);
+            y.push_back(pos.y);
+            z.push_back(pos.z);
+            extraRadius.push_back(extra);
+        }
+
+        size_t size() const { return units.size(); }
+    };
+
     struct SpellNotifierCreatureAndPlayer
     {
         UnitList& i_data;
+        SpellAreaCandidates& i_candidates;
         Spell& i_spell;
         SpellNotifyPushType i_push_type;
         float i_radius;
@@ -1175,14 +1215,15 @@ namespace MaNGOS
         float GetCenterX() const { return i_centerX; }
         float GetCenterY() const { return i_centerY; }
 
-        SpellNotifierCreatureAndPlayer(Spell& spell, UnitList& data, float radius, float cone, SpellNotifyPushType type,
+        SpellNotifierCreatureAndPlayer(Spell& spell, UnitList& data, SpellAreaCandidates& candidates, float radius, float cone, SpellNotifyPushType type,
                                        SpellTargets TargetType = SPELL_TARGETS_AOE_ATTACKABLE, WorldObject* originalCaster = nullptr)
-            : i_data(data), i_spell(spell), i_push_type(type), i_radius(radius), i_cone(cone), i_TargetType(TargetType),
+            : i_data(data), i_candidates(candidates), i_spell(spell), i_push_type(type), i_radius(radius), i_cone(cone), i_TargetType(TargetType),
               i_originalCaster(originalCaster), i_castingObject(i_spell.GetCastingObject())
         {
             if (!i_originalCaster)
                 i_originalCaster = i_spell.GetAffectiveCasterObject();
             i_playerControlled = i_originalCaster  ? i_originalCaster->IsControlledByPlayer() : false;
+            i_candidates.clear();
 
             switch (i_push_type)
             {
@@ -1216,6 +1257,7 @@ namespace MaNGOS
             }
         }
 
+        // grid visit only gathers units passing the checks on their own state
         template<class T> inline void Visit(GridRefManager<T>& m)
         {
             if (!i_originalCaster || !i_castingObject)
@@ -1247,67 +1289,134 @@ namespace MaNGOS
                         if (itr->getSource()->IsAOEImmune())
                             continue;
                         break;
-                    default: break;
-                }
-
-                switch (i_TargetType)
-                {
                     case SPELL_TARGETS_ASSISTABLE:
-                        if (!i_originalCaster->CanAssistSpell(itr->getSource(), i_spell.m_spellInfo))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_CHAIN_ATTACKABLE:
-                    case SPELL_TARGETS_AOE_ATTACKABLE:
-                    {
-                        if (!i_originalCaster->CanAttackSpell(itr->getSource(), i_spell.m_spellInfo, !i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX5_IGNORE_AREA_EFFECT_PVP_CHECK)))
-                            continue;
-                        break;
-                    }
                     case SPELL_TARGETS_ALL:
                         break;
                     default: continue;
                 }
 
-                // we don't need to check InMap here, it's already done some lines above
+                // widest distance the exact check in PushInRange can accept for this unit
+                float extraRadius;
                 switch (i_push_type)
                 {
                     case PUSH_CONE:
-                    {
-                        float heightDifference = std::abs(itr->getSource()->GetPositionZ() - i_centerZ);
-                        float maxHeight = i_radius / 2;
-                        float distance = std::min(sqrtf(itr->getSource()->GetDistance2d(i_centerX, i_centerY, DIST_CALC_NONE)), i_radius);
-                        float ratio = distance / i_radius;
-                        float conalMaxHeight = maxHeight * ratio; // pvp combat uses true cone from roughly model
-                        if (!i_originalCaster->IsControlledByPlayer() && itr->getSource()->IsControlledByPlayer())
-                            conalMaxHeight = maxHeight; // npcs just do a conal max Z aoe
-                        if (i_cone >= 0.f)
-                        {
-                            if (i_castingObject->isInFront(itr->getSource(), i_radius, i_cone) &&
-                                std::abs(itr->getSource()->GetPositionZ() - i_centerZ) - itr->getSource()->GetCombatReach() <= conalMaxHeight)
-                                i_data.push_back(itr->getSource());
-                        }
-                        else
-                        {
-                            if (i_castingObject->isInBack(itr->getSource(), i_radius, -i_cone) &&
-                                std::abs(itr->getSource()->GetPositionZ() - i_centerZ) - itr->getSource()->GetCombatReach() <= conalMaxHeight)
-                                i_data.push_back(itr->getSource());
-                        }
-                        break;
-                    }
                     case PUSH_SELF_CENTER:
-                        if (itr->getSource()->GetDistance2d(i_centerX, i_centerY, DIST_CALC_COMBAT_REACH) <= i_radius)
-                            i_data.push_back(itr->getSource());
+                        extraRadius = itr->getSource()->GetCombatReach();
                         break;
-                    case PUSH_SRC_CENTER:
-                    case PUSH_DEST_CENTER:
-                    case PUSH_TARGET_CENTER:
-                        float radius = i_radius;
-                        if (i_originalCaster->IsControlledByPlayer() && !itr->getSource()->IsControlledByPlayer())
-                            radius += itr->getSource()->GetCombatReach();
-                        if (itr->getSource()->GetDistance(i_centerX, i_centerY, i_centerZ, DIST_CALC_NONE) <= radius * radius)
-                            i_data.push_back(itr->getSource());
+                    default:
+                        extraRadius = i_originalCaster->IsControlledByPlayer() && !itr->getSource()->IsControlledByPlayer() ? itr->getSource()->GetCombatReach() : 0.f;
                         break;
                 }
+
+                i_candidates.Add(itr->getSource(), extraRadius);
+            }
+        }
+
+        // after the grid visit: range filter over all gathered units, then the exact area and relation checks
+        // of the original per unit order for the ones left, in the order the grid visit found them
+        void PushInRange()
+        {
+            if (!i_originalCaster || !i_castingObject)
+                return;
+
+            FilterByDistance();
+
+            for (size_t i = 0; i < i_candidates.size(); ++i)
+            {
+                if (!i_candidates.inRange[i])
+                    continue;
+
+                Unit* unit = i_candidates.units[i];
+                if (IsInArea(unit) && IsValidRelation(unit))
+                    i_data.push_back(unit);
+            }
+        }
+
+        // coarse and branch free, so it can vectorize: a slightly widened sphere (circle for PUSH_SELF_CENTER) around the center
+        // never drops a unit that IsInArea accepts, float rounding of the exact checks stays inside the margin
+        void FilterByDistance()
+        {
+            size_t count = i_candidates.size();
+            i_candidates.inRange.resize(count);
+
+            float const* x = i_candidates.x.data();
+            float const* y = i_candidates.y.data();
+            float const* z = i_candidates.z.data();
+            float const* extraRadius = i_candidates.extraRadius.data();
+            uint8* inRange = i_candidates.inRange.data();
+            float const centerX = i_centerX, centerY = i_centerY, centerZ = i_centerZ;
+            float const radius = i_radius;
+
+            if (i_push_type == PUSH_SELF_CENTER)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    float dx = x[i] - centerX;
+                    float dy = y[i] - centerY;
+                    float maxDist = radius + extraRadius[i];
+                    inRange[i] = dx * dx + dy * dy <= maxDist * maxDist * 1.001f + 0.01f;
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    float dx = x[i] - centerX;
+                    float dy = y[i] - centerY;
+                    float dz = z[i] - centerZ;
+                    float maxDist = radius + extraRadius[i];
+                    inRange[i] = dx * dx + dy * dy + dz * dz <= maxDist * maxDist * 1.001f + 0.01f;
+                }
+            }
+        }
+
+        bool IsValidRelation(Unit* unit) const
+        {
+            switch (i_TargetType)
+            {
+                case SPELL_TARGETS_ASSISTABLE:
+                    return i_originalCaster->CanAssistSpell(unit, i_spell.m_spellInfo);
+                case SPELL_TARGETS_CHAIN_ATTACKABLE:
+                case SPELL_TARGETS_AOE_ATTACKABLE:
+                    return i_originalCaster->CanAttackSpell(unit, i_spell.m_spellInfo, !i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX5_IGNORE_AREA_EFFECT_PVP_CHECK));
+                default:
+                    return true;
+            }
+        }
+
+        // we don't need to check InMap here, it's already done at the grid visit
+        bool IsInArea(Unit* unit) const
+        {
+            switch (i_push_type)
+            {
+                case PUSH_CONE:
+                {
+                    float maxHeight = i_radius / 2;
+                    float distance = std::min(sqrtf(unit->GetDistance2d(i_centerX, i_centerY, DIST_CALC_NONE)), i_radius);
+                    float ratio = distance / i_radius;
+                    float conalMaxHeight = maxHeight * ratio; // pvp combat uses true cone from roughly model
+                    if (!i_originalCaster->IsControlledByPlayer() && unit->IsControlledByPlayer())
+                        conalMaxHeight = maxHeight; // npcs just do a conal max Z aoe
+                    if (i_cone >= 0.f)
+                        return i_castingObject->isInFront(unit, i_radius, i_cone) &&
+                               std::abs(unit->GetPositionZ() - i_centerZ) - unit->GetCombatReach() <= conalMaxHeight;
+
+                    return i_castingObject->isInBack(unit, i_radius, -i_cone) &&
+                           std::abs(unit->GetPositionZ() - i_centerZ) - unit->GetCombatReach() <= conalMaxHeight;
+                }
+                case PUSH_SELF_CENTER:
+                    return unit->GetDistance2d(i_centerX, i_centerY, DIST_CALC_COMBAT_REACH) <= i_radius;
+                case PUSH_SRC_CENTER:
+                case PUSH_DEST_CENTER:
+                case PUSH_TARGET_CENTER:
+                {
+                    float radius = i_radius;
+                    if (i_originalCaster->IsControlledByPlayer() && !unit->IsControlledByPlayer())
+                        radius += unit->GetCombatReach();
+                    return unit->GetDistance(i_centerX, i_centerY, i_centerZ, DIST_CALC_NONE) <= radius * radius;
+                }
+                default:
+                    return false;
             }
         }
 
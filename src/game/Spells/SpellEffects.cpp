@@ -4436,6 +4436,7 @@ void Spell::EffectClearQuest(SpellEffectIndex eff_idx)
 
     player->SetQuestStatus(quest_id, QUEST_STATUS_NONE);
     player->getQuestStatusMap()[quest_id].m_rewarded = false;
+    player->InvalidateQuestGiverStatus();
 }
 
 void Spell::EffectForceCast(SpellEffectIndex effIndex)
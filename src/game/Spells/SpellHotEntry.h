@@ -0,0 +1,81 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SPELLHOTENTRY_H
+#define MANGOS_SPELLHOTENTRY_H
+
+#include "Common.h"
+#include "Server/DBCStructure.h"
+
+/**
+ * The SpellEntry fields read by cast checks and target selection of every cast, packed into two cache lines.
+ *
+ * SpellEntry is close to a kilobyte and those fields are spread over most of it, names, visuals and item
+ * requirements sit in between. SpellMgr builds one of these per spell_template record, stored next to each
+ * other, see SpellMgr::GetSpellHotEntry. Fields keep the SpellEntry names and meaning, code can switch from
+ * the SpellEntry to this view one check at a time. Fields narrower than in SpellEntry are checked to fit at load.
+ */
+struct SpellHotEntry
+{
+    uint32    Id;
+    uint32    Attributes;
+    uint32    AttributesEx;
+    uint32    AttributesEx2;
+    uint32    AttributesEx3;
+    uint32    AttributesEx4;
+    uint32    AttributesEx5;
+    uint32    AttributesEx6;
+    uint32    AttributesEx7;
+    uint32    AttributesServerside;
+    uint32    Targets;
+    uint32    casterAuraSpell;
+    uint32    targetAuraSpell;
+    uint32    excludeCasterAuraSpell;
+    uint32    excludeTargetAuraSpell;
+    uint32    AuraInterruptFlags;
+    uint32    InterruptFlags;
+    uint16    Effect[MAX_EFFECT_INDEX];
+    uint16    EffectImplicitTargetA[MAX_EFFECT_INDEX];
+    uint16    EffectImplicitTargetB[MAX_EFFECT_INDEX];
+    uint16    EffectApplyAuraName[MAX_EFFECT_INDEX];
+    uint16    CastingTimeIndex;
+    uint16    DurationIndex;
+    uint16    rangeIndex;
+    uint8     CasterAuraState;
+    uint8     TargetAuraState;
+    uint8     CasterAuraStateNot;
+    uint8     TargetAuraStateNot;
+    uint8     SpellFamilyName;
+    uint8     DmgClass;
+    uint8     PreventionType;
+    uint8     Mechanic;
+    uint8     Dispel;
+    uint8     SchoolMask;
+
+    inline bool HasAttribute(SpellAttributes attribute) const { return (Attributes & attribute) != 0; }
+    inline bool HasAttribute(SpellAttributesEx attribute) const { return (AttributesEx & attribute) != 0; }
+    inline bool HasAttribute(SpellAttributesEx2 attribute) const { return (AttributesEx2 & attribute) != 0; }
+    inline bool HasAttribute(SpellAttributesEx3 attribute) const { return (AttributesEx3 & attribute) != 0; }
+    inline bool HasAttribute(SpellAttributesEx4 attribute) const { return (AttributesEx4 & attribute) != 0; }
+    inline bool HasAttribute(SpellAttributesEx5 attribute) const { return (AttributesEx5 & attribute) != 0; }
+    inline bool HasAttribute(SpellAttributesEx6 attribute) const { return (AttributesEx6 & attribute) != 0; }
+    inline bool HasAttribute(SpellAttributesEx7 attribute) const { return (AttributesEx7 & attribute) != 0; }
+    bool HasAttribute(SpellAttributesServerside attribute) const { return (AttributesServerside & attribute) != 0; }
+};
+
+#endif
@@ -42,7 +42,7 @@ bool IsPrimaryProfessionSkill(uint32 skill)
     return true;
 }
 
-SpellMgr::SpellMgr()
+SpellMgr::SpellMgr() : m_spellProcEventGeneration(0)
 {
 }
 
@@ -830,6 +830,7 @@ struct DoSpellProcEvent
 void SpellMgr::LoadSpellProcEvents()
 {
     mSpellProcEventMap.clear();                             // need for reload case
+    ++m_spellProcEventGeneration;                           // proc indexes of units get built again
 
     //                                             0      1           2                3                  4                  5                  6                  7                  8                  9                  10                 11                 12         13      14       15            16
     auto queryResult = WorldDatabase.Query("SELECT entry, SchoolMask, SpellFamilyName, SpellFamilyMaskA0, SpellFamilyMaskA1, SpellFamilyMaskA2, SpellFamilyMaskB0, SpellFamilyMaskB1, SpellFamilyMaskB2, SpellFamilyMaskC0, SpellFamilyMaskC1, SpellFamilyMaskC2, procFlags, procEx, ppmRate, CustomChance, Cooldown FROM spell_proc_event");
@@ -892,6 +893,7 @@ struct DoSpellProcItemEnchant
 void SpellMgr::LoadSpellProcItemEnchant()
 {
     mSpellProcItemEnchantMap.clear();                       // need for reload case
+    mSpellProcItemEnchantTable.clear();
 
     uint32 count = 0;
 
@@ -944,6 +946,8 @@ void SpellMgr::LoadSpellProcItemEnchant()
     }
     while (queryResult->NextRow());
 
+    mSpellProcItemEnchantTable.Assign(mSpellProcItemEnchantMap);
+
     sLog.outString(">> Loaded %u proc item enchant definitions", count);
     sLog.outString();
 }
@@ -1083,6 +1087,7 @@ bool SpellMgr::IsSpellProcEventCanTriggeredBy(SpellProcEventEntry const* spellPr
 void SpellMgr::LoadSpellElixirs()
 {
     mSpellElixirs.clear();                                  // need for reload case
+    mSpellElixirTable.clear();
 
     uint32 count = 0;
 
@@ -1124,6 +1129,8 @@ void SpellMgr::LoadSpellElixirs()
     }
     while (queryResult->NextRow());
 
+    mSpellElixirTable.Assign(mSpellElixirs);
+
     sLog.outString(">> Loaded %u spell elixir definitions", count);
     sLog.outString();
 }
@@ -1196,6 +1203,7 @@ struct DoSpellThreat
 void SpellMgr::LoadSpellThreats()
 {
     mSpellThreatMap.clear();                                // need for reload case
+    mSpellThreatTable.clear();
 
     //                                             0      1       2           3
     auto queryResult = WorldDatabase.Query("SELECT entry, Threat, multiplier, ap_bonus FROM spell_threat");
@@ -1231,6 +1239,8 @@ void SpellMgr::LoadSpellThreats()
 
     rankHelper.FillHigherRanks();
 
+    mSpellThreatTable.Assign(mSpellThreatMap);
+
     sLog.outString(">> Loaded %u spell threat entries", rankHelper.worker.count);
     sLog.outString();
 }
@@ -1464,10 +1474,87 @@ static void LoadSpellChains_AbilityHelper(SpellChainMap& chainMap, AbilitySpellP
     chainMap[spell_id] = node;
 }
 
+// copies a SpellEntry field into its narrower SpellHotEntry field, false if the value does not fit
+template<typename Field, typename Value>
+static bool SetHotField(Field& field, Value value)
+{
+    field = Field(value);
+    return Value(field) == value;
+}
+
+void SpellMgr::LoadSpellHotEntries()
+{
+    mSpellHotEntries.clear();                               // need for reload case
+    mSpellHotEntries.reserve(sSpellTemplate.GetMaxEntry(), sSpellTemplate.GetRecordCount());
+
+    uint32 count = 0;
+
+    BarGoLink bar(sSpellTemplate.GetMaxEntry());
+    for (uint32 spellId = 1; spellId < sSpellTemplate.GetMaxEntry(); ++spellId)
+    {
+        bar.step();
+
+        SpellEntry const* spellInfo = sSpellTemplate.LookupEntry<SpellEntry>(spellId);
+        if (!spellInfo)
+            continue;
+
+        SpellHotEntry hot;
+        hot.Id                     = spellInfo->Id;
+        hot.Attributes             = spellInfo->Attributes;
+        hot.AttributesEx           = spellInfo->AttributesEx;
+        hot.AttributesEx2          = spellInfo->AttributesEx2;
+        hot.AttributesEx3          = spellInfo->AttributesEx3;
+        hot.AttributesEx4          = spellInfo->AttributesEx4;
+        hot.AttributesEx5          = spellInfo->AttributesEx5;
+        hot.AttributesEx6          = spellInfo->AttributesEx6;
+        hot.AttributesEx7          = spellInfo->AttributesEx7;
+        hot.AttributesServerside   = spellInfo->AttributesServerside;
+        hot.Targets                = spellInfo->Targets;
+        hot.casterAuraSpell        = spellInfo->casterAuraSpell;
+        hot.targetAuraSpell        = spellInfo->targetAuraSpell;
+        hot.excludeCasterAuraSpell = spellInfo->excludeCasterAuraSpell;
+        hot.excludeTargetAuraSpell = spellInfo->excludeTargetAuraSpell;
+        hot.AuraInterruptFlags     = spellInfo->AuraInterruptFlags;
+        hot.InterruptFlags         = spellInfo->InterruptFlags;
+
+        bool fits = true;
+        for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+        {
+            fits &= SetHotField(hot.Effect[i], spellInfo->Effect[i]);
+            fits &= SetHotField(hot.EffectImplicitTargetA[i], spellInfo->EffectImplicitTargetA[i]);
+            fits &= SetHotField(hot.EffectImplicitTargetB[i], spellInfo->EffectImplicitTargetB[i]);
+            fits &= SetHotField(hot.EffectApplyAuraName[i], spellInfo->EffectApplyAuraName[i]);
+        }
+        fits &= SetHotField(hot.CastingTimeIndex, spellInfo->CastingTimeIndex);
+        fits &= SetHotField(hot.DurationIndex, spellInfo->DurationIndex);
+        fits &= SetHotField(hot.rangeIndex, spellInfo->rangeIndex);
+        fits &= SetHotField(hot.CasterAuraState, spellInfo->CasterAuraState);
+        fits &= SetHotField(hot.TargetAuraState, spellInfo->TargetAuraState);
+        fits &= SetHotField(hot.CasterAuraStateNot, spellInfo->CasterAuraStateNot);
+        fits &= SetHotField(hot.TargetAuraStateNot, spellInfo->TargetAuraStateNot);
+        fits &= SetHotField(hot.SpellFamilyName, spellInfo->SpellFamilyName);
+        fits &= SetHotField(hot.DmgClass, spellInfo->DmgClass);
+        fits &= SetHotField(hot.PreventionType, spellInfo->PreventionType);
+        fits &= SetHotField(hot.Mechanic, spellInfo->Mechanic);
+        fits &= SetHotField(hot.Dispel, spellInfo->Dispel);
+        fits &= SetHotField(hot.SchoolMask, spellInfo->SchoolMask);
+
+        if (!fits)
+            sLog.outErrorDb("Spell %u in `spell_template` has an effect, target, aura, index, aura state or school value out of range, checks using its cast check data will see it cut off", spellId);
+
+        mSpellHotEntries.Insert(spellId, hot);
+        ++count;
+    }
+
+    sLog.outString(">> Built cast check data of %u spells (%u bytes each)", count, uint32(sizeof(SpellHotEntry)));
+    sLog.outString();
+}
+
 void SpellMgr::LoadSpellChains()
 {
     mSpellChains.clear();                                   // need for reload case
     mSpellChainsNext.clear();                               // need for reload case
+    mSpellChainTable.clear();
 
     // load known data for talents
     for (unsigned int i = 0; i < sTalentStore.GetNumRows(); ++i)
@@ -1585,6 +1672,8 @@ void SpellMgr::LoadSpellChains()
         BarGoLink bar(1);
         bar.step();
 
+        mSpellChainTable.Assign(mSpellChains);
+
         sLog.outString(">> Loaded 0 spell chain records");
         sLog.outErrorDb("`spell_chains` table is empty!");
         sLog.outString();
@@ -1801,18 +1890,22 @@ void SpellMgr::LoadSpellChains()
     }
 
     // fill next rank cache
+    std::multimap<uint32, uint32> chainsNext;
     for (SpellChainMap::const_iterator i = mSpellChains.begin(); i != mSpellChains.end(); ++i)
     {
         uint32 spell_id = i->first;
         SpellChainNode const& node = i->second;
 
         if (node.prev)
-            mSpellChainsNext.insert(SpellChainMapNext::value_type(node.prev, spell_id));
+            chainsNext.insert(SpellChainMapNext::value_type(node.prev, spell_id));
 
         if (node.req)
-            mSpellChainsNext.insert(SpellChainMapNext::value_type(node.req, spell_id));
+            chainsNext.insert(SpellChainMapNext::value_type(node.req, spell_id));
     }
 
+    mSpellChainsNext.Assign(chainsNext);
+    mSpellChainTable.Assign(mSpellChains);
+
     // check single rank redundant cases (single rank talents/spell abilities not added by default so this can be only custom cases)
     for (SpellChainMap::const_iterator i = mSpellChains.begin(); i != mSpellChains.end(); ++i)
     {
@@ -1873,6 +1966,8 @@ void SpellMgr::LoadSpellLearnSpells()
 {
     mSpellLearnSpells.clear();                              // need for reload case
 
+    std::multimap<uint32, SpellLearnSpellNode> learnSpells;
+
     //                                             0      1        2
     auto queryResult = WorldDatabase.Query("SELECT entry, SpellID, Active FROM spell_learn_spell");
     if (!queryResult)
@@ -1919,7 +2014,7 @@ void SpellMgr::LoadSpellLearnSpells()
             continue;
         }
 
-        mSpellLearnSpells.insert(SpellLearnSpellMap::value_type(spell_id, node));
+        learnSpells.insert(SpellLearnSpellMap::value_type(spell_id, node));
 
         ++count;
     }
@@ -1951,10 +2046,10 @@ void SpellMgr::LoadSpellLearnSpells()
                 // other required explicit dependent learning
                 dbc_node.autoLearned = entry->EffectImplicitTargetA[i] == TARGET_UNIT_CASTER_PET || GetTalentSpellCost(spell) > 0 || IsPassiveSpell(entry) || IsSpellHaveEffect(entry, SPELL_EFFECT_SKILL_STEP);
 
-                SpellLearnSpellMapBounds db_node_bounds = GetSpellLearnSpellMapBounds(spell);
+                auto db_node_bounds = learnSpells.equal_range(spell);
 
                 bool found = false;
-                for (SpellLearnSpellMap::const_iterator itr = db_node_bounds.first; itr != db_node_bounds.second; ++itr)
+                for (auto itr = db_node_bounds.first; itr != db_node_bounds.second; ++itr)
                 {
                     if (itr->second.spell == dbc_node.spell)
                     {
@@ -1967,13 +2062,15 @@ void SpellMgr::LoadSpellLearnSpells()
 
                 if (!found)                                 // add new spell-spell pair if not found
                 {
-                    mSpellLearnSpells.insert(SpellLearnSpellMap::value_type(spell, dbc_node));
+                    learnSpells.insert(SpellLearnSpellMap::value_type(spell, dbc_node));
                     ++dbc_count;
                 }
             }
         }
     }
 
+    mSpellLearnSpells.Assign(learnSpells);
+
     sLog.outString(">> Loaded %u spell learn spells + %u found in DBC", count, dbc_count);
     sLog.outString();
 }
@@ -2479,6 +2576,12 @@ void SpellMgr::LoadSpellAreas()
 {
     mSpellAreaMap.clear();                                  // need for reload case
     mSpellAreaForAuraMap.clear();
+    mSpellAreaForAreaMap.clear();
+
+    // filled while loading, SpellArea pointers point into spellAreas until all are compiled
+    std::multimap<uint32, SpellArea> spellAreas;
+    std::multimap<uint32, SpellArea const*> spellAreasForAura;
+    std::multimap<uint32, SpellArea const*> spellAreasForArea;
 
     uint32 count = 0;
 
@@ -2523,8 +2626,8 @@ void SpellMgr::LoadSpellAreas()
 
         {
             bool ok = true;
-            SpellAreaMapBounds sa_bounds = GetSpellAreaMapBounds(spellArea.spellId);
-            for (SpellAreaMap::const_iterator itr = sa_bounds.first; itr != sa_bounds.second; ++itr)
+            auto sa_bounds = spellAreas.equal_range(spellArea.spellId);
+            for (auto itr = sa_bounds.first; itr != sa_bounds.second; ++itr)
             {
                 if (spellArea.spellId != itr->second.spellId)
                     continue;
@@ -2636,8 +2739,8 @@ void SpellMgr::LoadSpellAreas()
             if (spellArea.autocast && spellArea.auraSpell > 0)
             {
                 bool chain = false;
-                SpellAreaForAuraMapBounds saBound = GetSpellAreaForAuraMapBounds(spellArea.spellId);
-                for (SpellAreaForAuraMap::const_iterator itr = saBound.first; itr != saBound.second; ++itr)
+                auto saBound = spellAreasForAura.equal_range(spellArea.spellId);
+                for (auto itr = saBound.first; itr != saBound.second; ++itr)
                 {
                     if (itr->second->autocast && itr->second->auraSpell > 0)
                     {
@@ -2652,8 +2755,8 @@ void SpellMgr::LoadSpellAreas()
                     continue;
                 }
 
-                SpellAreaMapBounds saBound2 = GetSpellAreaMapBounds(spellArea.auraSpell);
-                for (SpellAreaMap::const_iterator itr2 = saBound2.first; itr2 != saBound2.second; ++itr2)
+                auto saBound2 = spellAreas.equal_range(spellArea.auraSpell);
+                for (auto itr2 = saBound2.first; itr2 != saBound2.second; ++itr2)
                 {
                     if (itr2->second.autocast && itr2->second.auraSpell > 0)
                     {
@@ -2670,20 +2773,36 @@ void SpellMgr::LoadSpellAreas()
             }
         }
 
-        SpellArea const* sa = &mSpellAreaMap.insert(SpellAreaMap::value_type(spell, spellArea))->second;
+        SpellArea const* sa = &spellAreas.insert(SpellAreaMap::value_type(spell, spellArea))->second;
 
         // for search by current zone/subzone at zone/subzone change
         if (spellArea.areaId)
-            mSpellAreaForAreaMap.insert(SpellAreaForAreaMap::value_type(spellArea.areaId, sa));
+            spellAreasForArea.insert(SpellAreaForAreaMap::value_type(spellArea.areaId, sa));
 
         // for search at aura apply
         if (spellArea.auraSpell)
-            mSpellAreaForAuraMap.insert(SpellAreaForAuraMap::value_type(abs(spellArea.auraSpell), sa));
+            spellAreasForAura.insert(SpellAreaForAuraMap::value_type(abs(spellArea.auraSpell), sa));
 
         ++count;
     }
     while (queryResult->NextRow());
 
+    mSpellAreaMap.Assign(spellAreas);
+
+    // compiled in the same order, point the lookups by area and aura to the compiled records
+    std::unordered_map<SpellArea const*, SpellArea const*> compiled;
+    SpellAreaMap::const_iterator compiledItr = mSpellAreaMap.begin();
+    for (auto const& itr : spellAreas)
+        compiled[&itr.second] = &(compiledItr++)->second;
+
+    for (auto& itr : spellAreasForArea)
+        itr.second = compiled[itr.second];
+    for (auto& itr : spellAreasForAura)
+        itr.second = compiled[itr.second];
+
+    mSpellAreaForAreaMap.Assign(spellAreasForArea);
+    mSpellAreaForAuraMap.Assign(spellAreasForAura);
+
     sLog.outString(">> Loaded %u spell area requirements", count);
     sLog.outString();
 }
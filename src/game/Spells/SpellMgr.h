@@ -35,6 +35,8 @@
 #include "Spells/SpellAuras.h"
 #include "Server/SQLStorages.h"
 #include "Spells/SpellEffectDefines.h"
+#include "Spells/FlatIdMap.h"
+#include "Spells/SpellHotEntry.h"
 
 #include <map>
 
@@ -2680,9 +2682,10 @@ struct SpellArea
     void ApplyOrRemoveSpellIfCan(Player* player, uint32 newZone, uint32 newArea, bool onlyApply) const;
 };
 
-typedef std::multimap<uint32 /*applySpellId*/, SpellArea> SpellAreaMap;
-typedef std::multimap<uint32 /*auraSpellId*/, SpellArea const*> SpellAreaForAuraMap;
-typedef std::multimap<uint32 /*areaOrZoneId*/, SpellArea const*> SpellAreaForAreaMap;
+// compiled from multimaps at load, see LoadSpellAreas
+typedef FlatIdMultiMap<SpellArea> SpellAreaMap;                             // by applySpellId
+typedef FlatIdMultiMap<SpellArea const*> SpellAreaForAuraMap;               // by auraSpellId
+typedef FlatIdMultiMap<SpellArea const*> SpellAreaForAreaMap;               // by areaOrZoneId
 typedef std::pair<SpellAreaMap::const_iterator, SpellAreaMap::const_iterator> SpellAreaMapBounds;
 typedef std::pair<SpellAreaForAuraMap::const_iterator, SpellAreaForAuraMap::const_iterator>  SpellAreaForAuraMapBounds;
 typedef std::pair<SpellAreaForAreaMap::const_iterator, SpellAreaForAreaMap::const_iterator>  SpellAreaForAreaMapBounds;
@@ -2697,7 +2700,7 @@ struct SpellChainNode
 };
 
 typedef std::unordered_map<uint32, SpellChainNode> SpellChainMap;
-typedef std::multimap<uint32, uint32> SpellChainMapNext;
+typedef FlatIdMultiMap<uint32> SpellChainMapNext;          // compiled at LoadSpellChains
 
 // Spell learning properties (accessed using SpellMgr functions)
 struct SpellLearnSkillNode
@@ -2716,7 +2719,7 @@ struct SpellLearnSpellNode
     bool autoLearned;
 };
 
-typedef std::multimap<uint32, SpellLearnSpellNode> SpellLearnSpellMap;
+typedef FlatIdMultiMap<SpellLearnSpellNode> SpellLearnSpellMap;   // compiled at LoadSpellLearnSpells
 typedef std::pair<SpellLearnSpellMap::const_iterator, SpellLearnSpellMap::const_iterator> SpellLearnSpellMapBounds;
 
 typedef std::multimap<uint32, SkillLineAbilityEntry const*> SkillLineAbilityMap;
@@ -2770,11 +2773,11 @@ class SpellMgr
 
         uint32 GetSpellElixirMask(uint32 spellid) const
         {
-            SpellElixirMap::const_iterator itr = mSpellElixirs.find(spellid);
-            if (itr == mSpellElixirs.end())
+            uint8 const* mask = mSpellElixirTable.Find(spellid);
+            if (!mask)
                 return 0x0;
 
-            return itr->second;
+            return *mask;
         }
 
         SpellSpecific GetSpellElixirSpecific(uint32 spellid) const
@@ -2976,11 +2979,7 @@ class SpellMgr
 
         SpellThreatEntry const* GetSpellThreatEntry(uint32 spellid) const
         {
-            SpellThreatMap::const_iterator itr = mSpellThreatMap.find(spellid);
-            if (itr != mSpellThreatMap.end())
-                return &itr->second;
-
-            return nullptr;
+            return mSpellThreatTable.Find(spellid);
         }
 
         float GetSpellThreatMultiplier(SpellEntry const* spellInfo) const
@@ -3003,14 +3002,17 @@ class SpellMgr
             return nullptr;
         }
 
+        // changes with every (re)load of spell_proc_event
+        uint32 GetSpellProcEventGeneration() const { return m_spellProcEventGeneration; }
+
         // Spell procs from item enchants
         float GetItemEnchantProcChance(uint32 spellid) const
         {
-            SpellProcItemEnchantMap::const_iterator itr = mSpellProcItemEnchantMap.find(spellid);
-            if (itr == mSpellProcItemEnchantMap.end())
+            float const* ppmRate = mSpellProcItemEnchantTable.Find(spellid);
+            if (!ppmRate)
                 return 0.0f;
 
-            return itr->second;
+            return *ppmRate;
         }
 
         static bool IsSpellProcEventCanTriggeredBy(SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, SpellEntry const* spellInfo, uint32 procFlags, uint32 procExtra);
@@ -3024,14 +3026,13 @@ class SpellMgr
             return nullptr;
         }
 
+        // Cast check fields of spell_template records, packed
+        SpellHotEntry const* GetSpellHotEntry(uint32 spellId) const { return mSpellHotEntries.Find(spellId); }
+
         // Spell ranks chains
         SpellChainNode const* GetSpellChainNode(uint32 spell_id) const
         {
-            SpellChainMap::const_iterator itr = mSpellChains.find(spell_id);
-            if (itr == mSpellChains.end())
-                return nullptr;
-
-            return &itr->second;
+            return mSpellChainTable.Find(spell_id);
         }
 
         uint32 GetFirstSpellInChain(uint32 spell_id) const
@@ -3097,17 +3098,17 @@ class SpellMgr
             if (spellId1 == spellId2)
                 return false;
 
-            SpellChainMap::const_iterator itr = mSpellChains.find(spellId1);
+            SpellChainNode const* node = GetSpellChainNode(spellId1);
 
             uint32 rank2 = GetSpellRank(spellId2);
 
             // not ordered correctly by rank value
-            if (itr == mSpellChains.end() || !rank2 || itr->second.rank <= rank2)
+            if (!node || !rank2 || node->rank <= rank2)
                 return false;
 
             // check present in same rank chain
-            for (; itr != mSpellChains.end(); itr = mSpellChains.find(itr->second.prev))
-                if (itr->second.prev == spellId2)
+            for (; node; node = GetSpellChainNode(node->prev))
+                if (node->prev == spellId2)
                     return true;
 
             return false;
@@ -3317,6 +3318,7 @@ class SpellMgr
         void CheckUsedSpells(char const* table) const;
 
         // Loading data at server startup
+        void LoadSpellHotEntries();
         void LoadSpellChains();
         void LoadSpellLearnSkills();
         void LoadSpellLearnSpells();
@@ -3343,7 +3345,14 @@ class SpellMgr
         SpellTargetPositionMap mSpellTargetPositions;
         SpellElixirMap     mSpellElixirs;
         SpellThreatMap     mSpellThreatMap;
+        // flat copies of the maps above for the per cast lookups, compiled when their loading is done
+        FlatIdMap<SpellChainNode>   mSpellChainTable;
+        FlatIdMap<uint8>            mSpellElixirTable;
+        FlatIdMap<SpellThreatEntry> mSpellThreatTable;
+        FlatIdMap<float>            mSpellProcItemEnchantTable;
+        FlatIdMap<SpellHotEntry>    mSpellHotEntries;
         SpellProcEventMap  mSpellProcEventMap;
+        uint32             m_spellProcEventGeneration;
         SpellProcItemEnchantMap mSpellProcItemEnchantMap;
         SkillLineAbilityMap mSkillLineAbilityMapBySpellId;
         SkillLineAbilityMap mSkillLineAbilityMapBySkillId;
@@ -0,0 +1,123 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Spells/SpellProcIndex.h"
+#include "Spells/SpellAuras.h"
+#include "Spells/SpellMgr.h"
+
+#include <algorithm>
+
+// these trigger in SpellMgr::IsSpellProcEventCanTriggeredBy before the school of the event is looked at
+static const uint32 PROC_FLAGS_IGNORING_SCHOOL = PROC_FLAG_HEARTBEAT | PROC_FLAG_KILL | PROC_FLAG_ON_TRAP_ACTIVATION | PROC_FLAG_DEATH;
+
+SpellProcIndex::SpellProcIndex() : m_sequence(0), m_generation(sSpellMgr.GetSpellProcEventGeneration())
+{
+}
+
+uint32 SpellProcIndex::GetEventProcFlags(SpellEntry const* spellProto, SpellProcEventEntry const* spellProcEvent)
+{
+    if (spellProcEvent && spellProcEvent->procFlags)
+        return spellProcEvent->procFlags;
+    return spellProto->procFlags;
+}
+
+void SpellProcIndex::Add(SpellAuraHolder* holder)
+{
+    SpellEntry const* spellProto = holder->GetSpellProto();
+    SpellProcEventEntry const* spellProcEvent = sSpellMgr.GetSpellProcEvent(spellProto->Id);
+    uint32 procFlags = GetEventProcFlags(spellProto, spellProcEvent);
+    if (!procFlags)
+        return;
+
+    Entry entry;
+    // same spell id holders stay in application order, like in the multimap
+    entry.order = (uint64(holder->GetId()) << 32) | m_sequence++;
+    entry.holder = holder;
+    entry.procFlags = procFlags;
+    entry.schoolMask = spellProcEvent && !(procFlags & PROC_FLAGS_IGNORING_SCHOOL) ? spellProcEvent->schoolMask : 0;
+
+    m_entries.insert(std::upper_bound(m_entries.begin(), m_entries.end(), entry), entry);
+    for (uint32 bit = 0; bit < MAX_PROC_FLAG_BITS; ++bit)
+    {
+        if (!(procFlags & (1 << bit)))
+            continue;
+
+        std::vector<Entry>& bucket = m_buckets[bit];
+        bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), entry), entry);
+    }
+}
+
+void SpellProcIndex::Remove(SpellAuraHolder* holder)
+{
+    auto itr = std::find_if(m_entries.begin(), m_entries.end(), [holder](Entry const& entry) { return entry.holder == holder; });
+    if (itr == m_entries.end())
+        return;
+
+    Entry entry = *itr;
+    m_entries.erase(itr);
+    for (uint32 bit = 0; bit < MAX_PROC_FLAG_BITS; ++bit)
+    {
+        if (!(entry.procFlags & (1 << bit)))
+            continue;
+
+        std::vector<Entry>& bucket = m_buckets[bit];
+        auto bucketItr = std::lower_bound(bucket.begin(), bucket.end(), entry);
+        if (bucketItr != bucket.end() && bucketItr->holder == holder)
+            bucket.erase(bucketItr);
+    }
+}
+
+void SpellProcIndex::Clear()
+{
+    m_entries.clear();
+    for (auto& bucket : m_buckets)
+        bucket.clear();
+    m_sequence = 0;
+    m_generation = sSpellMgr.GetSpellProcEventGeneration();
+}
+
+bool SpellProcIndex::IsCurrent() const
+{
+    return m_generation == sSpellMgr.GetSpellProcEventGeneration();
+}
+
+void SpellProcIndex::Collect(uint32 procFlags, uint32 schoolMask, std::vector<SpellAuraHolder*>& candidates) const
+{
+    candidates.clear();
+    procFlags &= (1 << MAX_PROC_FLAG_BITS) - 1;
+    if (!procFlags || m_entries.empty())
+        return;
+
+    // single flag events walk just the holders of their bucket
+    if (!(procFlags & (procFlags - 1)))
+    {
+        uint32 bit = 0;
+        while (!(procFlags & (1 << bit)))
+            ++bit;
+
+        for (Entry const& entry : m_buckets[bit])
+            if (!entry.schoolMask || (entry.schoolMask & schoolMask))
+                candidates.push_back(entry.holder);
+        return;
+    }
+
+    // several buckets would need merging and deduplication, all entries are already in order
+    for (Entry const& entry : m_entries)
+        if ((entry.procFlags & procFlags) && (!entry.schoolMask || (entry.schoolMask & schoolMask)))
+            candidates.push_back(entry.holder);
+}
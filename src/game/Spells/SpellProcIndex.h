@@ -0,0 +1,80 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SPELLPROCINDEX_H
+#define MANGOS_SPELLPROCINDEX_H
+
+#include "Common.h"
+
+#include <vector>
+
+class SpellAuraHolder;
+struct SpellEntry;
+struct SpellProcEventEntry;
+
+#define MAX_PROC_FLAG_BITS 25                               // PROC_FLAG_HEARTBEAT up to PROC_FLAG_DEATH
+
+/**
+ * Aura holders of one unit that can proc at all, bucketed by the proc flag bits they trigger on.
+ *
+ * Unit::ProcDamageAndSpellFor asks for the holders matching the proc flags and school of an event
+ * instead of walking every holder and looking up its spell_proc_event data. Only the tests that
+ * IsTriggeredAtSpellProcEvent would fail on anyway are done here, everything else is still checked per holder.
+ * Candidates come out in the order of Unit::m_spellAuraHolders (spell id, then order of application)
+ * so proc order does not change.
+ *
+ * Holder proc flags come from SpellMgr, the index of a unit is built again on its next use after
+ * spell_proc_event got reloaded.
+ */
+class SpellProcIndex
+{
+    public:
+        SpellProcIndex();
+
+        void Add(SpellAuraHolder* holder);
+        void Remove(SpellAuraHolder* holder);
+        void Clear();
+
+        // holders that may trigger on an event with procFlags and schoolMask, SpellAuraHolderMap ordered
+        void Collect(uint32 procFlags, uint32 schoolMask, std::vector<SpellAuraHolder*>& candidates) const;
+
+        bool IsCurrent() const;
+        bool IsEmpty() const { return m_entries.empty(); }
+        uint32 GetSize() const { return uint32(m_entries.size()); }
+
+        // flags an aura of spellProto triggers on, 0 if it never procs
+        static uint32 GetEventProcFlags(SpellEntry const* spellProto, SpellProcEventEntry const* spellProcEvent);
+
+    private:
+        struct Entry
+        {
+            uint64 order;                                   // spell id << 32 | application sequence
+            SpellAuraHolder* holder;
+            uint32 procFlags;
+            uint32 schoolMask;                              // 0 when any school can trigger
+
+            bool operator<(Entry const& other) const { return order < other.order; }
+        };
+
+        std::vector<Entry> m_entries;                       // all indexed holders, by order
+        std::vector<Entry> m_buckets[MAX_PROC_FLAG_BITS];   // holders triggering on the bit, by order
+        uint32 m_sequence;
+        uint32 m_generation;                                // SpellMgr proc event generation the index was built with
+};
+
+#endif
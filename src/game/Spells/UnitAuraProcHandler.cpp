@@ -532,16 +532,40 @@ ProcExecutionData::ProcExecutionData(ProcSystemArguments& data, bool isVictim) :
     }
 }
 
+SpellProcIndex const& Unit::GetProcIndex()
+{
+    // spell_proc_event was reloaded, flags of applied auras may have changed
+    if (!m_procIndex.IsCurrent())
+    {
+        m_procIndex.Clear();
+        for (auto& itr : m_spellAuraHolders)
+            m_procIndex.Add(itr.second);
+    }
+
+    return m_procIndex;
+}
+
 void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
 {
     ProcExecutionData execData(argData, isVictim);
 
+    // only holders whose proc flags and school can match this event
+    // the buffer of the map thread is borrowed, a proc event raised while it is out starts with an empty one
+    static thread_local std::vector<SpellAuraHolder*> candidatesBuffer;
+    std::vector<SpellAuraHolder*> candidates;
+    candidates.swap(candidatesBuffer);
+    GetProcIndex().Collect(execData.procFlags, execData.spellInfo ? execData.spellInfo->SchoolMask : uint32(SPELL_SCHOOL_MASK_NORMAL), candidates);
+    if (candidates.empty())
+    {
+        candidatesBuffer.swap(candidates);
+        return;
+    }
+
     ProcTriggeredList procTriggered;
     std::vector<SpellAuraHolder*> holdersForDeletion;
     // Fill procTriggered list
-    for (SpellAuraHolderMap::const_iterator itr = GetSpellAuraHolderMap().begin(); itr != GetSpellAuraHolderMap().end(); ++itr)
+    for (SpellAuraHolder* holder : candidates)
     {
-        SpellAuraHolder* holder = itr->second;
         // skip deleted auras (possible at recursive triggered call
         if (holder->GetState() != SPELLAURAHOLDER_STATE_READY || holder->IsDeleted())
             continue;
@@ -564,9 +588,12 @@ void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
         if (result != SpellProcEventTriggerCheck::SPELL_PROC_TRIGGER_OK)
             continue;
 
-        procTriggered.push_back(ProcTriggeredData(spellProcEvent, itr->second));
+        procTriggered.push_back(ProcTriggeredData(spellProcEvent, holder));
     }
 
+    candidates.clear();
+    candidatesBuffer.swap(candidates);
+
     for (SpellAuraHolder* holder : holdersForDeletion)
         if (holder->DropAuraCharge())
             RemoveSpellAuraHolder(holder);
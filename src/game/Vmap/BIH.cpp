@@ -275,11 +275,13 @@ bool BIH::readFromFile(FILE* rf)
     check += fread(&hi, sizeof(float), 3, rf);
     bounds = AABox(lo, hi);
     check += fread(&treeSize, sizeof(uint32), 1, rf);
-    tree.resize(treeSize);
-    check += fread(&tree[0], sizeof(uint32), treeSize, rf);
+    std::vector<uint32> treeData(treeSize);
+    check += fread(treeData.data(), sizeof(uint32), treeSize, rf);
+    tree.assign(std::move(treeData));
     check += fread(&count, sizeof(uint32), 1, rf);
-    objects.resize(count); // = new uint32[nObjects];
-    check += fread(&objects[0], sizeof(uint32), count, rf);
+    std::vector<uint32> objectData(count); // = new uint32[nObjects];
+    check += fread(objectData.data(), sizeof(uint32), count, rf);
+    objects.assign(std::move(objectData));
     return check == (3 + 3 + 2 + treeSize + count);
 }
 
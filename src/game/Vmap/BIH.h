@@ -24,9 +24,11 @@
 #include <G3D/AABox.h>
 
 #include <Platform/Define.h>
+#include "BlobArray.h"
 
 #include <vector>
 #include <algorithm>
+#include <limits>
 
 #define MAX_STACK_SIZE 64
 
@@ -73,11 +75,11 @@ class BIH
     private:
         void init_empty()
         {
-            tree.clear();
             objects.clear();
             // create space for the first node
-            tree.push_back(static_cast<uint32>(3 << 30)); // dummy leaf
-            tree.insert(tree.end(), 2, 0);
+            std::vector<uint32> emptyTree(3, 0);
+            emptyTree[0] = static_cast<uint32>(3 << 30); // dummy leaf
+            tree.assign(std::move(emptyTree));
         }
 
     public:
@@ -108,16 +110,34 @@ class BIH
             if (printStats)
                 stats.printStats();
 
-            objects.resize(dat.numPrims);
-            for (uint32 i = 0; i < dat.numPrims; ++i)
-                objects[i] = dat.indices[i];
+            objects.assign(std::vector<uint32>(dat.indices, dat.indices + dat.numPrims));
             // nObjects = dat.numPrims;
-            tree = tempTree;
+            tree.assign(std::move(tempTree));
             delete[] dat.primBound;
             delete[] dat.indices;
         }
         size_t primCount() const { return objects.size(); }
 
+        /**
+        Recomputes clip planes and bounds bottom-up for primitives that moved, without changing the tree topology.
+        primitives are pointers, nullptr for removed ones; objects can not be added this way.
+        Returns the expected number of node visits and primitive tests of a random ray relative to the
+        root bounds (surface area heuristic), to judge whether a rebuild would pay off.
+        */
+        template< class BoundsFunc, class PrimArray >
+        float refit(const PrimArray& primitives, BoundsFunc& getBounds)
+        {
+            AABound box = { Vector3(G3D::inf(), G3D::inf(), G3D::inf()), Vector3(-G3D::inf(), -G3D::inf(), -G3D::inf()) };
+            float cost = 0.f;
+            refitNode(0, primitives, getBounds, box, cost);
+            if (box.lo.x > box.hi.x)
+                return 0.f;
+
+            bounds = AABox(box.lo, box.hi);
+            float rootArea = boundArea(box);
+            return rootArea > 0.f ? cost / rootArea : cost;
+        }
+
         template<typename RayCallback>
         void intersectRay(const Ray& r, RayCallback& intersectCallback, float& maxDist, bool stopAtFirst = false, bool ignoreM2Model = false) const
         {
@@ -342,9 +362,21 @@ class BIH
         bool writeToFile(FILE* wf) const;
         bool readFromFile(FILE* rf);
 
+        // raw data for the model blob format (see WorldModel::writeBlobFile)
+        const AABox& getBounds() const { return bounds; }
+        const VMAP::BlobArray<uint32>& getNodes() const { return tree; }
+        const VMAP::BlobArray<uint32>& getObjects() const { return objects; }
+        // use tree data in place, it has to stay valid as long as this BIH
+        void setBlobData(const AABox& treeBounds, uint32 const* nodes, uint32 nodeCount, uint32 const* objectIndices, uint32 objectCount)
+        {
+            bounds = treeBounds;
+            tree.setView(nodes, nodeCount);
+            objects.setView(objectIndices, objectCount);
+        }
+
     protected:
-        std::vector<uint32> tree;
-        std::vector<uint32> objects;
+        VMAP::BlobArray<uint32> tree;
+        VMAP::BlobArray<uint32> objects;
         AABox bounds;
 
         struct buildData
@@ -400,6 +432,68 @@ class BIH
         }
 
         void subdivide(int left, int right, std::vector<uint32>& tempTree, buildData& dat, AABound& gridBox, AABound& nodeBox, int nodeIndex, int depth, BuildStats& stats);
+
+        static float boundArea(const AABound& box)
+        {
+            if (box.lo.x > box.hi.x)
+                return 0.f;
+            Vector3 d = box.hi - box.lo;
+            return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+        }
+
+        // box must come in empty, comes back as the bounds of all remaining primitives below node
+        template< class BoundsFunc, class PrimArray >
+        void refitNode(uint32 node, const PrimArray& primitives, BoundsFunc& getBounds, AABound& box, float& cost)
+        {
+            uint32 tn = tree[node];
+            uint32 axis = (tn & (3 << 30)) >> 30;
+            const bool BVH2 = (tn & (1 << 29)) != 0;
+            uint32 offset = tn & ~(7 << 29);
+            if (!BVH2 && axis == 3)
+            {
+                // leaf
+                uint32 count = 0;
+                for (uint32 i = offset; i < offset + tree[node + 1]; ++i)
+                {
+                    if (!primitives[objects[i]])
+                        continue;
+                    AABox primBound;
+                    getBounds(primitives[objects[i]], primBound);
+                    box.lo = box.lo.min(primBound.low());
+                    box.hi = box.hi.max(primBound.high());
+                    ++count;
+                }
+                cost += boundArea(box) * count;
+                return;
+            }
+
+            // an emptied child keeps its node but gets a clip plane no ray or point can pass
+            // (-)inf marks children that were never allocated by the build
+            if (BVH2)
+            {
+                refitNode(offset, primitives, getBounds, box, cost);
+                bool empty = box.lo.x > box.hi.x;
+                tree[node + 1] = floatToRawIntBits(empty ? std::numeric_limits<float>::max() : box.lo[axis]);
+                tree[node + 2] = floatToRawIntBits(empty ? -std::numeric_limits<float>::max() : box.hi[axis]);
+            }
+            else
+            {
+                AABound right = box;
+                if (intBitsToFloat(tree[node + 1]) != -G3D::inf())
+                {
+                    refitNode(offset, primitives, getBounds, box, cost);
+                    tree[node + 1] = floatToRawIntBits(box.lo.x > box.hi.x ? -std::numeric_limits<float>::max() : box.hi[axis]);
+                }
+                if (intBitsToFloat(tree[node + 2]) != G3D::inf())
+                {
+                    refitNode(offset + 3, primitives, getBounds, right, cost);
+                    tree[node + 2] = floatToRawIntBits(right.lo.x > right.hi.x ? std::numeric_limits<float>::max() : right.lo[axis]);
+                }
+                box.lo = box.lo.min(right.lo);
+                box.hi = box.hi.max(right.hi);
+            }
+            cost += boundArea(box);
+        }
 };
 
 #endif // _BIH_H
@@ -18,11 +18,39 @@
 
 #pragma once
 
-#include <G3D/Table.h>
-#include <G3D/Array.h>
-#include <G3D/Set.h>
+#include <G3D/BoundsTrait.h>
 #include "BIH.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+// counters of all BIHWrap instances, exported through metrics
+struct BIHWrapStats
+{
+    std::atomic<uint64> refits{0};
+    std::atomic<uint64> refitTime{0};           // microseconds
+    std::atomic<uint64> rebuilds{0};
+    std::atomic<uint64> rebuildTime{0};         // microseconds
+};
+
+inline BIHWrapStats& GetBIHWrapStats()
+{
+    static BIHWrapStats stats;
+    return stats;
+}
+
+/**
+BIH over a changing set of objects.
+
+Without incremental refit every change rebuilds the whole tree on the next balance or query.
+With it, removed objects only leave an empty slot, objects inserted again into their old slot
+(moves) get the tree refitted around their new bounds, and new objects are tested linearly
+until the next rebuild. A rebuild happens only once the estimated query cost has grown too much
+compared to the freshly built tree.
+*/
 template<class T, class BoundsFunc = BoundsTrait<T> >
 class BIHWrap
 {
@@ -32,8 +60,9 @@ class BIHWrap
             const T* const* objects;
             RayCallback& cb;
             uint32 objectsSize;
+            bool hit;
 
-            MDLCallback(RayCallback& callback, const T* const* objects_array, uint32 objSize) : objects(objects_array), cb(callback), objectsSize(objSize) {}
+            MDLCallback(RayCallback& callback, const T* const* objects_array, uint32 objSize) : objects(objects_array), cb(callback), objectsSize(objSize), hit(false) {}
 
             bool operator()(const Ray& r, uint32 Idx, float& MaxDist, bool stopAtFirst, bool ignoreM2Model)
             {
@@ -41,8 +70,9 @@ class BIHWrap
                     return false;
 
                 if (const T* obj = objects[Idx])
-                    return cb(r, *obj, MaxDist, ignoreM2Model);
-                return false;
+                    if (cb(r, *obj, MaxDist, ignoreM2Model))
+                        hit = true;
+                return hit;
             }
 
             void operator()(const Vector3& p, uint32 Idx)
@@ -55,61 +85,148 @@ class BIHWrap
             }
         };
 
-        typedef G3D::Array<const T*> ObjArray;
+        // rebuild once refitting and linear tests made queries this much more expensive than after the last build
+        static constexpr float REBUILD_COST_FACTOR = 1.2f;
+        // absolute slack so small trees do not rebuild on every insert
+        static constexpr float REBUILD_COST_SLACK = 4.0f;
 
         BIH m_tree;
-        ObjArray m_objects;
-        G3D::Table<const T*, uint32> m_obj2Idx;
-        G3D::Set<const T*> m_objects_to_push;
-        int unbalanced_times;
+        std::vector<const T*> m_objects;                // tree primitives, nullptr for removed ones
+        std::unordered_map<const T*, uint32> m_obj2Idx; // slot in m_objects of every object the tree was built with
+        std::vector<const T*> m_pending;                // inserted since the last build, not in the tree
+        uint32 m_freeSlots;
+
+        bool m_incrementalRefit;
+        bool m_needsRebuild;
+        bool m_needsRefit;
+        float m_buildCost;                              // tree cost right after the last build
+        float m_treeCost;                               // tree cost after the last refit
 
     public:
 
-        BIHWrap() : unbalanced_times(0) {}
+        explicit BIHWrap(bool incrementalRefit = false) : m_freeSlots(0), m_incrementalRefit(incrementalRefit),
+            m_needsRebuild(false), m_needsRefit(false), m_buildCost(0.f), m_treeCost(0.f) {}
 
         void insert(const T& obj)
         {
-            ++unbalanced_times;
-            m_objects_to_push.insert(&obj);
+            if (!m_incrementalRefit)
+                m_needsRebuild = true;
+
+            auto itr = m_obj2Idx.find(&obj);
+            if (itr != m_obj2Idx.end() && !m_objects[itr->second])
+            {
+                // moved - reuse the slot, the tree only needs new clip planes
+                m_objects[itr->second] = &obj;
+                --m_freeSlots;
+                m_needsRefit = true;
+                return;
+            }
+
+            m_pending.push_back(&obj);
         }
 
         void remove(const T& obj)
         {
-            ++unbalanced_times;
-            uint32 Idx = 0;
-            const T* temp;
-            if (m_obj2Idx.getRemove(&obj, temp, Idx))
-                m_objects[Idx] = nullptr;
-            else
-                m_objects_to_push.remove(&obj);
+            if (!m_incrementalRefit)
+                m_needsRebuild = true;
+
+            auto itr = m_obj2Idx.find(&obj);
+            if (itr != m_obj2Idx.end() && m_objects[itr->second])
+            {
+                m_objects[itr->second] = nullptr;
+                ++m_freeSlots;
+                m_needsRefit = true;
+                return;
+            }
+
+            auto pendingItr = std::find(m_pending.begin(), m_pending.end(), &obj);
+            if (pendingItr != m_pending.end())
+            {
+                *pendingItr = m_pending.back();
+                m_pending.pop_back();
+            }
         }
 
         void balance()
         {
-            if (unbalanced_times == 0)
+            if (m_needsRebuild)
+            {
+                rebuild();
                 return;
+            }
 
-            unbalanced_times = 0;
-            m_objects.fastClear();
-            m_obj2Idx.getKeys(m_objects);
-            m_objects_to_push.getMembers(m_objects);
+            if (m_needsRefit)
+                refit();
 
-            m_tree.build(m_objects, BoundsFunc::getBounds2);
+            // linear tests of pending objects count fully, slots of removed objects are compacted once they dominate
+            float cost = m_treeCost + m_pending.size();
+            if (cost > m_buildCost * REBUILD_COST_FACTOR + REBUILD_COST_SLACK || m_freeSlots > m_objects.size() / 2 + REBUILD_COST_SLACK)
+                rebuild();
         }
 
         template<typename RayCallback>
         void intersectRay(const Ray& r, RayCallback& intersectCallback, float& maxDist, bool ignoreM2Model)
         {
             balance();
-            MDLCallback<RayCallback> temp_cb(intersectCallback, m_objects.getCArray(), m_objects.size());
+            MDLCallback<RayCallback> temp_cb(intersectCallback, m_objects.data(), m_objects.size());
             m_tree.intersectRay(r, temp_cb, maxDist, true, ignoreM2Model);
+            if (temp_cb.hit)
+                return;
+
+            for (const T* obj : m_pending)
+                if (intersectCallback(r, *obj, maxDist, ignoreM2Model))
+                    return;
         }
 
         template<typename IsectCallback>
         void intersectPoint(const Vector3& p, IsectCallback& intersectCallback)
         {
             balance();
-            MDLCallback<IsectCallback> temp_cb(intersectCallback, m_objects.getCArray(), m_objects.size());
+            MDLCallback<IsectCallback> temp_cb(intersectCallback, m_objects.data(), m_objects.size());
             m_tree.intersectPoint(p, temp_cb);
+
+            for (const T* obj : m_pending)
+                intersectCallback(p, *obj);
+        }
+
+    private:
+        void rebuild()
+        {
+            auto start = std::chrono::steady_clock::now();
+
+            std::vector<const T*> objects;
+            objects.reserve(m_objects.size() - m_freeSlots + m_pending.size());
+            for (const T* obj : m_objects)
+                if (obj)
+                    objects.push_back(obj);
+            objects.insert(objects.end(), m_pending.begin(), m_pending.end());
+
+            m_objects.swap(objects);
+            m_pending.clear();
+            m_obj2Idx.clear();
+            for (uint32 i = 0; i < m_objects.size(); ++i)
+                m_obj2Idx.emplace(m_objects[i], i);
+            m_freeSlots = 0;
+
+            m_tree.build(m_objects, BoundsFunc::getBounds2);
+            m_buildCost = m_treeCost = m_incrementalRefit ? m_tree.refit(m_objects, BoundsFunc::getBounds2) : 0.f;
+            m_needsRebuild = false;
+            m_needsRefit = false;
+
+            BIHWrapStats& stats = GetBIHWrapStats();
+            ++stats.rebuilds;
+            stats.rebuildTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        void refit()
+        {
+            auto start = std::chrono::steady_clock::now();
+
+            m_treeCost = m_tree.refit(m_objects, BoundsFunc::getBounds2);
+            m_needsRefit = false;
+
+            BIHWrapStats& stats = GetBIHWrapStats();
+            ++stats.refits;
+            stats.refitTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
         }
 };
@@ -0,0 +1,91 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _BLOBARRAY_H
+#define _BLOBARRAY_H
+
+#include "Platform/Define.h"
+
+#include <vector>
+
+namespace VMAP
+{
+    /**
+    Contiguous array of model data. Either owns its elements (built or read from the old chunked
+    format) or points into a model blob loaded by WorldModel::readFile, which must outlive it.
+    Copies of owned arrays are deep, copies of blob views point to the same blob.
+    */
+    template<class T>
+    class BlobArray
+    {
+        public:
+            BlobArray() : m_data(nullptr), m_size(0), m_isView(false) {}
+            BlobArray(BlobArray const& other) : m_data(nullptr), m_size(0), m_isView(false) { *this = other; }
+
+            BlobArray& operator=(BlobArray const& other)
+            {
+                if (this == &other)
+                    return *this;
+
+                if (other.m_isView)
+                    setView(other.m_data, other.m_size);
+                else
+                    assign(std::vector<T>(other.m_owned));
+                return *this;
+            }
+
+            void assign(std::vector<T>&& data)
+            {
+                m_owned = std::move(data);
+                m_data = m_owned.data();
+                m_size = m_owned.size();
+                m_isView = false;
+            }
+
+            // blob data is mapped read only, views must never be written to
+            void setView(T const* data, uint32 size)
+            {
+                std::vector<T>().swap(m_owned);
+                m_data = const_cast<T*>(data);
+                m_size = size;
+                m_isView = true;
+            }
+
+            void clear() { assign(std::vector<T>()); }
+
+            T* data() { return m_data; }
+            T const* data() const { return m_data; }
+            uint32 size() const { return m_size; }
+            bool empty() const { return m_size == 0; }
+            bool isView() const { return m_isView; }
+
+            T& operator[](uint32 i) { return m_data[i]; }
+            T const& operator[](uint32 i) const { return m_data[i]; }
+
+            T const* begin() const { return m_data; }
+            T const* end() const { return m_data + m_size; }
+
+        private:
+            std::vector<T> m_owned;
+            T* m_data;
+            uint32 m_size;
+            bool m_isView;
+    };
+}
+
+#endif // _BLOBARRAY_H
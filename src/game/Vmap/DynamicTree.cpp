@@ -50,7 +50,16 @@ static bool operator == (const GameObjectModel& mdl, const GameObjectModel& mdl2
 //int UNBALANCED_TIMES_LIMIT = 5;
 int CHECK_TREE_PERIOD = 200;
 
-typedef RegularGrid2D<GameObjectModel, BIHWrap<GameObjectModel> > ParentTree;
+static bool s_incrementalRefit = false;
+
+typedef BIHWrap<GameObjectModel> DynTreeNode;
+
+struct DynTreeNodeCreator
+{
+    static DynTreeNode* makeNode(int /*x*/, int /*y*/) { return new DynTreeNode(s_incrementalRefit); }
+};
+
+typedef RegularGrid2D<GameObjectModel, DynTreeNode, DynTreeNodeCreator> ParentTree;
 
 struct DynTreeImpl : public ParentTree/*, public Intersectable*/
 {
@@ -138,6 +147,11 @@ void DynamicMapTree::update(uint32 t_diff)
     impl.update(t_diff);
 }
 
+void DynamicMapTree::SetIncrementalRefit(bool enable)
+{
+    s_incrementalRefit = enable;
+}
+
 struct DynamicTreeIntersectionCallback
 {
     bool did_hit;
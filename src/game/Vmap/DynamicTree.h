@@ -47,6 +47,9 @@ class DynamicMapTree
 
         void balance();
         void update(uint32 t_diff);
+
+        // refit cells on moves and rebuild only when query cost degrades, applies to cells created afterwards
+        static void SetIncrementalRefit(bool enable);
     private:
         struct DynTreeImpl& impl;
 };
@@ -52,7 +52,7 @@ namespace VMAP
 
     //=================================================================
 
-    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
+    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName) : iBlobModels(false)
     {
         iSrcDir = pSrcDirName;
         iDestDir = pDestDirName;
@@ -326,6 +326,8 @@ namespace VMAP
         }
 
         //std::cout << "readRawFile2: '" << pModelFilename << "' tris: " << nElements << " nodes: " << nNodes << std::endl;
+        if (iBlobModels)
+            return model.writeBlobFile(iDestDir + "/" + pModelFilename + ".vmo");
         return model.writeFile(iDestDir + "/" + pModelFilename + ".vmo");
     }
 
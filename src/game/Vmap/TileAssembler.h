@@ -95,6 +95,7 @@ namespace VMAP
             std::string iSrcDir;
             MapData mapData;
             std::set<std::string> spawnedModelFiles;
+            bool iBlobModels;
 
         public:
             TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
@@ -106,6 +107,8 @@ namespace VMAP
 
             void exportGameobjectModels();
             bool convertRawFile(const std::string& pModelFilename);
+            //! write models in the single blob format (see WorldModel::writeBlobFile)
+            void setBlobModels(bool blobModels) { iBlobModels = blobModels; }
     };
 }                                                           // VMAP
 
@@ -24,6 +24,7 @@
 namespace VMAP
 {
     const char VMAP_MAGIC[] = "VMAP_7.0";                   // used in final vmap files
+    const char VMAP_BLOB_MAGIC[] = "VMAPB001";              // used in single blob model files (see WorldModel::writeBlobFile)
     const char RAW_VMAP_MAGIC[] = "VMAPs05";                // used in extracted vmap files with raw data
     const char GAMEOBJECT_MODELS[] = "temp_gameobject_models";
 
@@ -287,6 +287,7 @@ namespace VMAP
 
     void VMapManager2::releaseModelInstance(const std::string& filename)
     {
+        std::lock_guard<std::mutex> lock(m_vmModelMutex);
         ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
         if (model == iLoadedModelFiles.end())
         {
@@ -302,6 +303,45 @@ namespace VMAP
     }
     //=========================================================
 
+    void VMapManager2::prefetchTileModels(const char* pBasePath, uint32 pMapId, uint32 tileX, uint32 tileY, std::vector<std::string>& acquiredModels)
+    {
+        // same base path normalization as StaticMapTree, models are keyed by file name only
+        std::string basePath = pBasePath;
+        if (basePath.length() > 0 && (basePath[basePath.length() - 1] != '/' && basePath[basePath.length() - 1] != '\\'))
+            basePath.append("/");
+
+        std::string tilefile = basePath + StaticMapTree::getTileFileName(pMapId, tileX, tileY);
+        FILE* tf = fopen(tilefile.c_str(), "rb");
+        if (!tf)
+            return;                                         // not tiled or empty tile
+
+        char chunk[8];
+        uint32 numSpawns = 0;
+        if (!readChunk(tf, chunk, VMAP_MAGIC, 8) || fread(&numSpawns, sizeof(uint32), 1, tf) != 1)
+        {
+            fclose(tf);
+            return;
+        }
+
+        for (uint32 i = 0; i < numSpawns; ++i)
+        {
+            ModelSpawn spawn;
+            uint32 referencedVal;
+            if (!ModelSpawn::readFromFile(tf, spawn) || fread(&referencedVal, sizeof(uint32), 1, tf) != 1)
+                break;
+
+            if (WorldModel* model = acquireModelInstance(basePath, spawn.name))
+            {
+                model->setModelFlags(spawn.flags);
+                acquiredModels.push_back(spawn.name);
+            }
+        }
+
+        fclose(tf);
+    }
+
+    //=========================================================
+
     bool VMapManager2::existsMap(const char* pBasePath, unsigned int pMapId, int x, int y)
     {
         return StaticMapTree::CanLoadMap(std::string(pBasePath), pMapId, x, y);
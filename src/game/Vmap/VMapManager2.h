@@ -106,6 +106,10 @@ namespace VMAP
             WorldModel* acquireModelInstance(const std::string& basepath, const std::string& filename);
             void releaseModelInstance(const std::string& filename);
 
+            // loads the models used by a map tile without touching the map tree, so a later loadMap() finds them in memory
+            // thread safe - acquired model names are returned and must be released by the caller
+            void prefetchTileModels(const char* pBasePath, uint32 pMapId, uint32 tileX, uint32 tileY, std::vector<std::string>& acquiredModels);
+
             // what's the use of this? o.O
             std::string getDirFileName(unsigned int pMapId, int /*x*/, int /*y*/) const override
             {
@@ -22,6 +22,13 @@
 #include "ModelInstance.h"
 #include <string.h>
 
+#if PLATFORM != PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using G3D::Vector3;
 using G3D::Ray;
 
@@ -32,7 +39,7 @@ template<> struct BoundsTrait<VMAP::GroupModel>
 
 namespace VMAP
 {
-    bool IntersectTriangle(MeshTriangle const& tri, std::vector<Vector3>::const_iterator points, G3D::Ray const& ray, float& distance)
+    bool IntersectTriangle(MeshTriangle const& tri, Vector3 const* points, G3D::Ray const& ray, float& distance)
     {
 #define EPS 1e-5f
 
@@ -89,7 +96,7 @@ namespace VMAP
     class TriBoundFunc
     {
         public:
-            TriBoundFunc(std::vector<Vector3>& vert): vertices(vert.begin()) {}
+            TriBoundFunc(BlobArray<Vector3> const& vert): vertices(vert.data()) {}
             void operator()(MeshTriangle const& tri, G3D::AABox& out) const
             {
                 G3D::Vector3 lo = vertices[tri.idx0];
@@ -101,25 +108,182 @@ namespace VMAP
                 out = G3D::AABox(lo, hi);
             }
         protected:
-            std::vector<Vector3>::const_iterator const vertices;
+            Vector3 const* const vertices;
+    };
+
+    // ===================== model blob format ==================================
+    // A file header, the group headers and then all arrays in sections aligned to BLOB_SECTION_ALIGNMENT,
+    // so a mapped file can be used in place. Offsets are in bytes from the start of the file.
+
+    static const uint32 BLOB_SECTION_ALIGNMENT = 16;
+
+    struct ModelBlobHeader
+    {
+        char magic[8];
+        uint32 rootWMOID;
+        uint32 groupCount;
+        uint32 groupsOffset;                    // GroupBlobHeader[groupCount]
+        uint32 treeNodesOffset;
+        uint32 treeNodeCount;
+        uint32 treeObjectsOffset;
+        uint32 treeObjectCount;
+        float treeBounds[6];
+    };
+
+    struct GroupBlobHeader
+    {
+        float bounds[6];
+        uint32 mogpFlags;
+        uint32 groupWMOID;
+        uint32 verticesOffset;
+        uint32 vertexCount;
+        uint32 trianglesOffset;
+        uint32 triangleCount;
+        uint32 treeNodesOffset;
+        uint32 treeNodeCount;
+        uint32 treeObjectsOffset;
+        uint32 treeObjectCount;
+        float treeBounds[6];
+        uint32 liquidType;
+        uint32 liquidTilesX;
+        uint32 liquidTilesY;
+        float liquidCorner[3];
+        uint32 liquidHeightsOffset;             // 0 if the group has no liquid
+        uint32 liquidFlagsOffset;
+    };
+
+    static void writeBounds(G3D::AABox const& box, float* out)
+    {
+        memcpy(out, &box.low(), sizeof(Vector3));
+        memcpy(out + 3, &box.high(), sizeof(Vector3));
+    }
+
+    static G3D::AABox readBounds(float const* in)
+    {
+        return G3D::AABox(Vector3(in[0], in[1], in[2]), Vector3(in[3], in[4], in[5]));
+    }
+
+    class ModelBlobWriter
+    {
+        public:
+            //! reserves size bytes at the next aligned offset and returns that offset
+            uint32 reserve(uint32 size)
+            {
+                uint32 offset = (m_data.size() + BLOB_SECTION_ALIGNMENT - 1) & ~(BLOB_SECTION_ALIGNMENT - 1);
+                m_data.resize(offset + size, 0);
+                return offset;
+            }
+
+            uint32 append(void const* data, uint32 size)
+            {
+                uint32 offset = reserve(size);
+                if (size)
+                    memcpy(&m_data[offset], data, size);
+                return offset;
+            }
+
+            void write(uint32 offset, void const* data, uint32 size) { memcpy(&m_data[offset], data, size); }
+
+            bool writeToFile(FILE* wf) const { return fwrite(m_data.data(), 1, m_data.size(), wf) == m_data.size(); }
+
+        private:
+            std::vector<uint8> m_data;
+    };
+
+    class ModelBlob
+    {
+        public:
+            ModelBlob() : m_data(nullptr), m_size(0), m_mapped(false) {}
+            ~ModelBlob()
+            {
+#if PLATFORM != PLATFORM_WINDOWS
+                if (m_mapped)
+                    munmap(const_cast<uint8*>(m_data), m_size);
+#endif
+            }
+
+            bool load(std::string const& filename)
+            {
+#if PLATFORM != PLATFORM_WINDOWS
+                int fd = open(filename.c_str(), O_RDONLY);
+                if (fd < 0)
+                    return false;
+
+                struct stat fileStat;
+                if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+                {
+                    void* mapped = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (mapped != MAP_FAILED)
+                    {
+                        m_data = static_cast<uint8 const*>(mapped);
+                        m_size = fileStat.st_size;
+                        m_mapped = true;
+                    }
+                }
+                close(fd);
+
+                if (m_mapped)
+                    return true;
+#endif
+                // no mapping - still a single read into one allocation
+                FILE* rf = fopen(filename.c_str(), "rb");
+                if (!rf)
+                    return false;
+
+                fseek(rf, 0, SEEK_END);
+                long size = ftell(rf);
+                fseek(rf, 0, SEEK_SET);
+                if (size <= 0)
+                {
+                    fclose(rf);
+                    return false;
+                }
+
+                // uint64 storage keeps the sections aligned
+                m_buffer.reset(new uint64[(size + sizeof(uint64) - 1) / sizeof(uint64)]);
+                bool result = fread(m_buffer.get(), 1, size, rf) == size_t(size);
+                fclose(rf);
+
+                m_data = reinterpret_cast<uint8 const*>(m_buffer.get());
+                m_size = size;
+                return result;
+            }
+
+            //! count elements of T at offset, nullptr if they do not lie within the blob
+            template<class T>
+            T const* get(uint32 offset, uint32 count) const
+            {
+                if (offset % alignof(T) || uint64(offset) + uint64(count) * sizeof(T) > m_size)
+                    return nullptr;
+                return reinterpret_cast<T const*>(m_data + offset);
+            }
+
+        private:
+            uint8 const* m_data;
+            size_t m_size;
+            bool m_mapped;
+            std::unique_ptr<uint64[]> m_buffer;
     };
 
     // ===================== WmoLiquid ==================================
 
     WmoLiquid::WmoLiquid(uint32 width, uint32 height, Vector3 const& corner, uint32 type):
-        iTilesX(width), iTilesY(height), iCorner(corner), iType(type)
+        iTilesX(width), iTilesY(height), iCorner(corner), iType(type), iBlobData(false)
     {
         iHeight = new float[(width + 1) * (height + 1)];
         iFlags = new uint8[width * height];
     }
 
-    WmoLiquid::WmoLiquid(WmoLiquid const& other): iHeight(nullptr), iFlags(nullptr)
+    WmoLiquid::WmoLiquid(WmoLiquid const& other): iHeight(nullptr), iFlags(nullptr), iBlobData(false)
     {
         *this = other;                                      // use assignment operator defined below
     }
 
     WmoLiquid::~WmoLiquid()
     {
+        if (iBlobData)
+            return;
+
         delete[] iFlags;
         delete[] iHeight;
     }
@@ -129,8 +293,12 @@ namespace VMAP
         if (this == &other)
             return *this;
 
-        delete[] iFlags;
-        delete[] iHeight;
+        if (!iBlobData)
+        {
+            delete[] iFlags;
+            delete[] iHeight;
+        }
+        iBlobData = false;
 
         iTilesX = other.iTilesX;
         iTilesY = other.iTilesY;
@@ -261,6 +429,29 @@ namespace VMAP
         return result;
     }
 
+    void WmoLiquid::writeToBlob(ModelBlobWriter& writer, GroupBlobHeader& header) const
+    {
+        header.liquidType = iType;
+        header.liquidTilesX = iTilesX;
+        header.liquidTilesY = iTilesY;
+        memcpy(header.liquidCorner, &iCorner, sizeof(Vector3));
+        header.liquidHeightsOffset = writer.append(iHeight, (iTilesX + 1) * (iTilesY + 1) * sizeof(float));
+        header.liquidFlagsOffset = writer.append(iFlags, iTilesX * iTilesY);
+    }
+
+    WmoLiquid* WmoLiquid::readFromBlob(GroupBlobHeader const& header, uint8 const* blob)
+    {
+        WmoLiquid* liquid = new WmoLiquid();
+        liquid->iTilesX = header.liquidTilesX;
+        liquid->iTilesY = header.liquidTilesY;
+        liquid->iCorner = Vector3(header.liquidCorner[0], header.liquidCorner[1], header.liquidCorner[2]);
+        liquid->iType = header.liquidType;
+        liquid->iHeight = reinterpret_cast<float*>(const_cast<uint8*>(blob + header.liquidHeightsOffset));
+        liquid->iFlags = const_cast<uint8*>(blob + header.liquidFlagsOffset);
+        liquid->iBlobData = true;
+        return liquid;
+    }
+
     // ===================== GroupModel ==================================
 
     GroupModel::GroupModel(GroupModel const& other):
@@ -273,8 +464,8 @@ namespace VMAP
 
     void GroupModel::setMeshData(std::vector<Vector3>& vert, std::vector<MeshTriangle>& tri)
     {
-        vertices.swap(vert);
-        triangles.swap(tri);
+        vertices.assign(std::move(vert));
+        triangles.assign(std::move(tri));
         TriBoundFunc bFunc(vertices);
         meshTree.build(triangles, bFunc);
     }
@@ -345,8 +536,10 @@ namespace VMAP
         if (result && fread(&count, sizeof(uint32), 1, rf) != 1) result = false;
         if (!count) // models without (collision) geometry end here, unsure if they are useful
             return result;
-        if (result) vertices.resize(count);
-        if (result && fread(&vertices[0], sizeof(Vector3), count, rf) != count) result = false;
+        std::vector<Vector3> vertexData;
+        if (result) vertexData.resize(count);
+        if (result && fread(&vertexData[0], sizeof(Vector3), count, rf) != count) result = false;
+        vertices.assign(std::move(vertexData));
 
         // read triangle mesh
         if (result && !readChunk(rf, chunk, "TRIM", 4)) result = false;
@@ -354,8 +547,10 @@ namespace VMAP
         if (result && fread(&count, sizeof(uint32), 1, rf) != 1) result = false;
         if (count)
         {
-            if (result) triangles.resize(count);
-            if (result && fread(&triangles[0], sizeof(MeshTriangle), count, rf) != count) result = false;
+            std::vector<MeshTriangle> triangleData;
+            if (result) triangleData.resize(count);
+            if (result && fread(&triangleData[0], sizeof(MeshTriangle), count, rf) != count) result = false;
+            triangles.assign(std::move(triangleData));
         }
 
         // read mesh BIH
@@ -370,10 +565,63 @@ namespace VMAP
         return result;
     }
 
+    void GroupModel::writeToBlob(ModelBlobWriter& writer, GroupBlobHeader& header) const
+    {
+        memset(&header, 0, sizeof(GroupBlobHeader));
+        writeBounds(iBound, header.bounds);
+        header.mogpFlags = iMogpFlags;
+        header.groupWMOID = iGroupWMOID;
+
+        header.vertexCount = vertices.size();
+        header.verticesOffset = writer.append(vertices.data(), vertices.size() * sizeof(Vector3));
+        header.triangleCount = triangles.size();
+        header.trianglesOffset = writer.append(triangles.data(), triangles.size() * sizeof(MeshTriangle));
+
+        header.treeNodeCount = meshTree.getNodes().size();
+        header.treeNodesOffset = writer.append(meshTree.getNodes().data(), meshTree.getNodes().size() * sizeof(uint32));
+        header.treeObjectCount = meshTree.getObjects().size();
+        header.treeObjectsOffset = writer.append(meshTree.getObjects().data(), meshTree.getObjects().size() * sizeof(uint32));
+        writeBounds(meshTree.getBounds(), header.treeBounds);
+
+        if (iLiquid)
+            iLiquid->writeToBlob(writer, header);
+    }
+
+    bool GroupModel::readFromBlob(GroupBlobHeader const& header, ModelBlob const& blob)
+    {
+        delete iLiquid;
+        iLiquid = nullptr;
+
+        iBound = readBounds(header.bounds);
+        iMogpFlags = header.mogpFlags;
+        iGroupWMOID = header.groupWMOID;
+
+        Vector3 const* vertexData = blob.get<Vector3>(header.verticesOffset, header.vertexCount);
+        MeshTriangle const* triangleData = blob.get<MeshTriangle>(header.trianglesOffset, header.triangleCount);
+        uint32 const* nodeData = blob.get<uint32>(header.treeNodesOffset, header.treeNodeCount);
+        uint32 const* objectData = blob.get<uint32>(header.treeObjectsOffset, header.treeObjectCount);
+        if (!vertexData || !triangleData || !nodeData || !objectData || !header.treeNodeCount)
+            return false;
+
+        vertices.setView(vertexData, header.vertexCount);
+        triangles.setView(triangleData, header.triangleCount);
+        meshTree.setBlobData(readBounds(header.treeBounds), nodeData, header.treeNodeCount, objectData, header.treeObjectCount);
+
+        if (header.liquidHeightsOffset)
+        {
+            uint32 heightCount = (header.liquidTilesX + 1) * (header.liquidTilesY + 1);
+            if (!blob.get<float>(header.liquidHeightsOffset, heightCount) ||
+                !blob.get<uint8>(header.liquidFlagsOffset, header.liquidTilesX * header.liquidTilesY))
+                return false;
+            iLiquid = WmoLiquid::readFromBlob(header, blob.get<uint8>(0, 0));
+        }
+        return true;
+    }
+
     struct GModelRayCallback
     {
-        GModelRayCallback(const std::vector<MeshTriangle>& tris, const std::vector<Vector3>& vert):
-            vertices(vert.begin()), triangles(tris.begin()), hit(false) {}
+        GModelRayCallback(BlobArray<MeshTriangle> const& tris, BlobArray<Vector3> const& vert):
+            vertices(vert.data()), triangles(tris.data()), hit(false) {}
         bool operator()(const G3D::Ray& ray, uint32 entry, float& distance, bool /*pStopAtFirstHit*/, bool /*ignoreM2Model*/)
         {
             bool result = IntersectTriangle(triangles[entry], vertices, ray, distance);
@@ -381,8 +629,8 @@ namespace VMAP
                 hit = true;
             return hit;
         }
-        std::vector<Vector3>::const_iterator vertices;
-        std::vector<MeshTriangle>::const_iterator triangles;
+        Vector3 const* vertices;
+        MeshTriangle const* triangles;
         bool hit;
     };
 
@@ -568,6 +816,69 @@ namespace VMAP
         return result;
     }
 
+    bool WorldModel::writeBlobFile(std::string const& filename)
+    {
+        ModelBlobWriter writer;
+        uint32 headerOffset = writer.reserve(sizeof(ModelBlobHeader));
+        uint32 groupsOffset = writer.reserve(groupModels.size() * sizeof(GroupBlobHeader));
+
+        ModelBlobHeader header;
+        memset(&header, 0, sizeof(ModelBlobHeader));
+        memcpy(header.magic, VMAP_BLOB_MAGIC, 8);
+        header.rootWMOID = RootWMOID;
+        header.groupCount = groupModels.size();
+        header.groupsOffset = groupsOffset;
+
+        for (uint32 i = 0; i < groupModels.size(); ++i)
+        {
+            GroupBlobHeader groupHeader;
+            groupModels[i].writeToBlob(writer, groupHeader);
+            writer.write(groupsOffset + i * sizeof(GroupBlobHeader), &groupHeader, sizeof(GroupBlobHeader));
+        }
+
+        header.treeNodeCount = groupTree.getNodes().size();
+        header.treeNodesOffset = writer.append(groupTree.getNodes().data(), groupTree.getNodes().size() * sizeof(uint32));
+        header.treeObjectCount = groupTree.getObjects().size();
+        header.treeObjectsOffset = writer.append(groupTree.getObjects().data(), groupTree.getObjects().size() * sizeof(uint32));
+        writeBounds(groupTree.getBounds(), header.treeBounds);
+        writer.write(headerOffset, &header, sizeof(ModelBlobHeader));
+
+        FILE* wf = fopen(filename.c_str(), "wb");
+        if (!wf)
+            return false;
+
+        bool result = writer.writeToFile(wf);
+        fclose(wf);
+        return result;
+    }
+
+    bool WorldModel::readBlobFile(std::string const& filename)
+    {
+        std::shared_ptr<ModelBlob> modelBlob = std::make_shared<ModelBlob>();
+        if (!modelBlob->load(filename))
+            return false;
+
+        ModelBlobHeader const* header = modelBlob->get<ModelBlobHeader>(0, 1);
+        if (!header || memcmp(header->magic, VMAP_BLOB_MAGIC, 8))
+            return false;
+
+        GroupBlobHeader const* groupHeaders = modelBlob->get<GroupBlobHeader>(header->groupsOffset, header->groupCount);
+        uint32 const* nodeData = modelBlob->get<uint32>(header->treeNodesOffset, header->treeNodeCount);
+        uint32 const* objectData = modelBlob->get<uint32>(header->treeObjectsOffset, header->treeObjectCount);
+        if (!groupHeaders || !nodeData || !objectData || !header->treeNodeCount)
+            return false;
+
+        RootWMOID = header->rootWMOID;
+        groupModels.resize(header->groupCount);
+        for (uint32 i = 0; i < header->groupCount; ++i)
+            if (!groupModels[i].readFromBlob(groupHeaders[i], *modelBlob))
+                return false;
+
+        groupTree.setBlobData(readBounds(header->treeBounds), nodeData, header->treeNodeCount, objectData, header->treeObjectCount);
+        blob = modelBlob;
+        return true;
+    }
+
     bool WorldModel::readFile(std::string const& filename)
     {
         FILE* rf = fopen(filename.c_str(), "rb");
@@ -578,7 +889,15 @@ namespace VMAP
         uint32 chunkSize = 0;
         uint32 count = 0;
         char chunk[8];                          // Ignore the added magic header
-        if (!readChunk(rf, chunk, VMAP_MAGIC, 8)) result = false;
+        if (fread(chunk, 1, 8, rf) != 8)
+            result = false;
+        else if (!memcmp(chunk, VMAP_BLOB_MAGIC, 8))
+        {
+            fclose(rf);
+            return readBlobFile(filename);
+        }
+        else if (memcmp(chunk, VMAP_MAGIC, 8))
+            result = false;
 
         if (result && !readChunk(rf, chunk, "WMOD", 4)) result = false;
         if (result && fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
@@ -24,15 +24,21 @@
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
 #include "BIH.h"
+#include "BlobArray.h"
 
 #include "Platform/Define.h"
 
+#include <memory>
+
 namespace VMAP
 {
     class TreeNode;
     struct AreaInfo;
     struct GroupLocationInfo;
     struct LocationInfo;
+    struct GroupBlobHeader;
+    class ModelBlobWriter;
+    class ModelBlob;
 
     class MeshTriangle
     {
@@ -59,14 +65,17 @@ namespace VMAP
             uint32 GetFileSize() const;
             bool writeToFile(FILE* wf);
             static bool readFromFile(FILE* rf, WmoLiquid*& out);
+            void writeToBlob(ModelBlobWriter& writer, GroupBlobHeader& header) const;
+            static WmoLiquid* readFromBlob(GroupBlobHeader const& header, uint8 const* blob);
         private:
-            WmoLiquid() : iTilesX(0), iTilesY(0), iType(0), iHeight(nullptr), iFlags(nullptr) {};
+            WmoLiquid() : iTilesX(0), iTilesY(0), iType(0), iHeight(nullptr), iFlags(nullptr), iBlobData(false) {};
             uint32 iTilesX;  //!< number of tiles in x direction, each
             uint32 iTilesY;
             Vector3 iCorner; //!< the lower corner
             uint32 iType;    //!< liquid type
             float* iHeight;  //!< (tilesX + 1)*(tilesY + 1) height values
             uint8* iFlags;   //!< info if liquid tile is used
+            bool iBlobData;  //!< iHeight and iFlags point into a model blob and are not owned
 #ifdef MMAP_GENERATOR
         public:
             void getPosInfo(uint32& tilesX, uint32& tilesY, Vector3& corner) const;
@@ -83,7 +92,7 @@ namespace VMAP
                 iBound(bound), iMogpFlags(mogpFlags), iGroupWMOID(groupWMOID), iLiquid(nullptr) {}
             ~GroupModel() { delete iLiquid; }
 
-            //! pass mesh data to object and create BIH. Passed vectors get get swapped with old geometry!
+            //! pass mesh data to object and create BIH. Passed vectors are moved from!
             void setMeshData(std::vector<Vector3>& vert, std::vector<MeshTriangle>& tri);
             void setLiquidData(WmoLiquid*& liquid) { iLiquid = liquid; liquid = nullptr; }
             bool IntersectRay(const G3D::Ray& ray, float& distance, bool stopAtFirstHit, bool ignoreM2Model = false) const;
@@ -92,6 +101,8 @@ namespace VMAP
             uint32 GetLiquidType() const;
             bool writeToFile(FILE* wf);
             bool readFromFile(FILE* rf);
+            void writeToBlob(ModelBlobWriter& writer, GroupBlobHeader& header) const;
+            bool readFromBlob(GroupBlobHeader const& header, ModelBlob const& blob);
             const G3D::AABox& GetBound() const { return iBound; }
             uint32 GetMogpFlags() const { return iMogpFlags; }
             uint32 GetWmoID() const { return iGroupWMOID; }
@@ -99,8 +110,8 @@ namespace VMAP
             G3D::AABox iBound;
             uint32 iMogpFlags;// 0x8 outdor; 0x2000 indoor
             uint32 iGroupWMOID;
-            std::vector<Vector3> vertices;
-            std::vector<MeshTriangle> triangles;
+            BlobArray<Vector3> vertices;
+            BlobArray<MeshTriangle> triangles;
             BIH meshTree;
             WmoLiquid* iLiquid;
 
@@ -122,6 +133,10 @@ namespace VMAP
             bool IntersectPoint(const G3D::Vector3& p, const G3D::Vector3& down, float& dist, AreaInfo& info) const;
             bool GetLocationInfo(const G3D::Vector3& p, const G3D::Vector3& down, float& dist, GroupLocationInfo& info) const;
             bool writeFile(const std::string& filename);
+            //! single blob format, sections aligned to be used in place when mapped
+            bool writeBlobFile(const std::string& filename);
+            bool isBlob() const { return blob != nullptr; }
+            //! reads both formats, blob files are memory mapped where supported
             bool readFile(const std::string& filename);
             void setModelFlags(uint32 newFlags) { modelFlags = newFlags; }
             uint32 getModelFlags() const { return modelFlags; }
@@ -130,6 +145,9 @@ namespace VMAP
             std::vector<GroupModel> groupModels;
             BIH groupTree;
             uint32 modelFlags;
+            std::shared_ptr<ModelBlob> blob;    //!< backing storage of blob loaded models
+
+            bool readBlobFile(const std::string& filename);
 
 #ifdef MMAP_GENERATOR
         public:
@@ -70,9 +70,14 @@
 #include "World/WorldState.h"
 #include "Cinematics/CinematicMgr.h"
 #include "Maps/TransportMgr.h"
+#include "Maps/TerrainStreamer.h"
+#include "Entities/ObjectPool.h"
+#include "Maps/TerrainQueryTrace.h"
 #include "Anticheat/Anticheat.hpp"
 #include "LFG/LFGMgr.h"
 #include "Vmap/GameObjectModel.h"
+#include "Vmap/DynamicTree.h"
+#include "Vmap/BIHWrap.h"
 
 #ifdef BUILD_AHBOT
  #include "AuctionHouseBot/AuctionHouseBot.h"
@@ -157,6 +162,7 @@ void World::CleanupsBeforeStop()
     KickAll(true);                                   // save and kick all players
     UpdateSessions(1);                               // real players unload required UpdateSessions call
     sBattleGroundMgr.DeleteAllBattleGrounds();       // unload battleground templates before different singletons destroyed
+    TerrainQueryTrace::Stop();
     sMapMgr.UnloadAll();                             // unload all grids (including locked in memory)
 }
 
@@ -375,6 +381,9 @@ void World::LoadConfigSettings(bool reload)
             sLog.outError("World settings reload fail: can't read settings from %s.", sConfig.GetFilename().c_str());
             return;
         }
+
+        // quest level and low level hiding settings are part of quest giver status
+        sObjectMgr.InvalidateQuestGiverStatus();
     }
 
     ///- Read the version of the configuration file and warn the user in case of emptiness or mismatch
@@ -498,6 +507,9 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
+    setConfig(CONFIG_UINT32_GRID_UNLOAD_MAX_PER_UPDATE, "GridUnload.MaxPerUpdate", 4);
+    setConfig(CONFIG_BOOL_GRID_INDEXED_SEARCH, "GridIndexedSearch", true);
+    CellObjectIndex::SetSearchEnabled(getConfig(CONFIG_BOOL_GRID_INDEXED_SEARCH));
     setConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS, "MaxWhoListReturns", 49);
 
     std::string forceLoadGridOnMaps = sConfig.GetStringDefault("LoadAllGridsOnMaps");
@@ -813,6 +825,12 @@ void World::LoadConfigSettings(bool reload)
 
     m_relocation_ai_notify_delay = sConfig.GetIntDefault("Visibility.AIRelocationNotifyDelay", 1000u);
     m_relocation_lower_limit_sq = pow(sConfig.GetFloatDefault("Visibility.RelocationLowerLimit", 10), 2);
+    setConfig(CONFIG_BOOL_VISIBILITY_INCREMENTAL, "Visibility.Incremental", true);
+    setConfig(CONFIG_BOOL_VISIBILITY_INCREMENTAL_VERIFY, "Visibility.Incremental.Verify", false);
+    setConfig(CONFIG_BOOL_BATCH_RELOCATION_NOTIFIES, "Visibility.BatchRelocationNotifies", true);
+    setConfig(CONFIG_BOOL_UPDATE_LOD, "Visibility.UpdateLOD", true);
+    setConfigMinMax(CONFIG_UINT32_UPDATE_LOD_FAR_INTERVAL, "Visibility.UpdateLOD.FarInterval", 400, 0, 5000);
+    setConfigMinMax(CONFIG_UINT32_UPDATE_LOD_NO_PLAYER_INTERVAL, "Visibility.UpdateLOD.NoPlayerInterval", 1000, 0, 10000);
 
     // Visibility on Continents
     m_MaxVisibleDistanceOnContinents      = sConfig.GetFloatDefault("Visibility.Distance.Continents",     DEFAULT_VISIBILITY_DISTANCE);
@@ -895,6 +913,7 @@ void World::LoadConfigSettings(bool reload)
 
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableLineOfSightCalc(enableLOS);
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
+    DynamicMapTree::SetIncrementalRefit(sConfig.GetBoolDefault("vmap.dynamicTreeRefit", false));
     sLog.outString("WORLD: VMap support included. LineOfSight:%i, getHeight:%i, indoorCheck:%i",
                    enableLOS, enableHeight, getConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK) ? 1 : 0);
     sLog.outString("WORLD: VMap data directory is: %svmaps", m_dataPath.c_str());
@@ -906,6 +925,22 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_PATH_FIND_OPTIMIZE, "PathFinder.OptimizePath", true);
     setConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z, "PathFinder.NormalizeZ", false);
+    setConfig(CONFIG_UINT32_PATH_FIND_CACHE_SIZE, "PathFinder.CacheSize", 256);
+
+    setConfig(CONFIG_BOOL_TERRAIN_STREAMING, "TerrainStreaming.Enable", false);
+    setConfigMinMax(CONFIG_UINT32_TERRAIN_STREAMING_LOOKAHEAD, "TerrainStreaming.Lookahead", 10000, 1000, 60000);
+    setConfigMinMax(CONFIG_UINT32_TERRAIN_STREAMING_MAX_PENDING, "TerrainStreaming.MaxPending", 64, 1, 1024);
+
+    setConfig(CONFIG_UINT32_OBJECT_POOL_CREATURE_MAX_FREE, "ObjectPool.Creature.MaxFree", 4096);
+    setConfig(CONFIG_UINT32_OBJECT_POOL_GAMEOBJECT_MAX_FREE, "ObjectPool.GameObject.MaxFree", 2048);
+    setConfig(CONFIG_UINT32_OBJECT_POOL_DYNAMICOBJECT_MAX_FREE, "ObjectPool.DynamicObject.MaxFree", 512);
+    ObjectPool::SetMaxFree(OBJECT_POOL_CREATURE, getConfig(CONFIG_UINT32_OBJECT_POOL_CREATURE_MAX_FREE));
+    ObjectPool::SetMaxFree(OBJECT_POOL_GAMEOBJECT, getConfig(CONFIG_UINT32_OBJECT_POOL_GAMEOBJECT_MAX_FREE));
+    ObjectPool::SetMaxFree(OBJECT_POOL_DYNAMICOBJECT, getConfig(CONFIG_UINT32_OBJECT_POOL_DYNAMICOBJECT_MAX_FREE));
+
+    std::string queryTraceFile = sConfig.GetStringDefault("TerrainQueryTrace.File");
+    if (!queryTraceFile.empty() && !TerrainQueryTrace::IsRecording())
+        TerrainQueryTrace::Start(queryTraceFile, std::max(1, sConfig.GetIntDefault("TerrainQueryTrace.MaxQueries", 1000000)));
 
     setConfig(CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL, "Raf.BonusLevel", 60);
     setConfig(CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL_DIFFERENCE, "Raf.LevelDifference", 4);
@@ -971,6 +1006,9 @@ void World::SetInitialWorldSettings()
     // load SQL dbcs first, other DBCs need them
     sObjectMgr.LoadSQLDBCs();
 
+    sLog.outString("Building spell cast check data...");
+    sSpellMgr.LoadSpellHotEntries();                        // must be after LoadSQLDBCs
+
     // Load before npc_text, gossip_menu_option, script_texts
     sLog.outString("Loading broadcast_text...");
     sObjectMgr.LoadBroadcastText();
@@ -1457,6 +1495,7 @@ void World::SetInitialWorldSettings()
 
     // Update groups with offline leader after delay in seconds
     m_timers[WUPDATE_GROUPS].SetInterval(IN_MILLISECONDS);
+    m_timers[WUPDATE_OBJECT_POOLS].SetInterval(5 * MINUTE * IN_MILLISECONDS);
 
     // to set mailtimer to return mails every day between 4 and 5 am
     // mailtimer is increased when updating auctions
@@ -1476,6 +1515,7 @@ void World::SetInitialWorldSettings()
     ///- Initialize MapManager
     sLog.outString("Starting Map System");
     sMapMgr.Initialize();
+    sTerrainStreamer.Initialize();
     sLog.outString();
 
     ///- Initialize Battlegrounds
@@ -1717,6 +1757,13 @@ void World::Update(uint32 diff)
     // execute callbacks from sql queries that were queued recently
     UpdateResultQueue();
 
+    ///- Give memory of unused pooled objects back every 5 minutes
+    if (m_timers[WUPDATE_OBJECT_POOLS].Passed())
+    {
+        m_timers[WUPDATE_OBJECT_POOLS].Reset();
+        ObjectPool::TrimAll();
+    }
+
     ///- Erase corpses once every 20 minutes
     if (m_timers[WUPDATE_CORPSES].Passed())
     {
@@ -1761,6 +1808,7 @@ void World::Update(uint32 diff)
 
     // cleanup unused GridMap objects as well as VMaps
     sTerrainMgr.Update(diff);
+    sTerrainStreamer.Update();
 #ifdef BUILD_METRICS
     auto updateEndTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
     long long total = (updateEndTime - m_currentTime).count();
@@ -2869,6 +2917,48 @@ void World::GeneratePacketMetrics()
 
     metric::measurement meas_latency("world.metrics.latency");
     meas_latency.add_field("online", std::to_string(GetAverageLatency()));
+
+    MMAP::PathCacheStats const& pathCacheStats = MMAP::PathCache::GetStats();
+    metric::measurement meas_pathcache("world.metrics.pathcache");
+    meas_pathcache.add_field("hits", std::to_string(uint64(pathCacheStats.hits)));
+    meas_pathcache.add_field("misses", std::to_string(uint64(pathCacheStats.misses)));
+    meas_pathcache.add_field("point_hits", std::to_string(uint64(pathCacheStats.pointHits)));
+    meas_pathcache.add_field("invalidations", std::to_string(uint64(pathCacheStats.invalidations)));
+    meas_pathcache.add_field("time_saved_us", std::to_string(uint64(pathCacheStats.timeSaved)));
+
+    TerrainStreamerStats const& streamerStats = TerrainStreamer::GetStats();
+    metric::measurement meas_streaming("world.metrics.terrainstreaming");
+    meas_streaming.add_field("requested", std::to_string(uint64(streamerStats.requested)));
+    meas_streaming.add_field("prepared", std::to_string(uint64(streamerStats.prepared)));
+    meas_streaming.add_field("published", std::to_string(uint64(streamerStats.published)));
+    meas_streaming.add_field("expired", std::to_string(uint64(streamerStats.expired)));
+    meas_streaming.add_field("prefetched_loads", std::to_string(uint64(streamerStats.prefetchedLoads)));
+    meas_streaming.add_field("prefetched_load_time_us", std::to_string(uint64(streamerStats.prefetchedLoadTime)));
+    meas_streaming.add_field("late_loads", std::to_string(uint64(streamerStats.lateLoads)));
+    meas_streaming.add_field("late_load_time_us", std::to_string(uint64(streamerStats.lateLoadTime)));
+
+    GridStateStats const& gridStateStats = MapManager::GetGridStateStats();
+    metric::measurement meas_gridstate("world.metrics.gridstate");
+    meas_gridstate.add_field("loaded", std::to_string(uint64(gridStateStats.loaded)));
+    meas_gridstate.add_field("loaded_objects", std::to_string(uint64(gridStateStats.loadedObjects)));
+    meas_gridstate.add_field("load_time_us", std::to_string(uint64(gridStateStats.loadTime)));
+    meas_gridstate.add_field("max_load_time_us", std::to_string(uint64(gridStateStats.maxLoadTime)));
+    meas_gridstate.add_field("idled", std::to_string(uint64(gridStateStats.idled)));
+    meas_gridstate.add_field("unloaded", std::to_string(uint64(gridStateStats.unloaded)));
+    meas_gridstate.add_field("unloads_deferred", std::to_string(uint64(gridStateStats.unloadsDeferred)));
+    meas_gridstate.add_field("unloads_refused", std::to_string(uint64(gridStateStats.unloadsRefused)));
+    meas_gridstate.add_field("unload_time_us", std::to_string(uint64(gridStateStats.unloadTime)));
+    meas_gridstate.add_field("max_unload_time_us", std::to_string(uint64(gridStateStats.maxUnloadTime)));
+    meas_gridstate.add_field("tiles_released", std::to_string(uint64(gridStateStats.tilesReleased)));
+    meas_gridstate.add_field("teardowns", std::to_string(uint64(gridStateStats.teardowns)));
+    meas_gridstate.add_field("teardown_time_us", std::to_string(uint64(gridStateStats.teardownTime)));
+
+    BIHWrapStats const& dynTreeStats = GetBIHWrapStats();
+    metric::measurement meas_dyntree("world.metrics.dyntree");
+    meas_dyntree.add_field("refits", std::to_string(uint64(dynTreeStats.refits)));
+    meas_dyntree.add_field("refit_time_us", std::to_string(uint64(dynTreeStats.refitTime)));
+    meas_dyntree.add_field("rebuilds", std::to_string(uint64(dynTreeStats.rebuilds)));
+    meas_dyntree.add_field("rebuild_time_us", std::to_string(uint64(dynTreeStats.rebuildTime)));
 }
 
 uint32 World::GetAverageLatency() const
@@ -90,7 +90,8 @@ enum WorldTimers
     WUPDATE_GROUPS      = 6,
     WUPDATE_RAID_BROWSER= 7,
     WUPDATE_METRICS     = 8, // not used if BUILD_METRICS is not set
-    WUPDATE_COUNT       = 9
+    WUPDATE_OBJECT_POOLS= 9,
+    WUPDATE_COUNT       = 10
 };
 
 /// Configuration elements
@@ -225,6 +226,15 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL,
     CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL_DIFFERENCE,
     CONFIG_UINT32_SUNSREACH_COUNTER,
+    CONFIG_UINT32_PATH_FIND_CACHE_SIZE,
+    CONFIG_UINT32_TERRAIN_STREAMING_LOOKAHEAD,
+    CONFIG_UINT32_TERRAIN_STREAMING_MAX_PENDING,
+    CONFIG_UINT32_OBJECT_POOL_CREATURE_MAX_FREE,
+    CONFIG_UINT32_OBJECT_POOL_GAMEOBJECT_MAX_FREE,
+    CONFIG_UINT32_OBJECT_POOL_DYNAMICOBJECT_MAX_FREE,
+    CONFIG_UINT32_UPDATE_LOD_FAR_INTERVAL,
+    CONFIG_UINT32_UPDATE_LOD_NO_PLAYER_INTERVAL,
+    CONFIG_UINT32_GRID_UNLOAD_MAX_PER_UPDATE,
     CONFIG_UINT32_VALUE_COUNT
 };
 
@@ -339,6 +349,7 @@ enum eConfigFloatValues
 enum eConfigBoolValues
 {
     CONFIG_BOOL_GRID_UNLOAD = 0,
+    CONFIG_BOOL_GRID_INDEXED_SEARCH,
     CONFIG_BOOL_SAVE_RESPAWN_TIME_IMMEDIATELY,
     CONFIG_BOOL_OFFHAND_CHECK_AT_TALENTS_RESET,
     CONFIG_BOOL_ALLOW_TWO_SIDE_ACCOUNTS,
@@ -415,6 +426,11 @@ enum eConfigBoolValues
     CONFIG_BOOL_PATH_FIND_NORMALIZE_Z,
     CONFIG_BOOL_ALWAYS_SHOW_QUEST_GREETING,
     CONFIG_BOOL_DISABLE_INSTANCE_RELOCATE,
+    CONFIG_BOOL_TERRAIN_STREAMING,
+    CONFIG_BOOL_VISIBILITY_INCREMENTAL,
+    CONFIG_BOOL_VISIBILITY_INCREMENTAL_VERIFY,
+    CONFIG_BOOL_BATCH_RELOCATION_NOTIFIES,
+    CONFIG_BOOL_UPDATE_LOD,
     CONFIG_BOOL_VALUE_COUNT
 };
 